@@ -54,9 +54,17 @@ extern "C" {
 #define PORT_PROPERTY                      "port"
 #define LIVE_CAPTURE_PROPERTY              "live"
 #define FILE_CAPTURE_ITERATIONS_PROPERTY   "file_capture_iterations"
+#define FILE_CAPTURE_CACHE_PROPERTY        "file_capture_cache_mb"
+#define FILE_CAPTURE_SPEED_PROPERTY        "file_capture_speed"
+#define FILE_CAPTURE_PACKET_RATE_PROPERTY  "file_capture_packet_rate"
+#define FILE_CAPTURE_BIT_RATE_PROPERTY     "file_capture_bit_rate"
+#define FILE_CAPTURE_TAIL_PROPERTY         "file_capture_tail"
+#define FILE_CAPTURE_JOURNAL_PROPERTY      "file_capture_journal"
 #define UNTUNNEL_GTP_PROPERTY              "untunnel_gtp"
 #define OUTPUT_PATH_PROPERTY               "output_path"
 #define DISTRIBUTION_SERVER_ARRAY_PROPERTY "distribution_server_array"
+#define INDEX_RECORDS_PROPERTY             "index_records"
+#define INDEX_INTERVAL_PROPERTY            "index_interval_ms"
 
 /**
  *******************************************************************************
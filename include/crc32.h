@@ -0,0 +1,41 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: crc32.h
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+#ifndef CRC32_H_
+#define CRC32_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * This module calculates the CRC-32 checksum used by Ethernet and zlib, it checks the integrity of files written by
+ * these programs
+ */
+
+//
+// This function adds data to a CRC-32, a CRC over several buffers is calculated by passing the result of each call
+// to the next
+//
+// Parameters:
+//  uint32_t crc: The CRC of the data so far, 0 to start a new CRC
+//  const void* data: The data
+//  size_t length: The length of the data in octets
+//
+// Return:
+//  uint32_t: The CRC including the data
+//
+uint32_t crc32_update(uint32_t crc, const void* data, size_t length);
+
+#endif /* CRC32_H_ */
@@ -0,0 +1,223 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: gtp_classify.h
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This module classifies packets as GTP V1 signalling, GTP-U or other traffic in a single pass over the link layer,
+ * IPv4, UDP and GTP V1 headers, returning the offsets of the headers and of the tunnelled packet. IPv4 over Ethernet
+ * with at most one 802.1Q tag is recognised inline, other link layers and encapsulations (QinQ tags, MPLS label
+ * stacks, Linux cooked captures and GRE, ERSPAN or Ethernet pseudowire mirroring) are walked by a bounded loop that
+ * returns the offset of the IPv4 header carrying GTP and of the link layer header in front of it
+ */
+
+#ifndef GTP_CLASSIFY_H_
+#define GTP_CLASSIFY_H_
+
+#include <sys/types.h>
+#include <net/ethernet.h>
+#include <netinet/ip.h>
+#include <netinet/udp.h>
+#include <pcap/pcap.h>
+
+#include <gtpv1.h>
+
+// The largest number of tags, label stack entries and mirroring headers walked to find the IPv4 header
+#define GTP_CLASSIFY_MAX_LAYERS 8
+
+// The classes of packets
+#define GTP_CLASS_NONE          0  // Not a GTP V1 packet
+#define GTP_CLASS_C             1  // A GTP V1 message other than a G-PDU
+#define GTP_CLASS_U             2  // A G-PDU with only the mandatory header
+#define GTP_CLASS_U_OPTIONS     3  // A G-PDU with the sequence number or N-PDU number fields
+#define GTP_CLASS_U_EXTENSION   4  // A G-PDU with extension headers
+
+//
+// The class of a packet and the offsets of its headers
+//
+struct gtp_class {
+	u_char  type;            // The class of the packet
+	u_char  flag_options;    // The extension header, sequence number and N-PDU flags of the GTP header
+	u_char  mirrored;        // 1 if the packet was found inside GRE, ERSPAN or an Ethernet pseudowire, 0 otherwise
+	u_short linktype;        // The link layer type of the capture
+	u_short l2_offset;       // The offset of the link layer header in front of the IPv4 header, 0 unless mirrored
+	u_short type_offset;     // The offset of the protocol type announcing the IPv4 header, 0 after an MPLS label stack
+	u_short ip_offset;       // The offset of the outer IPv4 header
+	u_short gtp_offset;      // The offset of the GTP V1 header
+	u_short payload_offset;  // The offset of the tunnelled packet or the first information element, 0 if the GTP
+	                         // optional fields or extension headers are truncated or malformed
+};
+
+//
+// This function skips the chain of GTP V1 extension headers, the type of the first extension header is in the last
+// optional field. Each extension header starts with its length in units of four octets and ends with the type of the
+// next one, 0 ends the chain
+//
+// Parameters:
+//  u_int length: The amount of data present in the data buffer
+//  const u_char* data: A pointer to the packet data
+//  u_int offset: The offset of the first extension header
+//
+// Return:
+//  u_int: The offset of the data after the extension headers, 0 if the chain is truncated or malformed
+//
+static inline u_int gtp_classify_skip_extensions(u_int length, const u_char* data, u_int offset)
+{
+	u_char next_type = data[offset - 1];
+
+	while (next_type != 0) {
+		if (offset >= length || data[offset] == 0 || offset + data[offset] * 4 > length) {
+			return 0;
+		}
+
+		offset += data[offset] * 4;
+		next_type = data[offset - 1];
+	}
+
+	return offset;
+}
+
+//
+// This function walks the link layer header and any tags, label stacks and mirroring encapsulations in front of the
+// IPv4 header of a packet. The offsets of the link layer header and of the protocol type announcing the IPv4 header are
+// returned in the class of the packet
+//
+// Parameters:
+//  int linktype: The link layer type of the capture, DLT_EN10MB or DLT_LINUX_SLL
+//  u_int length: The amount of data present in the data buffer
+//  const u_char* data: A pointer to the packet data
+//  struct gtp_class* packet_class: The offsets of the link layer header are returned here
+//
+// Return:
+//  u_int: The offset of the IPv4 header, 0 if there is none
+//
+u_int gtp_classify_locate_ip(int linktype, u_int length, const u_char* data, struct gtp_class* packet_class);
+
+//
+// This function classifies a packet whose link layer headers and encapsulations are not recognised by
+// gtp_classify_packet() by walking them with gtp_classify_locate_ip()
+//
+// Parameters:
+//  int linktype: The link layer type of the capture, DLT_EN10MB or DLT_LINUX_SLL
+//  u_int length: The amount of data present in the data buffer
+//  const u_char* data: A pointer to the packet data
+//  struct gtp_class* packet_class: The class of the packet is returned here, the offsets are only set for GTP packets
+//
+// Return:
+//  int: The class of the packet
+//
+int gtp_classify_encapsulated_packet(int linktype, u_int length, const u_char* data, struct gtp_class* packet_class);
+
+//
+// This function classifies a packet from its outer IPv4 header on, the offsets of the link layer header must already
+// be set in the class of the packet. It is always inlined so that classifying a plain packet makes no calls
+//
+// Parameters:
+//  int linktype: The link layer type of the capture
+//  u_int ip: The offset of the outer IPv4 header, the whole IPv4 header must be present
+//  u_int length: The amount of data present in the data buffer
+//  const u_char* data: A pointer to the packet data
+//  struct gtp_class* packet_class: The class of the packet is returned here, the offsets are only set for GTP packets
+//
+// Return:
+//  int: The class of the packet
+//
+static inline __attribute__((always_inline)) int gtp_classify_ip(int linktype, u_int ip, u_int length, const u_char* data, struct gtp_class* packet_class)
+{
+	packet_class->type = GTP_CLASS_NONE;
+
+	// The IP header length gives the offsets of the UDP and GTP headers, both must be present
+	u_int udp = ip + (data[ip] & 0x0f) * 4;
+	u_int gtp = udp + sizeof(struct udphdr);
+	if (length < gtp + sizeof(struct gtpv1hdr)) {
+		return GTP_CLASS_NONE;
+	}
+
+	// Only GTP V1 in UDP in IPv4 on the GTP-C or GTP-U port is classified as GTP
+	if ((data[ip] >> 4) != IPVERSION || data[ip + 9] != IPPROTO_UDP || (data[gtp] >> 4) != GTP_V1_TYPEVER) {
+		return GTP_CLASS_NONE;
+	}
+
+	u_int sport = data[udp] << 8 | data[udp + 1];
+	u_int dport = data[udp + 2] << 8 | data[udp + 3];
+	if (sport != GTP_U_UDP_PORT && dport != GTP_U_UDP_PORT && sport != GTP_C_UDP_PORT && dport != GTP_C_UDP_PORT) {
+		return GTP_CLASS_NONE;
+	}
+
+	// The optional fields are present if any flag is set and are followed by any extension headers
+	u_int flag_options = data[gtp] & 0x07;
+	u_int payload = gtp + sizeof(struct gtpv1hdr);
+	if (flag_options) {
+		payload += sizeof(struct gtpv1hdropt);
+		if (payload > length) {
+			payload = 0;
+		}
+		else if (GTP_EXT_FLAG(flag_options)) {
+			payload = gtp_classify_skip_extensions(length, data, payload);
+		}
+	}
+
+	if (data[gtp + 1] != GTPV1_MT_G_PDU) {
+		packet_class->type = GTP_CLASS_C;
+	}
+	else if (GTP_EXT_FLAG(flag_options)) {
+		packet_class->type = GTP_CLASS_U_EXTENSION;
+	}
+	else {
+		packet_class->type = flag_options ? GTP_CLASS_U_OPTIONS : GTP_CLASS_U;
+	}
+
+	packet_class->flag_options = flag_options;
+	packet_class->linktype = linktype;
+	packet_class->ip_offset = ip;
+	packet_class->gtp_offset = gtp;
+	packet_class->payload_offset = payload;
+
+	return packet_class->type;
+}
+
+//
+// This function classifies a packet
+//
+// Parameters:
+//  int linktype: The link layer type of the capture, DLT_EN10MB or DLT_LINUX_SLL
+//  u_int length: The amount of data present in the data buffer
+//  const u_char* data: A pointer to the packet data
+//  struct gtp_class* packet_class: The class of the packet is returned here, the offsets are only set for GTP packets
+//
+// Return:
+//  int: The class of the packet
+//
+static inline int gtp_classify_packet(int linktype, u_int length, const u_char* data, struct gtp_class* packet_class)
+{
+	// IPv4 over Ethernet with at most one 802.1Q tag is recognised here, anything else, including GRE, is walked out
+	// of line so that this path stays free of calls
+	u_int ip = sizeof(struct ether_header);
+	if (linktype == DLT_EN10MB && length >= ip + TAG_ETHER_802_1_Q_LENGTH &&
+			data[12] == (ETHERTYPE_VLAN >> 8) && data[13] == (ETHERTYPE_VLAN & 0xff)) {
+		ip += TAG_ETHER_802_1_Q_LENGTH;
+	}
+
+	if (linktype != DLT_EN10MB || length < ip + sizeof(struct ip) ||
+			data[ip - 2] != (ETHERTYPE_IP >> 8) || data[ip - 1] != (ETHERTYPE_IP & 0xff) || data[ip + 9] == IPPROTO_GRE) {
+		return gtp_classify_encapsulated_packet(linktype, length, data, packet_class);
+	}
+
+	packet_class->mirrored = 0;
+	packet_class->l2_offset = 0;
+	packet_class->type_offset = ip - 2;
+
+	return gtp_classify_ip(linktype, ip, length, data, packet_class);
+}
+
+#endif /* GTP_CLASSIFY_H_ */
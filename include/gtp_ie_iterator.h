@@ -0,0 +1,380 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: gtp_ie_iterator.h
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This header file walks the information elements of GTP-C V1 and V2 messages. An iterator is set up on a message
+ * once, with the end of the information elements limited to the data captured, and each step checks that the whole
+ * information element is in the message before returning it, so callers never check lengths themselves. Iteration
+ * stops at the first information element that is truncated or whose length cannot be known.
+ *
+ * For decoders that only need a few information elements, the find functions walk the message once and return the
+ * offset and length of the first occurrence of each information element in a set
+ */
+
+#ifndef GTP_IE_ITERATOR_H_
+#define GTP_IE_ITERATOR_H_
+
+#include <string.h>
+#include <sys/types.h>
+#include <arpa/inet.h>
+
+#include <gtpv1.h>
+#include <gtpv2.h>
+
+// The most information elements a set can find
+#define GTP_IE_SET_SIZE 16
+
+//
+// An iterator over the information elements of a message
+//
+struct gtp_ie_iterator {
+	const u_char* message;               // The GTP header of the message
+	u_int offset;                        // The offset of the next information element from the GTP header
+	u_int end;                           // The offset of the end of the information elements
+};
+
+//
+// An information element returned by an iterator
+//
+struct gtp_ie {
+	u_char type;                         // The information element type
+	u_char instance;                     // The instance, always 0 for GTP V1
+	u_short length;                      // The length of the body
+	const u_char* header;                // The start of the information element
+	const u_char* body;                  // The body of the information element, after its type and length
+};
+
+//
+// A set of information elements to find in a message
+//
+struct gtp_ie_set {
+	u_char slot[256];                    // The index of each information element type in the found array plus one, 0 if not wanted
+	u_int count;                         // The number of information elements in the set
+};
+
+//
+// An information element found in a message
+//
+struct gtp_ie_found {
+	u_short offset;                      // The offset of the body from the GTP header, 0 if the information element was not found
+	u_short length;                      // The length of the body
+};
+
+//
+// This function reads a 16 bit field in network byte order that may not be aligned
+//
+// Parameters:
+//  const u_char* field: The field
+//
+// Return:
+//  u_int: The value
+//
+static inline u_int gtp_ie_read16(const u_char* field)
+{
+	return (field[0] << 8) | field[1];
+}
+
+//
+// This function reads a 32 bit field in network byte order that may not be aligned
+//
+// Parameters:
+//  const u_char* field: The field
+//
+// Return:
+//  u_int: The value
+//
+static inline u_int gtp_ie_read32(const u_char* field)
+{
+	return ((u_int)field[0] << 24) | (field[1] << 16) | (field[2] << 8) | field[3];
+}
+
+//
+// This function sets up an iterator on the information elements of a GTP V1 message, the optional header fields and
+// any extension headers are skipped
+//
+// Parameters:
+//  struct gtp_ie_iterator* iterator: The iterator
+//  const struct gtpv1hdr* gtpv1hdr: The GTP header of the message
+//  u_int available: The amount of data captured from the GTP header on
+//
+// Return:
+//  int: 1 if the iterator was set up, 0 if the header is truncated or malformed
+//
+static inline int gtpv1_ie_iterator_init(struct gtp_ie_iterator* iterator, const struct gtpv1hdr* gtpv1hdr, u_int available)
+{
+	iterator->message = (const u_char*)gtpv1hdr;
+	iterator->end = sizeof(struct gtpv1hdr) + ntohs(gtpv1hdr->length);
+	if (iterator->end > available) {
+		iterator->end = available;
+	}
+
+	iterator->offset = sizeof(struct gtpv1hdr);
+	if (!gtpv1hdr->flag_options) {
+		return iterator->offset <= iterator->end;
+	}
+
+	iterator->offset += sizeof(struct gtpv1hdropt);
+	if (iterator->offset > iterator->end) {
+		return 0;
+	}
+
+	// Extension headers are in units of four octets, the last octet of each is the type of the next one
+	u_char next_type = GTP_EXT_FLAG(gtpv1hdr->flag_options) ? ((const struct gtpv1hdropt*)(gtpv1hdr + 1))->next_exthdrtype : 0;
+	while (next_type != 0) {
+		if (iterator->offset >= iterator->end) {
+			return 0;
+		}
+
+		u_int length = iterator->message[iterator->offset] * 4;
+		if (length == 0 || iterator->offset + length > iterator->end) {
+			return 0;
+		}
+
+		next_type = iterator->message[iterator->offset + length - 1];
+		iterator->offset += length;
+	}
+
+	return 1;
+}
+
+//
+// This function gets the next information element of a GTP V1 message
+//
+// Parameters:
+//  struct gtp_ie_iterator* iterator: The iterator
+//  struct gtp_ie* ie: The information element is returned here
+//
+// Return:
+//  int: 1 if an information element was returned, 0 at the end of the message or on a truncated or unknown TV element
+//
+static inline int gtpv1_ie_next(struct gtp_ie_iterator* iterator, struct gtp_ie* ie)
+{
+	if (iterator->offset >= iterator->end) {
+		return 0;
+	}
+
+	const u_char* header = iterator->message + iterator->offset;
+	u_int type = header[0];
+	u_int header_length = gtpv1_information_elements[type].header_length;
+	u_int body_length = gtpv1_information_elements[type].body_length;
+
+	// Every TLV information element has a type and a two octet length, known or not
+	if (type >= GTPV1_FIRST_TLV_IE) {
+		header_length = GTPV1_TLV_HEADER_LENGTH;
+	}
+
+	// The length of unknown TV information elements is not known, so nothing after them can be read
+	if (header_length == 0 || iterator->offset + header_length > iterator->end) {
+		return 0;
+	}
+
+	if (type >= GTPV1_FIRST_TLV_IE) {
+		body_length = gtp_ie_read16(header + 1);
+	}
+
+	if (iterator->offset + header_length + body_length > iterator->end) {
+		return 0;
+	}
+
+	ie->type = type;
+	ie->instance = 0;
+	ie->length = body_length;
+	ie->header = header;
+	ie->body = header + header_length;
+
+	iterator->offset += header_length + body_length;
+	return 1;
+}
+
+//
+// This function sets up an iterator on the information elements of a GTP V2 message. Only the first message is
+// iterated over if others are piggybacked on it
+//
+// Parameters:
+//  struct gtp_ie_iterator* iterator: The iterator
+//  const struct gtpv2hdr* gtpv2hdr: The GTP header of the message
+//  u_int available: The amount of data captured from the GTP header on
+//
+// Return:
+//  int: 1 if the iterator was set up, 0 if the header is truncated
+//
+static inline int gtpv2_ie_iterator_init(struct gtp_ie_iterator* iterator, const struct gtpv2hdr* gtpv2hdr, u_int available)
+{
+	iterator->message = (const u_char*)gtpv2hdr;
+	iterator->offset = GTPV2_HEADER_LENGTH(gtpv2hdr);
+	iterator->end = GTPV2_MESSAGE_LENGTH(gtpv2hdr);
+	if (iterator->end > available) {
+		iterator->end = available;
+	}
+
+	return iterator->offset <= iterator->end;
+}
+
+//
+// This function sets up an iterator on the information elements inside a grouped GTP V2 information element
+//
+// Parameters:
+//  struct gtp_ie_iterator* iterator: The iterator
+//  const struct gtp_ie* grouped: The grouped information element, returned by another iterator
+//
+static inline void gtpv2_ie_iterator_init_grouped(struct gtp_ie_iterator* iterator, const struct gtp_ie* grouped)
+{
+	iterator->message = grouped->body;
+	iterator->offset = 0;
+	iterator->end = grouped->length;
+}
+
+//
+// This function gets the next information element of a GTP V2 message or grouped information element
+//
+// Parameters:
+//  struct gtp_ie_iterator* iterator: The iterator
+//  struct gtp_ie* ie: The information element is returned here
+//
+// Return:
+//  int: 1 if an information element was returned, 0 at the end of the message or on a truncated element
+//
+static inline int gtpv2_ie_next(struct gtp_ie_iterator* iterator, struct gtp_ie* ie)
+{
+	if (iterator->offset + sizeof(struct gtpv2_ie) > iterator->end) {
+		return 0;
+	}
+
+	const struct gtpv2_ie* header = (const struct gtpv2_ie*)(iterator->message + iterator->offset);
+	u_int body_length = GTPV2_IE_LENGTH(header->length);
+	if (iterator->offset + sizeof(struct gtpv2_ie) + body_length > iterator->end) {
+		return 0;
+	}
+
+	ie->type = header->ie_type;
+	ie->instance = header->instance;
+	ie->length = body_length;
+	ie->header = (const u_char*)header;
+	ie->body = GTPV2_IE_BODY(header);
+
+	iterator->offset += sizeof(struct gtpv2_ie) + body_length;
+	return 1;
+}
+
+//
+// This function sets up a set of information elements to find, the information elements found are returned in the
+// order of their types here
+//
+// Parameters:
+//  struct gtp_ie_set* set: The set
+//  const u_char* types: The information element types, a type of 0 leaves its place in the found array empty
+//  u_int count: The number of types, at most GTP_IE_SET_SIZE
+//
+static inline void gtp_ie_set_init(struct gtp_ie_set* set, const u_char* types, u_int count)
+{
+	memset(set->slot, 0, sizeof(set->slot));
+	set->count = count < GTP_IE_SET_SIZE ? count : GTP_IE_SET_SIZE;
+
+	for (u_int i = 0; i < set->count; i++) {
+		if (types[i] != 0) {
+			set->slot[types[i]] = i + 1;
+		}
+	}
+}
+
+//
+// This function records an information element returned by an iterator if it is in a set and was not found before
+//
+// Parameters:
+//  const struct gtp_ie_set* set: The set
+//  const struct gtp_ie_iterator* iterator: The iterator that returned the information element
+//  const struct gtp_ie* ie: The information element
+//  struct gtp_ie_found* found: The information elements found
+//
+// Return:
+//  int: 1 if the information element was recorded, 0 otherwise
+//
+static inline int gtp_ie_record(const struct gtp_ie_set* set, const struct gtp_ie_iterator* iterator, const struct gtp_ie* ie,
+		struct gtp_ie_found* found)
+{
+	u_int slot = set->slot[ie->type];
+	if (slot == 0 || found[slot - 1].offset != 0) {
+		return 0;
+	}
+
+	found[slot - 1].offset = ie->body - iterator->message;
+	found[slot - 1].length = ie->length;
+	return 1;
+}
+
+//
+// This function finds the first occurrence of each information element in a set in a GTP V1 message, in one pass
+//
+// Parameters:
+//  const struct gtpv1hdr* gtpv1hdr: The GTP header of the message
+//  u_int available: The amount of data captured from the GTP header on
+//  const struct gtp_ie_set* set: The information elements to find
+//  struct gtp_ie_found* found: The information elements found, in the order of the set, set->count entries long
+//
+// Return:
+//  u_int: The number of information elements found
+//
+static inline u_int gtpv1_ie_find(const struct gtpv1hdr* gtpv1hdr, u_int available, const struct gtp_ie_set* set, struct gtp_ie_found* found)
+{
+	memset(found, 0, set->count * sizeof(struct gtp_ie_found));
+
+	struct gtp_ie_iterator iterator;
+	if (!gtpv1_ie_iterator_init(&iterator, gtpv1hdr, available)) {
+		return 0;
+	}
+
+	u_int found_count = 0;
+	struct gtp_ie ie;
+	while (found_count < set->count && gtpv1_ie_next(&iterator, &ie)) {
+		found_count += gtp_ie_record(set, &iterator, &ie, found);
+	}
+
+	return found_count;
+}
+
+//
+// This function finds the first occurrence of each information element in a set in a GTP V2 message, in one pass.
+// Only information elements with instance 0 are found, other instances are about other nodes or bearers
+//
+// Parameters:
+//  const struct gtpv2hdr* gtpv2hdr: The GTP header of the message
+//  u_int available: The amount of data captured from the GTP header on
+//  const struct gtp_ie_set* set: The information elements to find
+//  struct gtp_ie_found* found: The information elements found, in the order of the set, set->count entries long
+//
+// Return:
+//  u_int: The number of information elements found
+//
+static inline u_int gtpv2_ie_find(const struct gtpv2hdr* gtpv2hdr, u_int available, const struct gtp_ie_set* set, struct gtp_ie_found* found)
+{
+	memset(found, 0, set->count * sizeof(struct gtp_ie_found));
+
+	struct gtp_ie_iterator iterator;
+	if (!gtpv2_ie_iterator_init(&iterator, gtpv2hdr, available)) {
+		return 0;
+	}
+
+	u_int found_count = 0;
+	struct gtp_ie ie;
+	while (found_count < set->count && gtpv2_ie_next(&iterator, &ie)) {
+		if (ie.instance == 0) {
+			found_count += gtp_ie_record(set, &iterator, &ie, found);
+		}
+	}
+
+	return found_count;
+}
+
+#endif /* GTP_IE_ITERATOR_H_ */
@@ -21,6 +21,7 @@
 #define GTPV1_H_
 
 #include <sys/types.h>
+#include <netinet/ip.h>
 
 #include <gtpv1_message_types.h>
 #include <gtpv1_information_elements.h>
@@ -81,20 +82,30 @@ struct gtpv1hdropt {
 };
 
 //
-// This function initializes static data for GTP V1 handling
+// This function returns a pointer to the outer IPv4 header of a packet in a data buffer, the header of a mirrored
+// packet is the one inside the mirroring encapsulation
 //
-void init_gtpv1();
+// Parameters:
+//  int linktype: The link layer type of the capture, DLT_EN10MB or DLT_LINUX_SLL
+//  const unsigned int length: The amount of data present in the data buffer
+//  const unsigned char* data: A pointer to the packet data
+//
+// Return:
+//  struct ip*: A pointer to the IPv4 header if an IPv4 packet is present, NULL otherwise
+//
+struct ip* gtpv1_get_ip_header(int linktype, const unsigned int length, const unsigned char* data);
 
 //
 // This function returns a pointer to a GTPv1 header in a packet in a data buffer
 //
 // Parameters:
+//  int linktype: The link layer type of the capture, DLT_EN10MB or DLT_LINUX_SLL
 //  const unsigned int length: The amount of data present in the data buffer
 //  const unsigned char* data: A pointer to the packet data
 //
 // Return:
 //  gtpv1hdr*: A pointer to a GTP V1 header if a GTP V1 packet is present, NULL otherwise
 //
-struct gtpv1hdr* gtpv1_get_header(const unsigned int length, const unsigned char* data);
+struct gtpv1hdr* gtpv1_get_header(int linktype, const unsigned int length, const unsigned char* data);
 
 #endif /* GTPV1_H_ */
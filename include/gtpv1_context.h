@@ -0,0 +1,325 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: gtpv1_context.h
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This header file handles correlation of GTP-C messages on a PDP context. Contexts are keyed on a TEID and the
+ * address of the peer that allocated it, they are held in an open addressing hash table and expire on a timing wheel.
+ *
+ * An established PDP context has two entries, one keyed on the control plane TEID of the SGSN and one keyed on the
+ * control plane TEID of the GGSN, because GTP-C messages are addressed with the TEID of the receiving side. Each
+ * entry holds the key of the other in its link fields
+ *
+ * The contexts of tables can be saved to a snapshot file so that correlation survives restarts. A snapshot is a
+ * header followed by an array of fixed size records, it is checked with CRCs and read by mapping it into memory
+ */
+
+#ifndef GTPV1_CONTEXT_H_
+#define GTPV1_CONTEXT_H_
+
+#include <stdint.h>
+#include <time.h>
+#include <sys/types.h>
+
+#include <gtpv1_imsi.h>
+
+// The number of one second slots on the expiry timing wheel, must be a power of two larger than any timeout
+#define GTPV1_CONTEXT_WHEEL_SIZE 1024
+
+// The initial number of contexts a table has room for, tables grow as contexts are added
+#define GTPV1_CONTEXT_INITIAL_SIZE 1024
+
+// Used to indicate the end of a list of contexts
+#define GTPV1_CONTEXT_NONE 0xffffffff
+
+// Used as the expiry time of contexts that do not expire
+#define GTPV1_CONTEXT_NEVER 0
+
+// Context states
+#define GTPV1_CONTEXT_CREATE_PENDING 0  // A Create PDP Context Request is waiting for its response
+#define GTPV1_CONTEXT_UPDATE_PENDING 1  // An Update PDP Context Request moving the SGSN side is waiting for its response
+#define GTPV1_CONTEXT_ACTIVE         2  // The PDP context is established
+
+//
+// A PDP context being correlated
+//
+struct gtpv1_context {
+	u_int teid;                          // The TEID, in host byte order
+	u_int peer;                          // The IPv4 address of the peer that allocated the TEID, in network byte order
+	time_t expiry;                       // The time at which the context expires, GTPV1_CONTEXT_NEVER if it does not expire
+	char imsi[GTPV1_IMSI_LENGTH*2];      // The IMSI of the context
+	u_int eua;                           // The IPv4 end user address of the context, in network byte order, 0 if not known
+	u_int link_teid;                     // The TEID of the entry for the other side of the context
+	u_int link_peer;                     // The peer of the entry for the other side of the context
+	u_char state;                        // The GTPV1_CONTEXT_ state of the context
+	u_char nsapi;                        // The NSAPI of the primary PDP context
+	u_char delete_pending;               // Set when a Delete PDP Context Request has been sent to this side
+	u_int shard;                         // The correlation shard that holds the context, when contexts are sharded
+	unsigned long sequence;              // The message that routed the context away from its home shard, 0 if it was not
+	u_int wheel_next;                    // The next context in the timing wheel slot
+	u_int wheel_prev;                    // The previous context in the timing wheel slot
+};
+
+// Snapshot file identification, the version changes when the layout of the header or records changes
+#define GTPV1_SNAPSHOT_MAGIC   "GTPCTXSN"
+#define GTPV1_SNAPSHOT_VERSION 1
+
+// The size of the buffer for snapshot error messages
+#define GTPV1_SNAPSHOT_ERRBUF_SIZE 256
+
+//
+// The header of a snapshot file, the records follow it. Fields have fixed sizes so the layout does not depend on the build
+//
+struct gtpv1_snapshot_header {
+	char magic[8];                       // GTPV1_SNAPSHOT_MAGIC, not terminated
+	uint32_t version;                    // GTPV1_SNAPSHOT_VERSION
+	uint32_t header_size;                // The size of this header, the records start at this offset
+	uint32_t record_size;                // The size of a record
+	uint32_t record_count;               // The number of records
+	int64_t time;                        // The time the snapshot was taken
+	uint32_t records_crc;                // The CRC-32 of the records
+	uint32_t header_crc;                 // The CRC-32 of the header up to this field
+};
+
+//
+// A context in a snapshot file
+//
+struct gtpv1_snapshot_record {
+	uint32_t teid;                       // The TEID, in host byte order
+	uint32_t peer;                       // The peer that allocated the TEID, in network byte order
+	uint32_t link_teid;                  // The TEID of the entry for the other side of the context
+	uint32_t link_peer;                  // The peer of the entry for the other side of the context
+	uint32_t eua;                        // The IPv4 end user address, in network byte order
+	uint32_t reserved;                   // Set to zero
+	int64_t expiry;                      // The time at which the context expires, GTPV1_CONTEXT_NEVER if it does not expire
+	char imsi[GTPV1_IMSI_LENGTH*2];      // The IMSI of the context
+	uint8_t state;                       // The GTPV1_CONTEXT_ state of the context
+	uint8_t nsapi;                       // The NSAPI of the primary PDP context
+	uint8_t delete_pending;              // Set when a Delete PDP Context Request has been sent to this side
+	uint8_t padding[5];                  // Set to zero
+};
+
+//
+// A slot in the hash table, the key is held in the slot so that probing does not touch the contexts
+//
+struct gtpv1_context_slot {
+	u_int teid;                          // The TEID of the context in the slot
+	u_int peer;                          // The peer of the context in the slot
+	u_int context;                       // The index of the context, GTPV1_CONTEXT_NONE if the slot is empty
+};
+
+struct gtpv1_context_table;
+
+//
+// A function called when a context is removed from a table, explicitly or on expiry
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//  struct gtpv1_context* context: The context being removed
+//  void* data: The data given when the handler was set
+//
+typedef void (*gtpv1_context_handler)(struct gtpv1_context_table* table, struct gtpv1_context* context, void* data);
+
+//
+// A table of PDP contexts
+//
+struct gtpv1_context_table {
+	struct gtpv1_context_slot* slots;    // The hash table, its size is a power of two
+	u_int slot_mask;                     // The size of the hash table less one
+	struct gtpv1_context* contexts;      // The contexts, indexed from the hash table
+	u_int context_size;                  // The number of contexts allocated
+	u_int free_list;                     // The list of free contexts, linked on wheel_next
+	u_int count;                         // The number of contexts in use
+	time_t timeout;                      // The number of seconds after which contexts expire
+	time_t wheel_time;                   // The time up to which the timing wheel has been expired
+	gtpv1_context_handler remove_handler; // Called when a context is removed, NULL if not set
+	void* remove_handler_data;           // The data passed to the remove handler
+	u_int wheel[GTPV1_CONTEXT_WHEEL_SIZE]; // The timing wheel, each slot is a list of the contexts expiring in a second
+};
+
+//
+// This function hashes a context key, it is also used to spread contexts over correlation shards
+//
+// Parameters:
+//  u_int teid: The TEID
+//  u_int peer: The peer address
+//
+// Return:
+//  u_int: The hash
+//
+static inline u_int gtpv1_context_hash(u_int teid, u_int peer)
+{
+	// Mix the key with the 32 bit finalizer of MurmurHash3, TEIDs are often allocated sequentially
+	u_int hash = teid ^ (peer * 0x9e3779b1);
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6b;
+	hash ^= hash >> 13;
+	hash *= 0xc2b2ae35;
+	hash ^= hash >> 16;
+	return hash;
+}
+
+//
+// This function opens a context table
+//
+// Parameters:
+//  time_t timeout: The number of seconds after which contexts expire, must be less than GTPV1_CONTEXT_WHEEL_SIZE
+//
+// Return:
+//  struct gtpv1_context_table*: The table, NULL if it could not be allocated
+//
+struct gtpv1_context_table* gtpv1_context_table_open(time_t timeout);
+
+//
+// This function closes a context table and frees its memory
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//
+void gtpv1_context_table_close(struct gtpv1_context_table* table);
+
+//
+// This function adds a context to a table, it expires after the table timeout. If the context is already in the table
+// it is returned as it is. Context pointers returned earlier are not valid after this call because the contexts may be moved
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//  u_int teid: The TEID, in host byte order
+//  u_int peer: The IPv4 address of the peer that allocated the TEID
+//  time_t now: The current time
+//
+// Return:
+//  struct gtpv1_context*: The context, NULL if memory could not be allocated
+//
+struct gtpv1_context* gtpv1_context_add(struct gtpv1_context_table* table, u_int teid, u_int peer, time_t now);
+
+//
+// This function finds a context in a table
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//  u_int teid: The TEID, in host byte order
+//  u_int peer: The IPv4 address of the peer that allocated the TEID
+//
+// Return:
+//  struct gtpv1_context*: The context, NULL if it is not in the table
+//
+struct gtpv1_context* gtpv1_context_find(struct gtpv1_context_table* table, u_int teid, u_int peer);
+
+//
+// This function removes a context from a table
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//  struct gtpv1_context* context: The context
+//
+void gtpv1_context_remove(struct gtpv1_context_table* table, struct gtpv1_context* context);
+
+//
+// This function sets the function that is called when a context is removed from a table
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//  gtpv1_context_handler handler: The handler, NULL to clear it
+//  void* data: The data passed to the handler
+//
+void gtpv1_context_set_remove_handler(struct gtpv1_context_table* table, gtpv1_context_handler handler, void* data);
+
+//
+// This function sets the expiry time of a context
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//  struct gtpv1_context* context: The context
+//  time_t expiry: The time at which the context expires, GTPV1_CONTEXT_NEVER if it should not expire
+//
+void gtpv1_context_set_expiry(struct gtpv1_context_table* table, struct gtpv1_context* context, time_t expiry);
+
+//
+// This function removes the contexts that have expired from a table
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//  time_t now: The current time
+//
+// Return:
+//  u_int: The number of contexts that expired
+//
+u_int gtpv1_context_expire(struct gtpv1_context_table* table, time_t now);
+
+//
+// This function adds a context saved in a snapshot to a table. If the context is already in the table it is overwritten
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//  struct gtpv1_snapshot_record* record: The saved context
+//
+// Return:
+//  struct gtpv1_context*: The context, NULL if memory could not be allocated
+//
+struct gtpv1_context* gtpv1_context_restore(struct gtpv1_context_table* table, struct gtpv1_snapshot_record* record);
+
+//
+// This function saves the contexts of a table to snapshot records
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//  struct gtpv1_snapshot_record* records: The records, there must be room for the number of contexts in the table
+//
+// Return:
+//  u_int: The number of records saved
+//
+u_int gtpv1_context_save(struct gtpv1_context_table* table, struct gtpv1_snapshot_record* records);
+
+//
+// This function writes a snapshot file from sets of records, the records of each correlation shard for instance. The
+// file is written under a temporary name and renamed so that readers never see a partial snapshot
+//
+// Parameters:
+//  const char* path: The path of the snapshot file
+//  struct gtpv1_snapshot_record** record_sets: The sets of records
+//  u_int* record_counts: The number of records in each set
+//  u_int set_count: The number of sets
+//  time_t time: The time the snapshot was taken
+//  char* errbuf: The reason for an error is returned here, it must be GTPV1_SNAPSHOT_ERRBUF_SIZE long
+//
+// Return:
+//  int: 1 if the snapshot was written, 0 on errors
+//
+int gtpv1_snapshot_write(const char* path, struct gtpv1_snapshot_record** record_sets, u_int* record_counts, u_int set_count,
+		time_t time, char* errbuf);
+
+//
+// This function maps a snapshot file read only and checks its header and CRCs
+//
+// Parameters:
+//  const char* path: The path of the snapshot file
+//  size_t* size: The size of the mapping is returned here
+//  char* errbuf: The reason for an error is returned here, it must be GTPV1_SNAPSHOT_ERRBUF_SIZE long
+//
+// Return:
+//  struct gtpv1_snapshot_header*: The header of the mapped snapshot, its records follow it. NULL on errors
+//
+struct gtpv1_snapshot_header* gtpv1_snapshot_map(const char* path, size_t* size, char* errbuf);
+
+//
+// This function unmaps a snapshot file
+//
+// Parameters:
+//  struct gtpv1_snapshot_header* header: The header of the mapped snapshot
+//  size_t size: The size of the mapping
+//
+void gtpv1_snapshot_unmap(struct gtpv1_snapshot_header* header, size_t size);
+
+#endif /* GTPV1_CONTEXT_H_ */
@@ -21,6 +21,8 @@
 
 #include <string.h>
 
+#include <tbcd.h>
+
 // The length of an IMSI
 #define GTPV1_IMSI_LENGTH 8
 
@@ -34,22 +36,11 @@ struct gtpv1_imsi {
 //
 // Parameters:
 //  const struct gtpv1_imsi* imsip: The IMSI to convert
-//  char* string: The string into which to write the IMSI
+//  char* string: The string into which to write the IMSI, at least GTPV1_IMSI_LENGTH * 2 characters long
 //
 static inline void imsi2str(struct gtpv1_imsi* imsip, char* string)
 {
-	// Intialise the string
-	strcpy(string, "");
-
-	// Store the IMSI into the string
-	for (int i = 0; i < GTPV1_IMSI_LENGTH; i++) {
-		sprintf(string, "%s%d", string, (imsip->imsi[i] & 0x0f));
-
-		// Check for fillers
-		if ((imsip->imsi[i] >> 4) < 10) {
-			sprintf(string, "%s%d", string, (imsip->imsi[i] >> 4));
-		}
-	}
+	tbcd2str(imsip->imsi, GTPV1_IMSI_LENGTH, string, GTPV1_IMSI_LENGTH * 2);
 }
 
 // This method converts an IMSI to an unsigned long long
@@ -58,28 +49,17 @@ static inline void imsi2str(struct gtpv1_imsi* imsip, char* string)
 //  const struct gtpv1_imsi* imsip: The IMSI to convert
 //
 // Return:
-//  unsigned long long: The IMSI as a long long value
+//  unsigned long long: The IMSI as a long long value, 0 if the IMSI has a digit that is not decimal
 //
 static inline unsigned long long imsi2longlong(struct gtpv1_imsi* imsip)
 {
-	// Initialize the output IMSI
 	unsigned long long imsilong = 0;
 
-	// Store the IMSI into the string
-	for (int i = 0; i < GTPV1_IMSI_LENGTH; i++) {
-		// Shift right the last processed part
-		imsilong *= 10;
-		imsilong += (imsip->imsi[i] & 0x0f);
-
-		// Check for fillers
-		if ((imsip->imsi[i] >> 4) < 10) {
-			imsilong *= 10;
-			imsilong += imsip->imsi[i] >> 4;
-		}
+	if (tbcd2longlong(imsip->imsi, GTPV1_IMSI_LENGTH, &imsilong) < 0) {
+		return 0;
 	}
 
 	return imsilong;
 }
 
-
 #endif /* GTPV1_IMSI_H_ */
@@ -21,29 +21,42 @@
 #define GTPV1_INFORMATION_ELEMENTS_H_
 
 #include <stdio.h>
+#include <sys/types.h>
 
 //
 // Constants
 #define MAX_GTPV1_INFORMATION_ELEMENTS 256
 
 #define GTPV1_FIRST_TLV_IE 128
+#define GTPV1_TLV_HEADER_LENGTH 3  /* The type and two octet length of a TLV information element */
 
-// A GTP V1 information element holder
+// The lengths and flags of a GTP V1 information element, kept small so that a lookup touches a single cache line
 struct gtpv1_information_element {
-	int id;
-	int grouped;
-	int header_length;
-	int body_length;
-	char name[BUFSIZ];
+	u_char header_length;  // The length of the type and length fields, 0 for unknown types
+	u_char grouped;        // Set if the body of the element holds other elements
+	u_short body_length;   // The length of the body of a TV element, 0 for TLV elements
 };
 
 // All GTP V1 information elements
-extern struct gtpv1_information_element gtpv1_information_elements[MAX_GTPV1_INFORMATION_ELEMENTS];
+extern const struct gtpv1_information_element gtpv1_information_elements[MAX_GTPV1_INFORMATION_ELEMENTS];
 
+// The names of all GTP V1 information elements
+extern const char* const gtpv1_information_element_names[MAX_GTPV1_INFORMATION_ELEMENTS];
+
+//
+// This function returns the name of a GTP V1 information element
 //
-// This function initializes static data for GTP V1 messages
+// Parameters:
+//  u_char type: The type of the information element
 //
-void init_gtpv1_information_elements();
+// Return:
+//  const char*: The name of the information element, empty if the type is unknown
+//
+static inline const char* gtpv1_information_element_name(u_char type)
+{
+	const char* name = gtpv1_information_element_names[type];
+	return name != NULL ? name : "";
+}
 
 // Declare all GTP V1 information elements
 #define GTPV1_IE_CAUSE 1
@@ -159,4 +172,10 @@ void init_gtpv1_information_elements();
 #define GTPV1_IE_CHARGING_GATEWAY_ADDRESS 251
 #define GTPV1_IE_PRIVATE_EXTENSION 255
 
+// Cause values, 128 to 191 are acceptance causes in responses
+#define GTPV1_CAUSE_REQUEST_ACCEPTED 128
+#define GTPV1_CAUSE_NON_EXISTENT     192
+#define GTPV1_CAUSE_SYSTEM_FAILURE   204
+#define GTPV1_CAUSE_ACCEPTED(cause)  ((cause) >= GTPV1_CAUSE_REQUEST_ACCEPTED && (cause) < GTPV1_CAUSE_NON_EXISTENT)
+
 #endif /* GTPV1_INFORMATION_ELEMENTS_H_ */
@@ -21,25 +21,30 @@
 #define GTPV1_MESSAGE_TYPES_H_
 
 #include <stdio.h>
+#include <sys/types.h>
 
 //
 // Constants
 //
 #define MAX_GTPV1_MESSAGE_TYPES 256
 
-// A GTP V1 message type holder
-struct gtpv1_message_type {
-	int id;
-	char name[BUFSIZ];
-};
-
-// All GTP V1 Messages
-extern struct gtpv1_message_type gtpv1_message_types[MAX_GTPV1_MESSAGE_TYPES];
+// The names of all GTP V1 message types
+extern const char* const gtpv1_message_type_names[MAX_GTPV1_MESSAGE_TYPES];
 
 //
-// This function initializes static data for GTP V1 messages
+// This function returns the name of a GTP V1 message type
+//
+// Parameters:
+//  u_char type: The message type
+//
+// Return:
+//  const char*: The name of the message type, empty if the type is unknown
 //
-void init_gtpv1_message_types();
+static inline const char* gtpv1_message_type_name(u_char type)
+{
+	const char* name = gtpv1_message_type_names[type];
+	return name != NULL ? name : "";
+}
 
 // Declare all GTP V1 message types
 #define GTPV1_MT_ECHO_REQUEST 1
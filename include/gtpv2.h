@@ -0,0 +1,82 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: gtpv2.h
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This module handles the GTP-C V2 protocol used on the S11 and S5/S8 interfaces of LTE cores
+ */
+
+#ifndef GTPV2_H_
+#define GTPV2_H_
+
+#include <sys/types.h>
+#include <netinet/ip.h>
+
+#include <gtpv2_message_types.h>
+#include <gtpv2_information_elements.h>
+
+//
+// GTP versions
+//
+#define GTP_V2_VERSION 2
+
+//
+// Mandatory part of the GTP V2 header, the TEID follows it if the TEID flag is set and then the sequence number
+//
+struct gtpv2hdr {
+	u_char	spare:3,          // Spare
+			flag_teid:1,      // Set if the TEID is present
+			flag_piggyback:1, // Set if another message is piggybacked after this one
+			version:3;        // The GTP version
+	u_char  message_type;     // The GTP message type
+	u_short length;           // Length of the message excluding these first four octets
+};
+
+// The length of the mandatory part of the header and of the TEID and sequence number fields that follow it
+#define GTPV2_MANDATORY_HEADER_LENGTH 4
+#define GTPV2_TEID_LENGTH             4
+#define GTPV2_SEQUENCE_LENGTH         4
+
+// Get the length of the header of a message, the first information element is at this offset
+#define GTPV2_HEADER_LENGTH(hdr) \
+	(GTPV2_MANDATORY_HEADER_LENGTH + ((hdr)->flag_teid ? GTPV2_TEID_LENGTH : 0) + GTPV2_SEQUENCE_LENGTH)
+
+// Get the length of a message including its header
+#define GTPV2_MESSAGE_LENGTH(hdr) (GTPV2_MANDATORY_HEADER_LENGTH + ntohs((hdr)->length))
+
+//
+// This function returns a pointer to a GTPv2-C header in a packet in a data buffer
+//
+// Parameters:
+//  int linktype: The link layer type of the capture, DLT_EN10MB or DLT_LINUX_SLL
+//  const unsigned int length: The amount of data present in the data buffer
+//  const unsigned char* data: A pointer to the packet data
+//
+// Return:
+//  gtpv2hdr*: A pointer to a GTP V2 header if a GTP V2 control packet is present, NULL otherwise
+//
+struct gtpv2hdr* gtpv2_get_header(int linktype, const unsigned int length, const unsigned char* data);
+
+//
+// This function returns the TEID of a GTPv2-C message
+//
+// Parameters:
+//  const struct gtpv2hdr* gtpv2hdr: The header of the message
+//
+// Return:
+//  u_int: The TEID in host byte order, 0 if the message has no TEID
+//
+u_int gtpv2_get_teid(const struct gtpv2hdr* gtpv2hdr);
+
+#endif /* GTPV2_H_ */
@@ -0,0 +1,211 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: gtpv2_information_elements.h
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This module manages GTP V2 information elements. Every GTP V2 information element has the same four octet header
+ * of type, length and instance, the length counts the octets after the header. Grouped information elements hold
+ * further information elements in their body
+ */
+
+#ifndef GTPV2_INFORMATION_ELEMENTS_H_
+#define GTPV2_INFORMATION_ELEMENTS_H_
+
+#include <stdio.h>
+#include <sys/types.h>
+
+//
+// Constants
+#define MAX_GTPV2_INFORMATION_ELEMENTS 256
+
+// The flags of a GTP V2 information element, the lengths are always carried in the element itself
+struct gtpv2_information_element {
+	u_char grouped;        // Set if the body of the element holds other elements
+};
+
+// All GTP V2 information elements
+extern const struct gtpv2_information_element gtpv2_information_elements[MAX_GTPV2_INFORMATION_ELEMENTS];
+
+// The names of all GTP V2 information elements
+extern const char* const gtpv2_information_element_names[MAX_GTPV2_INFORMATION_ELEMENTS];
+
+//
+// This function returns the name of a GTP V2 information element
+//
+// Parameters:
+//  u_char type: The type of the information element
+//
+// Return:
+//  const char*: The name of the information element, empty if the type is unknown
+//
+static inline const char* gtpv2_information_element_name(u_char type)
+{
+	const char* name = gtpv2_information_element_names[type];
+	return name != NULL ? name : "";
+}
+
+// The header of a GTP V2 information element
+struct gtpv2_ie {
+	u_char  ie_type;         // The information element type
+	u_char  length[2];       // The length of the body, excluding this header
+	u_char  instance:4,      // The instance, distinguishes information elements of the same type in a message
+			spare:4;         // Spare
+};
+
+// Get the body length of an information element
+#define GTPV2_IE_LENGTH(length)	(((length)[0] << 8) + (length)[1])
+
+// Get the body of an information element
+#define GTPV2_IE_BODY(iep)	(((u_char*)(iep)) + sizeof(struct gtpv2_ie))
+
+// Declare all GTP V2 information elements
+#define GTPV2_IE_IMSI 1
+#define GTPV2_IE_CAUSE 2
+#define GTPV2_IE_RECOVERY 3
+#define GTPV2_IE_APN 71
+#define GTPV2_IE_AMBR 72
+#define GTPV2_IE_EBI 73
+#define GTPV2_IE_IP_ADDRESS 74
+#define GTPV2_IE_MEI 75
+#define GTPV2_IE_MSISDN 76
+#define GTPV2_IE_INDICATION 77
+#define GTPV2_IE_PCO 78
+#define GTPV2_IE_PAA 79
+#define GTPV2_IE_BEARER_QOS 80
+#define GTPV2_IE_FLOW_QOS 81
+#define GTPV2_IE_RAT_TYPE 82
+#define GTPV2_IE_SERVING_NETWORK 83
+#define GTPV2_IE_BEARER_TFT 84
+#define GTPV2_IE_TAD 85
+#define GTPV2_IE_ULI 86
+#define GTPV2_IE_F_TEID 87
+#define GTPV2_IE_TMSI 88
+#define GTPV2_IE_GLOBAL_CN_ID 89
+#define GTPV2_IE_S103PDF 90
+#define GTPV2_IE_S1UDF 91
+#define GTPV2_IE_DELAY_VALUE 92
+#define GTPV2_IE_BEARER_CONTEXT 93
+#define GTPV2_IE_CHARGING_ID 94
+#define GTPV2_IE_CHARGING_CHARACTERISTICS 95
+#define GTPV2_IE_TRACE_INFORMATION 96
+#define GTPV2_IE_BEARER_FLAGS 97
+#define GTPV2_IE_PDN_TYPE 99
+#define GTPV2_IE_PTI 100
+#define GTPV2_IE_MM_CONTEXT_GSM_KEY_TRIPLETS 103
+#define GTPV2_IE_MM_CONTEXT_UMTS_KEY_CIPHER_QUINTUPLETS 104
+#define GTPV2_IE_MM_CONTEXT_GSM_KEY_CIPHER_QUINTUPLETS 105
+#define GTPV2_IE_MM_CONTEXT_UMTS_KEY_QUINTUPLETS 106
+#define GTPV2_IE_MM_CONTEXT_EPS_SECURITY_CONTEXT 107
+#define GTPV2_IE_MM_CONTEXT_UMTS_KEY_QUADRUPLETS_QUINTUPLETS 108
+#define GTPV2_IE_PDN_CONNECTION 109
+#define GTPV2_IE_PDU_NUMBERS 110
+#define GTPV2_IE_P_TMSI 111
+#define GTPV2_IE_P_TMSI_SIGNATURE 112
+#define GTPV2_IE_HOP_COUNTER 113
+#define GTPV2_IE_UE_TIME_ZONE 114
+#define GTPV2_IE_TRACE_REFERENCE 115
+#define GTPV2_IE_COMPLETE_REQUEST_MESSAGE 116
+#define GTPV2_IE_GUTI 117
+#define GTPV2_IE_F_CONTAINER 118
+#define GTPV2_IE_F_CAUSE 119
+#define GTPV2_IE_PLMN_ID 120
+#define GTPV2_IE_TARGET_IDENTIFICATION 121
+#define GTPV2_IE_PACKET_FLOW_ID 123
+#define GTPV2_IE_RAB_CONTEXT 124
+#define GTPV2_IE_SOURCE_RNC_PDCP_CONTEXT_INFO 125
+#define GTPV2_IE_UDP_SOURCE_PORT_NUMBER 126
+#define GTPV2_IE_APN_RESTRICTION 127
+#define GTPV2_IE_SELECTION_MODE 128
+#define GTPV2_IE_SOURCE_IDENTIFICATION 129
+#define GTPV2_IE_CHANGE_REPORTING_ACTION 131
+#define GTPV2_IE_FQ_CSID 132
+#define GTPV2_IE_CHANNEL_NEEDED 133
+#define GTPV2_IE_EMLPP_PRIORITY 134
+#define GTPV2_IE_NODE_TYPE 135
+#define GTPV2_IE_FQDN 136
+#define GTPV2_IE_TI 137
+#define GTPV2_IE_MBMS_SESSION_DURATION 138
+#define GTPV2_IE_MBMS_SERVICE_AREA 139
+#define GTPV2_IE_MBMS_SESSION_IDENTIFIER 140
+#define GTPV2_IE_MBMS_FLOW_IDENTIFIER 141
+#define GTPV2_IE_MBMS_IP_MULTICAST_DISTRIBUTION 142
+#define GTPV2_IE_MBMS_DISTRIBUTION_ACKNOWLEDGE 143
+#define GTPV2_IE_RFSP_INDEX 144
+#define GTPV2_IE_UCI 145
+#define GTPV2_IE_CSG_INFORMATION_REPORTING_ACTION 146
+#define GTPV2_IE_CSG_ID 147
+#define GTPV2_IE_CMI 148
+#define GTPV2_IE_SERVICE_INDICATOR 149
+#define GTPV2_IE_DETACH_TYPE 150
+#define GTPV2_IE_LDN 151
+#define GTPV2_IE_NODE_FEATURES 152
+#define GTPV2_IE_MBMS_TIME_TO_DATA_TRANSFER 153
+#define GTPV2_IE_THROTTLING 154
+#define GTPV2_IE_ARP 155
+#define GTPV2_IE_EPC_TIMER 156
+#define GTPV2_IE_SIGNALLING_PRIORITY_INDICATION 157
+#define GTPV2_IE_TMGI 158
+#define GTPV2_IE_ADDITIONAL_MM_CONTEXT_FOR_SRVCC 159
+#define GTPV2_IE_ADDITIONAL_FLAGS_FOR_SRVCC 160
+#define GTPV2_IE_MDT_CONFIGURATION 162
+#define GTPV2_IE_APCO 163
+#define GTPV2_IE_ABSOLUTE_TIME_OF_MBMS_DATA_TRANSFER 164
+#define GTPV2_IE_HENB_INFORMATION_REPORTING 165
+#define GTPV2_IE_IPV4_CONFIGURATION_PARAMETERS 166
+#define GTPV2_IE_CHANGE_TO_REPORT_FLAGS 167
+#define GTPV2_IE_ACTION_INDICATION 168
+#define GTPV2_IE_TWAN_IDENTIFIER 169
+#define GTPV2_IE_ULI_TIMESTAMP 170
+#define GTPV2_IE_MBMS_FLAGS 171
+#define GTPV2_IE_RAN_NAS_CAUSE 172
+#define GTPV2_IE_CN_OPERATOR_SELECTION_ENTITY 173
+#define GTPV2_IE_TWMI 174
+#define GTPV2_IE_NODE_NUMBER 175
+#define GTPV2_IE_NODE_IDENTIFIER 176
+#define GTPV2_IE_PRESENCE_REPORTING_AREA_ACTION 177
+#define GTPV2_IE_PRESENCE_REPORTING_AREA_INFORMATION 178
+#define GTPV2_IE_TWAN_IDENTIFIER_TIMESTAMP 179
+#define GTPV2_IE_OVERLOAD_CONTROL_INFORMATION 180
+#define GTPV2_IE_LOAD_CONTROL_INFORMATION 181
+#define GTPV2_IE_METRIC 182
+#define GTPV2_IE_SEQUENCE_NUMBER 183
+#define GTPV2_IE_APN_AND_RELATIVE_CAPACITY 184
+#define GTPV2_IE_WLAN_OFFLOADABILITY_INDICATION 185
+#define GTPV2_IE_PRIVATE_EXTENSION 255
+
+// Cause values, 16 to 63 are acceptance causes in responses
+#define GTPV2_CAUSE_REQUEST_ACCEPTED 16
+#define GTPV2_CAUSE_CONTEXT_NOT_FOUND 64
+#define GTPV2_CAUSE_ACCEPTED(cause)  ((cause) >= GTPV2_CAUSE_REQUEST_ACCEPTED && (cause) < GTPV2_CAUSE_CONTEXT_NOT_FOUND)
+
+// F-TEID flags and interface types, the interface type is in the low 6 bits of the first octet of the body
+#define GTPV2_F_TEID_V4_FLAG 0x80
+#define GTPV2_F_TEID_V6_FLAG 0x40
+#define GTPV2_F_TEID_INTERFACE_TYPE(flags) ((flags) & 0x3f)
+#define GTPV2_F_TEID_LENGTH  5      // The length of the flags and TEID, the addresses follow
+
+#define GTPV2_F_TEID_S5_S8_SGW_GTP_C 6
+#define GTPV2_F_TEID_S5_S8_PGW_GTP_C 7
+#define GTPV2_F_TEID_S11_MME_GTP_C   10
+#define GTPV2_F_TEID_S11_S4_SGW_GTP_C 11
+
+// PAA PDN types, the PDN type is in the low 3 bits of the first octet of the body
+#define GTPV2_PAA_PDN_TYPE(octet)  ((octet) & 0x07)
+#define GTPV2_PAA_PDN_TYPE_IPV4    1
+#define GTPV2_PAA_PDN_TYPE_IPV6    2
+#define GTPV2_PAA_PDN_TYPE_IPV4V6  3
+#define GTPV2_PAA_IPV4_LENGTH      4
+#define GTPV2_PAA_IPV6_LENGTH      17   // The prefix length and the address
+
+#endif /* GTPV2_INFORMATION_ELEMENTS_H_ */
@@ -0,0 +1,122 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: gtpv2_message_types.h
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This module manages GTP V2 message types
+ */
+
+#ifndef GTPV2_MESSAGE_TYPES_H_
+#define GTPV2_MESSAGE_TYPES_H_
+
+#include <stdio.h>
+#include <sys/types.h>
+
+//
+// Constants
+//
+#define MAX_GTPV2_MESSAGE_TYPES 256
+
+// The names of all GTP V2 message types
+extern const char* const gtpv2_message_type_names[MAX_GTPV2_MESSAGE_TYPES];
+
+//
+// This function returns the name of a GTP V2 message type
+//
+// Parameters:
+//  u_char type: The message type
+//
+// Return:
+//  const char*: The name of the message type, empty if the type is unknown
+//
+static inline const char* gtpv2_message_type_name(u_char type)
+{
+	const char* name = gtpv2_message_type_names[type];
+	return name != NULL ? name : "";
+}
+
+// Declare all GTP V2-C message types
+#define GTPV2_MT_ECHO_REQUEST 1
+#define GTPV2_MT_ECHO_RESPONSE 2
+#define GTPV2_MT_VERSION_NOT_SUPPORTED 3
+#define GTPV2_MT_CREATE_SESSION_REQUEST 32
+#define GTPV2_MT_CREATE_SESSION_RESPONSE 33
+#define GTPV2_MT_MODIFY_BEARER_REQUEST 34
+#define GTPV2_MT_MODIFY_BEARER_RESPONSE 35
+#define GTPV2_MT_DELETE_SESSION_REQUEST 36
+#define GTPV2_MT_DELETE_SESSION_RESPONSE 37
+#define GTPV2_MT_CHANGE_NOTIFICATION_REQUEST 38
+#define GTPV2_MT_CHANGE_NOTIFICATION_RESPONSE 39
+#define GTPV2_MT_MODIFY_BEARER_COMMAND 64
+#define GTPV2_MT_MODIFY_BEARER_FAILURE_INDICATION 65
+#define GTPV2_MT_DELETE_BEARER_COMMAND 66
+#define GTPV2_MT_DELETE_BEARER_FAILURE_INDICATION 67
+#define GTPV2_MT_BEARER_RESOURCE_COMMAND 68
+#define GTPV2_MT_BEARER_RESOURCE_FAILURE_INDICATION 69
+#define GTPV2_MT_DOWNLINK_DATA_NOTIFICATION_FAILURE_INDICATION 70
+#define GTPV2_MT_TRACE_SESSION_ACTIVATION 71
+#define GTPV2_MT_TRACE_SESSION_DEACTIVATION 72
+#define GTPV2_MT_STOP_PAGING_INDICATION 73
+#define GTPV2_MT_CREATE_BEARER_REQUEST 95
+#define GTPV2_MT_CREATE_BEARER_RESPONSE 96
+#define GTPV2_MT_UPDATE_BEARER_REQUEST 97
+#define GTPV2_MT_UPDATE_BEARER_RESPONSE 98
+#define GTPV2_MT_DELETE_BEARER_REQUEST 99
+#define GTPV2_MT_DELETE_BEARER_RESPONSE 100
+#define GTPV2_MT_DELETE_PDN_CONNECTION_SET_REQUEST 101
+#define GTPV2_MT_DELETE_PDN_CONNECTION_SET_RESPONSE 102
+#define GTPV2_MT_IDENTIFICATION_REQUEST 128
+#define GTPV2_MT_IDENTIFICATION_RESPONSE 129
+#define GTPV2_MT_CONTEXT_REQUEST 130
+#define GTPV2_MT_CONTEXT_RESPONSE 131
+#define GTPV2_MT_CONTEXT_ACKNOWLEDGE 132
+#define GTPV2_MT_FORWARD_RELOCATION_REQUEST 133
+#define GTPV2_MT_FORWARD_RELOCATION_RESPONSE 134
+#define GTPV2_MT_FORWARD_RELOCATION_COMPLETE_NOTIFICATION 135
+#define GTPV2_MT_FORWARD_RELOCATION_COMPLETE_ACKNOWLEDGE 136
+#define GTPV2_MT_FORWARD_ACCESS_CONTEXT_NOTIFICATION 137
+#define GTPV2_MT_FORWARD_ACCESS_CONTEXT_ACKNOWLEDGE 138
+#define GTPV2_MT_RELOCATION_CANCEL_REQUEST 139
+#define GTPV2_MT_RELOCATION_CANCEL_RESPONSE 140
+#define GTPV2_MT_CONFIGURATION_TRANSFER_TUNNEL 141
+#define GTPV2_MT_DETACH_NOTIFICATION 149
+#define GTPV2_MT_DETACH_ACKNOWLEDGE 150
+#define GTPV2_MT_CS_PAGING_INDICATION 151
+#define GTPV2_MT_RAN_INFORMATION_RELAY 152
+#define GTPV2_MT_ALERT_MME_NOTIFICATION 153
+#define GTPV2_MT_ALERT_MME_ACKNOWLEDGE 154
+#define GTPV2_MT_UE_ACTIVITY_NOTIFICATION 155
+#define GTPV2_MT_UE_ACTIVITY_ACKNOWLEDGE 156
+#define GTPV2_MT_CREATE_FORWARDING_TUNNEL_REQUEST 160
+#define GTPV2_MT_CREATE_FORWARDING_TUNNEL_RESPONSE 161
+#define GTPV2_MT_SUSPEND_NOTIFICATION 162
+#define GTPV2_MT_SUSPEND_ACKNOWLEDGE 163
+#define GTPV2_MT_RESUME_NOTIFICATION 164
+#define GTPV2_MT_RESUME_ACKNOWLEDGE 165
+#define GTPV2_MT_CREATE_INDIRECT_DATA_FORWARDING_TUNNEL_REQUEST 166
+#define GTPV2_MT_CREATE_INDIRECT_DATA_FORWARDING_TUNNEL_RESPONSE 167
+#define GTPV2_MT_DELETE_INDIRECT_DATA_FORWARDING_TUNNEL_REQUEST 168
+#define GTPV2_MT_DELETE_INDIRECT_DATA_FORWARDING_TUNNEL_RESPONSE 169
+#define GTPV2_MT_RELEASE_ACCESS_BEARERS_REQUEST 170
+#define GTPV2_MT_RELEASE_ACCESS_BEARERS_RESPONSE 171
+#define GTPV2_MT_DOWNLINK_DATA_NOTIFICATION 176
+#define GTPV2_MT_DOWNLINK_DATA_NOTIFICATION_ACKNOWLEDGE 177
+#define GTPV2_MT_PGW_RESTART_NOTIFICATION 179
+#define GTPV2_MT_PGW_RESTART_NOTIFICATION_ACKNOWLEDGE 180
+#define GTPV2_MT_UPDATE_PDN_CONNECTION_SET_REQUEST 200
+#define GTPV2_MT_UPDATE_PDN_CONNECTION_SET_RESPONSE 201
+#define GTPV2_MT_MODIFY_ACCESS_BEARERS_REQUEST 211
+#define GTPV2_MT_MODIFY_ACCESS_BEARERS_RESPONSE 212
+
+#endif /* GTPV2_MESSAGE_TYPES_H_ */
@@ -22,6 +22,8 @@
  * @lld_overview
  * 
  * This API respresents wraps the syslogd API and provides utilities for logging.
+ * Messages are passed to syslogd by a background thread so that logging never
+ * blocks the capture and merge threads.
  *
  * @lld_end
  ******************************************************************************/
@@ -42,6 +44,16 @@
 #define MAX_MESSAGE_HEADER_SIZE 256
 #define MAX_MESSAGE_BODY_SIZE 65536
 
+#define LOGGER_RECORD_SIZE      512    /* The size of a log record, longer messages are split over several records */
+#define LOGGER_MESSAGE_SIZE     16384  /* The size of the longest message, longer messages are truncated */
+#define LOGGER_RING_SIZE        1024   /* The number of records in the log ring, must be a power of two */
+#define LOGGER_DRAIN_INTERVAL   10000  /* Microseconds the drain thread sleeps when the ring is empty */
+#define LOGGER_DRAIN_WAIT       1000   /* Milliseconds closing the logger waits for the drain thread to finish a pass */
+#define LOGGER_RATE_LIMIT       10     /* The number of messages with the same text logged per second */
+#define LOGGER_RATE_ENTRIES     256    /* The number of texts tracked for rate limiting, must be a power of two */
+#define LOGGER_RATE_PROBES      8      /* The number of entries a text may be tracked in */
+#define LOGGER_RATE_SAMPLE_SIZE 96     /* The length of text kept to report suppressed messages */
+
 #ifdef __cplusplus
 extern "C" {
 #endif 
@@ -50,58 +62,50 @@ extern "C" {
  *******************************************************************************
  * @ingroup COMMS
  * @description
- *    Establish a connection to the syslogd daemon.
+ *    Establish a connection to the syslogd daemon and start the thread that
+ *    drains the log ring to it. Messages written before this call, or if the
+ *    thread cannot be started, go to syslog directly.
  *
  * @param prog_name     IN      Identifier for the program in the log file.
  ******************************************************************************/
-static inline void init_logger(const char *prog_name)
-{
-    static int init_done = 0;
-    if(init_done == 0)
-    {
-        init_done++;
-		openlog(prog_name, LOG_NDELAY|LOG_PID, LOG_LOCAL2);
-    }
-};
+void init_logger(const char *prog_name);
 
 /**
  *******************************************************************************
  * @ingroup COMMS
  * @description
- *    Write the message to the syslog daemon.
+ *    Write out any messages left in the log ring, stop the drain thread and
+ *    close the connection to the syslog daemon. The ring is written out on the
+ *    calling thread, so this may be called from a signal handler. It is also
+ *    called when the process exits.
+ ******************************************************************************/
+void close_logger(void);
+
+/**
+ *******************************************************************************
+ * @ingroup COMMS
+ * @description
+ *    Write the message to the syslog daemon. The message is formatted into a
+ *    record on the log ring and written out by the drain thread, so callers
+ *    never wait on syslog. If the ring is full the message is dropped, and
+ *    messages with the same text are limited to LOGGER_RATE_LIMIT a second;
+ *    the number of dropped and suppressed messages is logged later.
  *
  * @param message     IN      The contents of the message to write to file.
  ******************************************************************************/
-static inline void write_to_syslog(char * message,...)
-{
-    char header[MAX_MESSAGE_HEADER_SIZE];
-    char body[MAX_MESSAGE_BODY_SIZE];
-
-    va_list arguments;
-    struct timeval tv;
-    char time_arr[16];  
-
-    time_t current_time = time(NULL);
-    struct tm* local_time = localtime(&current_time);
-    gettimeofday(&tv, NULL);
-    
-    sprintf(time_arr, "%02d:%02d:%02d.%03d", (int)local_time->tm_hour,
-        (int)local_time->tm_min, (int)local_time->tm_sec, (int)tv.tv_usec/1000);
-    
-    sprintf(header, "eniq> %s ? %d:", time_arr, LOG_NOTICE);
+void write_to_syslog(const char * message,...) __attribute__((format(printf, 1, 2)));
 
-    memset(header,0,MAX_MESSAGE_HEADER_SIZE);
-    memset(body,0,MAX_MESSAGE_BODY_SIZE);
-
-
-    if (strlen(message) < sizeof(body))
-    {
-        va_start(arguments, message);
-        vsprintf(body, message, arguments);
-        va_end(arguments);
-        syslog(LOG_NOTICE|LOG_LOCAL2,"%s %s", header, body);
-    }
-};
+/**
+ *******************************************************************************
+ * @ingroup COMMS
+ * @description
+ *    Write the message to the syslog daemon as write_to_syslog() does, but
+ *    without rate limiting. This is for periodic output such as monitor
+ *    statistics, which its callers already limit.
+ *
+ * @param message     IN      The contents of the message to write to file.
+ ******************************************************************************/
+void write_to_syslog_unlimited(const char * message,...) __attribute__((format(printf, 1, 2)));
 
 #ifdef __cplusplus
 }
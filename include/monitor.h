@@ -40,6 +40,8 @@ extern "C" {
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <sys/time.h>
+#include <sys/types.h>
 
 /*******************************************************************************
 * Include private header files
@@ -53,6 +55,23 @@ extern "C" {
 #define MONITOR_OUTPUT_INTERVAL 10 /* In seconds */
 #define MAX_MONITORS 128
 
+#define MONITOR_CACHE_LINE_SIZE 64   /* Size of a cache line in octets, shards are aligned on this */
+#define MONITOR_MAX_THREADS     128  /* The number of threads that may own a counter shard, one per PCAP session */
+#define MONITOR_SHARED_SHARD    MONITOR_MAX_THREADS    /* The shard used by threads that have not registered */
+#define MONITOR_SHARDS          (MONITOR_MAX_THREADS + 1)
+
+#define MONITOR_HISTOGRAM_SUB_BITS    4   /* Sub bucket bits per power of two, gives a worst case error of 1/16 */
+#define MONITOR_HISTOGRAM_SUB_BUCKETS (1 << MONITOR_HISTOGRAM_SUB_BITS)
+#define MONITOR_HISTOGRAM_MAX_BITS    40  /* Values are in microseconds, larger values are counted in the last bucket */
+#define MONITOR_HISTOGRAM_BUCKETS     ((MONITOR_HISTOGRAM_MAX_BITS - MONITOR_HISTOGRAM_SUB_BITS + 1) * MONITOR_HISTOGRAM_SUB_BUCKETS)
+#define MONITOR_PERCENTILES           4   /* p50, p99, p99.9 and max */
+
+#define MONITOR_STATS_DIRECTORY "/dev/shm"  /* Where statistics segments are created */
+#define MONITOR_STATS_PREFIX    "pcapstat." /* Statistics segments are named pcapstat.<program>.<pid> */
+#define MONITOR_STATS_MAGIC     "PCAPSTAT"
+#define MONITOR_STATS_VERSION   3           /* Increment when the layout of the segment changes */
+#define MONITOR_STATS_SLOTS     MAX_MONITORS
+
 /**
  *******************************************************************************
  * @ingroup MONITOR
@@ -65,19 +84,192 @@ static time_t monitor_last_output_time;
  *******************************************************************************
  * @ingroup MONITOR
  * @description
- *    Monitor structure.
+ *    The counter shard of the calling thread, set by monitor_register_thread().
+ *    Defined in monitor.c.
  ******************************************************************************/
-struct monitor {
-	int id;                              // The ID of the monitor
-	char description[FILENAME_MAX];      // The monitor description
+extern __thread int monitor_thread_shard;
+
+/**
+ *******************************************************************************
+ * @ingroup MONITOR
+ * @description
+ *    Monitored counters. A snapshot of the counters is also held in this
+ *    structure.
+ ******************************************************************************/
+struct monitor_counters {
 	long long packets;                   // The number of packets monitored
 	long long bytes;                     // The number of bytes monitored
-	long long gtp_packets;               // The number of bytes monitored
-	long long gtp_bytes;                 // The number of bytes monitored
+	long long gtp_packets;               // The number of GTP packets monitored
+	long long gtp_bytes;                 // The number of GTP bytes monitored
 	long long gtp_ext;                   // The number of packets with GTP extension header optional fields
 	long long gtp_seqno;                 // The number of packets with GTP sequence number fields
 	long long gtp_npdu;                  // The number of packets with GTP sequence N-PDU fields
-	time_t last_output_time;             // The time of the last output
+	long long kernel_drops;              // The number of packets dropped by the kernel before capture
+	long long interface_drops;           // The number of packets dropped by the network interface
+	long long distributor_drops;         // The number of packets dropped by the distributor itself
+};
+
+/**
+ *******************************************************************************
+ * @ingroup MONITOR
+ * @description
+ *    A per thread shard of counters. Each shard is only ever written by the
+ *    thread that owns it and sits on its own cache line, so the counters are
+ *    incremented with plain stores. Counters are never cleared, the supervision
+ *    thread reads them and works out the deltas against its last snapshot.
+ ******************************************************************************/
+struct monitor_shard {
+	volatile long long packets;
+	volatile long long bytes;
+	volatile long long gtp_packets;
+	volatile long long gtp_bytes;
+	volatile long long gtp_ext;
+	volatile long long gtp_seqno;
+	volatile long long gtp_npdu;
+	volatile long long distributor_drops;
+} __attribute__((aligned(MONITOR_CACHE_LINE_SIZE)));
+
+/**
+ *******************************************************************************
+ * @ingroup MONITOR
+ * @description
+ *    A latency histogram with logarithmic buckets. Each power of two is split
+ *    into MONITOR_HISTOGRAM_SUB_BUCKETS linear sub buckets, so recording a value
+ *    is a bit scan and one increment. Like the counter shards, the bucket counts
+ *    are never cleared and the supervision thread works out the deltas against
+ *    its last snapshot. A histogram must only be recorded on by one thread at a
+ *    time.
+ ******************************************************************************/
+struct monitor_histogram {
+	char description[FILENAME_MAX];                     // What the histogram measures
+	volatile long long counts[MONITOR_HISTOGRAM_BUCKETS]; // The bucket counts
+	long long last_counts[MONITOR_HISTOGRAM_BUCKETS];   // The bucket counts at the last output
+};
+
+/**
+ *******************************************************************************
+ * @ingroup MONITOR
+ * @description
+ *    Monitor structure.
+ ******************************************************************************/
+struct monitor {
+	struct monitor_shard shards[MONITOR_SHARDS]; // The counter shards, one per thread
+	int id;                                      // The ID of the monitor
+	char description[FILENAME_MAX];              // The monitor description
+	struct monitor_counters last;                // The counter totals at the last output
+	struct monitor_histogram* latency;           // The latency histogram, NULL if latency is not monitored
+	time_t last_output_time;                     // The time of the last output
+	volatile long long kernel_drops;             // The kernel drops on the capture handle, written by the capturing thread
+	volatile long long interface_drops;          // The interface drops on the capture handle, written by the capturing thread
+	unsigned int last_ps_drop;                   // The last ps_drop value from pcap_stats(), used to handle wrap around
+	unsigned int last_ps_ifdrop;                 // The last ps_ifdrop value from pcap_stats(), used to handle wrap around
+	volatile double target_packets_per_second;   // The packet rate the monitored stream is paced at, 0 if not paced on packets
+	volatile double target_bits_per_second;      // The bit rate the monitored stream is paced at, 0 if not paced on bits
+	int slot;                                    // The statistics segment slot of the monitor, -1 if not in the segment
+};
+
+/**
+ *******************************************************************************
+ * @ingroup MONITOR
+ * @description
+ *    The header of a statistics segment. The segment is a file in
+ *    MONITOR_STATS_DIRECTORY that is mapped into memory, it holds the header
+ *    followed by MONITOR_STATS_SLOTS slots. Monitors are allocated in the slots
+ *    so readers see the counters live, without any copying on the data path.
+ ******************************************************************************/
+struct monitor_stats_header {
+	char magic[8];                       // MONITOR_STATS_MAGIC, set last when the segment is ready
+	unsigned int version;                // MONITOR_STATS_VERSION
+	unsigned int header_size;            // The size of this header
+	unsigned int slot_size;              // The size of a slot
+	unsigned int slot_count;             // The number of slots following the header
+	pid_t pid;                           // The process that owns the segment
+	time_t start_time;                   // The time the segment was created
+	char program_name[FILENAME_MAX];     // The name of the program that owns the segment
+} __attribute__((aligned(MONITOR_CACHE_LINE_SIZE)));
+
+/**
+ *******************************************************************************
+ * @ingroup MONITOR
+ * @description
+ *    A slot in a statistics segment. The slot is protected by a sequence lock,
+ *    the sequence is odd while a monitor is being opened or closed in the slot.
+ *    Readers copy the slot and retry if the sequence changed during the copy.
+ *    The counters themselves only ever increase so they do not take the lock.
+ ******************************************************************************/
+struct monitor_stats_slot {
+	volatile unsigned int sequence;      // The sequence lock
+	volatile unsigned int generation;    // Incremented each time a monitor is opened in the slot
+	volatile int in_use;                 // Set if a monitor is open in the slot
+	volatile int latency_in_use;         // Set if the monitor in the slot monitors latency
+	struct monitor monitor;              // The monitor
+	struct monitor_histogram latency;    // The latency histogram of the monitor
+};
+
+/**
+ *******************************************************************************
+ * @ingroup MONITOR
+ * @description
+ *    Functions implemented in monitor.c.
+ ******************************************************************************/
+
+// Allocate a monitor, in the statistics segment if it is open, on the heap otherwise
+struct monitor* monitor_alloc(int id, char* description);
+
+// Free a monitor allocated with monitor_alloc()
+void monitor_free(struct monitor* monitor);
+
+// Allocate the latency histogram of a monitor
+struct monitor_histogram* monitor_latency_alloc(struct monitor* monitor);
+
+// Create the statistics segment for this process, returns 1 on success, 0 otherwise
+int monitor_stats_open(const char* program_name);
+
+// Remove the statistics segment name, the segment stays mapped until the process exits
+void monitor_stats_close(void);
+
+// Take a consistent copy of a statistics slot, returns 1 if a monitor is open in the slot, 0 otherwise
+int monitor_stats_read_slot(const struct monitor_stats_slot* slot, struct monitor_stats_slot* copy);
+
+/**
+ *******************************************************************************
+ * @ingroup MONITOR
+ * @description
+ *    This function registers the calling thread as the owner of a counter shard.
+ *    Each thread that increments monitors must register with a shard number that
+ *    no other running thread uses; threads that do not register share a shard,
+ *    which they update with atomic additions.
+ *
+ * @param shard         IN      The shard number, 0 to MONITOR_MAX_THREADS-1
+ ******************************************************************************/
+static inline void monitor_register_thread(int shard)
+{
+	if (shard < 0 || shard >= MONITOR_MAX_THREADS) {
+		shard = MONITOR_SHARED_SHARD;
+	}
+
+	monitor_thread_shard = shard;
+};
+
+/**
+ *******************************************************************************
+ * @ingroup MONITOR
+ * @description
+ *    This function adds a value to a counter in the shard of the calling
+ *    thread. The shared shard may be updated by several threads at once, so
+ *    its counters are added to atomically; a thread's own shard is not.
+ *
+ * @param counter       IN      Pointer to the counter
+ * @param value         IN      The value to add
+ ******************************************************************************/
+static inline void monitor_counter_add(volatile long long* counter, long long value)
+{
+	if (monitor_thread_shard == MONITOR_SHARED_SHARD) {
+		__sync_fetch_and_add(counter, value);
+	}
+	else {
+		*counter += value;
+	}
 };
 
 /**
@@ -93,15 +285,11 @@ struct monitor {
  ******************************************************************************/
 static inline struct monitor* monitor_open(int id, char* description)
 {
-	// Allocate memory for the monitor struct
-	struct monitor* monitor = (struct monitor *) calloc(1, sizeof(struct monitor));
-
-	// Set the initial data for this monitor
-	monitor->id = id;
-
-	// Set the description of the monitor, set last character as zero to avoid overruns on strings
-	strncpy(monitor->description, description, FILENAME_MAX);
-	monitor->description[FILENAME_MAX-1] = 0;
+	// Allocate and initialize the monitor struct
+	struct monitor* monitor = monitor_alloc(id, description);
+	if (monitor == NULL) {
+		return NULL;
+	}
 
 	// If overall last output time is zero, set it to now
 	if (monitor_last_output_time == 0) {
@@ -128,7 +316,7 @@ static inline void monitor_close(struct monitor* monitor)
 	// Clear the monitor memory and set the monitor as null
     if(monitor!=NULL)
     {
-	    free(monitor);
+	    monitor_free(monitor);
 	    monitor = NULL;
     }
 };
@@ -150,8 +338,9 @@ static inline void monitor_increment(struct monitor* monitor, long long packets,
 		return;
 	}
 
-	monitor->packets += packets;
-	monitor->bytes += bytes;
+	struct monitor_shard* shard = &monitor->shards[monitor_thread_shard];
+	monitor_counter_add(&shard->packets, packets);
+	monitor_counter_add(&shard->bytes, bytes);
 };
 
 /**
@@ -173,11 +362,322 @@ static inline void monitor_increment_gtp(struct monitor* monitor, long long gtp_
 		return;
 	}
 
-	monitor->gtp_packets += gtp_packets;
-	monitor->gtp_bytes   += gtp_bytes;
-	monitor->gtp_ext     += GTP_EXT_FLAG(gtp_options);
-	monitor->gtp_seqno   += GTP_SEQ_FLAG(gtp_options);
-	monitor->gtp_npdu    += GTP_NPDU_FLAG(gtp_options);
+	struct monitor_shard* shard = &monitor->shards[monitor_thread_shard];
+	monitor_counter_add(&shard->gtp_packets, gtp_packets);
+	monitor_counter_add(&shard->gtp_bytes,   gtp_bytes);
+	monitor_counter_add(&shard->gtp_ext,     GTP_EXT_FLAG(gtp_options));
+	monitor_counter_add(&shard->gtp_seqno,   GTP_SEQ_FLAG(gtp_options));
+	monitor_counter_add(&shard->gtp_npdu,    GTP_NPDU_FLAG(gtp_options));
+};
+
+/**
+ *******************************************************************************
+ * @ingroup MONITOR
+ * @description
+ *    This function increments the number of packets dropped by the
+ *    distributor, for example packets that could not be sent to a client.
+ *
+ * @param monitor       IN      Pointer to the monitor structure.
+ * @param drops         IN      The number of packets dropped
+ ******************************************************************************/
+static inline void monitor_increment_drops(struct monitor* monitor, long long drops)
+{
+	// Sanity check the monitor pointer
+	if (monitor == NULL) {
+		return;
+	}
+
+	monitor_counter_add(&monitor->shards[monitor_thread_shard].distributor_drops, drops);
+};
+
+/**
+ *******************************************************************************
+ * @ingroup MONITOR
+ * @description
+ *    This function sets the capture drop counters of a monitor from the
+ *    ps_drop and ps_ifdrop values returned by pcap_stats(). Those values are
+ *    32 bit and wrap, so the difference from the last values is accumulated.
+ *    Only the thread that owns the capture handle may call this function.
+ *
+ * @param monitor       IN      Pointer to the monitor structure.
+ * @param ps_drop       IN      The ps_drop value from pcap_stats()
+ * @param ps_ifdrop     IN      The ps_ifdrop value from pcap_stats()
+ ******************************************************************************/
+static inline void monitor_set_capture_drops(struct monitor* monitor, unsigned int ps_drop, unsigned int ps_ifdrop)
+{
+	// Sanity check the monitor pointer
+	if (monitor == NULL) {
+		return;
+	}
+
+	monitor->kernel_drops    += (unsigned int)(ps_drop - monitor->last_ps_drop);
+	monitor->interface_drops += (unsigned int)(ps_ifdrop - monitor->last_ps_ifdrop);
+	monitor->last_ps_drop   = ps_drop;
+	monitor->last_ps_ifdrop = ps_ifdrop;
+};
+
+/**
+ *******************************************************************************
+ * @ingroup MONITOR
+ * @description
+ *    This function sets the rate the monitored stream is paced at, the rate
+ *    achieved is then output against it.
+ *
+ * @param monitor                   IN      Pointer to the monitor structure.
+ * @param target_packets_per_second IN      The target packet rate, 0 if not paced on packets
+ * @param target_bits_per_second    IN      The target bit rate, 0 if not paced on bits
+ ******************************************************************************/
+static inline void monitor_set_target_rate(struct monitor* monitor, double target_packets_per_second, double target_bits_per_second)
+{
+	// Sanity check the monitor pointer
+	if (monitor == NULL) {
+		return;
+	}
+
+	monitor->target_packets_per_second = target_packets_per_second;
+	monitor->target_bits_per_second = target_bits_per_second;
+};
+
+/**
+ *******************************************************************************
+ * @ingroup MONITOR
+ * @description
+ *    This function turns on latency monitoring on a monitor.
+ *
+ * @param monitor       IN      Pointer to the monitor structure.
+ * @param description   IN      A description of the latency being measured
+ *
+ * @retval int          OUT     1 if latency monitoring is on, 0 otherwise
+ ******************************************************************************/
+static inline int monitor_enable_latency(struct monitor* monitor, char* description)
+{
+	// Sanity check the monitor pointer
+	if (monitor == NULL) {
+		return 0;
+	}
+
+	if (monitor->latency == NULL) {
+		monitor->latency = monitor_latency_alloc(monitor);
+		if (monitor->latency == NULL) {
+			return 0;
+		}
+	}
+
+	strncpy(monitor->latency->description, description, FILENAME_MAX);
+	monitor->latency->description[FILENAME_MAX-1] = 0;
+
+	return 1;
+};
+
+/**
+ *******************************************************************************
+ * @ingroup MONITOR
+ * @description
+ *    This function returns the histogram bucket in which a value is counted.
+ *
+ * @param value         IN      The value, in microseconds
+ *
+ * @retval int          OUT     The bucket index
+ ******************************************************************************/
+static inline int monitor_histogram_bucket(long long value)
+{
+	if (value < MONITOR_HISTOGRAM_SUB_BUCKETS) {
+		return (value < 0 ? 0 : (int)value);
+	}
+
+	if (value >= (1LL << MONITOR_HISTOGRAM_MAX_BITS)) {
+		return MONITOR_HISTOGRAM_BUCKETS - 1;
+	}
+
+	// The power of two selects the bucket row, the bits below the leading one select the sub bucket
+	int power = 63 - __builtin_clzll((unsigned long long)value);
+	int shift = power - MONITOR_HISTOGRAM_SUB_BITS;
+
+	return (shift + 1) * MONITOR_HISTOGRAM_SUB_BUCKETS + (int)((value >> shift) & (MONITOR_HISTOGRAM_SUB_BUCKETS - 1));
+};
+
+/**
+ *******************************************************************************
+ * @ingroup MONITOR
+ * @description
+ *    This function returns the highest value that is counted in a histogram
+ *    bucket.
+ *
+ * @param bucket        IN      The bucket index
+ *
+ * @retval long long    OUT     The highest value of the bucket, in microseconds
+ ******************************************************************************/
+static inline long long monitor_histogram_value(int bucket)
+{
+	if (bucket < MONITOR_HISTOGRAM_SUB_BUCKETS) {
+		return bucket;
+	}
+
+	int shift = bucket / MONITOR_HISTOGRAM_SUB_BUCKETS - 1;
+	long long sub_bucket = MONITOR_HISTOGRAM_SUB_BUCKETS + bucket % MONITOR_HISTOGRAM_SUB_BUCKETS;
+
+	return ((sub_bucket + 1) << shift) - 1;
+};
+
+/**
+ *******************************************************************************
+ * @ingroup MONITOR
+ * @description
+ *    This function records a latency on a monitor.
+ *
+ * @param monitor       IN      Pointer to the monitor structure.
+ * @param latency       IN      The latency, in microseconds
+ ******************************************************************************/
+static inline void monitor_record_latency(struct monitor* monitor, long long latency)
+{
+	// Sanity check the monitor pointer and check if latency is monitored
+	if (monitor == NULL || monitor->latency == NULL) {
+		return;
+	}
+
+	monitor->latency->counts[monitor_histogram_bucket(latency)]++;
+};
+
+/**
+ *******************************************************************************
+ * @ingroup MONITOR
+ * @description
+ *    This function returns the number of microseconds between two times.
+ *
+ * @param start         IN      The start time
+ * @param end           IN      The end time
+ *
+ * @retval long long    OUT     The time between start and end in microseconds
+ ******************************************************************************/
+static inline long long monitor_usec_between(const struct timeval* start, const struct timeval* end)
+{
+	return (end->tv_sec - start->tv_sec) * 1000000LL + (end->tv_usec - start->tv_usec);
+};
+
+/**
+ *******************************************************************************
+ * @ingroup MONITOR
+ * @description
+ *    This function works out p50, p99, p99.9 and max from histogram bucket
+ *    counts.
+ *
+ * @param counts        IN      The bucket counts, MONITOR_HISTOGRAM_BUCKETS of them
+ * @param percentiles   OUT     The percentiles in microseconds, MONITOR_PERCENTILES of them
+ *
+ * @retval long long    OUT     The total of the bucket counts
+ ******************************************************************************/
+static inline long long monitor_histogram_percentiles(const long long* counts, long long* percentiles)
+{
+	long long total = 0;
+	int highest = 0;
+	for (int i = 0; i < MONITOR_HISTOGRAM_BUCKETS; i++) {
+		if (counts[i] > 0) {
+			total += counts[i];
+			highest = i;
+		}
+	}
+
+	memset(percentiles, 0, sizeof(long long) * MONITOR_PERCENTILES);
+	if (total == 0) {
+		return 0;
+	}
+
+	// Walk up the buckets to find the percentiles, per mille to keep integer arithmetic
+	const int per_mille[] = {500, 990, 999};
+	long long cumulative = 0;
+	int p = 0;
+	for (int i = 0; i <= highest && p < MONITOR_PERCENTILES - 1; i++) {
+		cumulative += counts[i];
+		while (p < MONITOR_PERCENTILES - 1 && cumulative * 1000 >= total * per_mille[p]) {
+			percentiles[p++] = monitor_histogram_value(i);
+		}
+	}
+	percentiles[MONITOR_PERCENTILES - 1] = monitor_histogram_value(highest);
+
+	return total;
+};
+
+/**
+ *******************************************************************************
+ * @ingroup MONITOR
+ * @description
+ *    This function outputs the latency percentiles of a monitor for the last
+ *    interval and takes a new snapshot of the histogram.
+ *
+ * @param monitor       IN      Pointer to the monitor structure.
+ ******************************************************************************/
+static inline void handle_monitor_latency(struct monitor* monitor)
+{
+	struct monitor_histogram* histogram = monitor->latency;
+
+	// Take a snapshot of the buckets and work out the counts in this interval
+	long long counts[MONITOR_HISTOGRAM_BUCKETS];
+	for (int i = 0; i < MONITOR_HISTOGRAM_BUCKETS; i++) {
+		long long count = histogram->counts[i];
+		counts[i] = count - histogram->last_counts[i];
+		histogram->last_counts[i] = count;
+	}
+
+	long long percentiles[MONITOR_PERCENTILES];
+	long long total = monitor_histogram_percentiles(counts, percentiles);
+	if (total == 0) {
+		return;
+	}
+
+	write_to_syslog_unlimited(" latency %s: count=%lld, p50=%lldus, p99=%lldus, p99.9=%lldus, max=%lldus\n",
+			histogram->description, total, percentiles[0], percentiles[1], percentiles[2], percentiles[3]);
+};
+
+/**
+ *******************************************************************************
+ * @ingroup MONITOR
+ * @description
+ *    This function sums the counter shards of a monitor. Each counter is read
+ *    with a single aligned load so a running total is never torn.
+ *
+ * @param monitor       IN      Pointer to the monitor structure.
+ * @param totals        OUT     The summed counters
+ ******************************************************************************/
+static inline void monitor_snapshot(struct monitor* monitor, struct monitor_counters* totals)
+{
+	memset(totals, 0, sizeof(struct monitor_counters));
+
+	for (int i = 0; i < MONITOR_SHARDS; i++) {
+		struct monitor_shard* shard = &monitor->shards[i];
+		totals->packets     += shard->packets;
+		totals->bytes       += shard->bytes;
+		totals->gtp_packets += shard->gtp_packets;
+		totals->gtp_bytes   += shard->gtp_bytes;
+		totals->gtp_ext     += shard->gtp_ext;
+		totals->gtp_seqno   += shard->gtp_seqno;
+		totals->gtp_npdu    += shard->gtp_npdu;
+		totals->distributor_drops += shard->distributor_drops;
+	}
+
+	// The capture drops are only written by the thread owning the capture handle
+	totals->kernel_drops    = monitor->kernel_drops;
+	totals->interface_drops = monitor->interface_drops;
+};
+
+/**
+ *******************************************************************************
+ * @ingroup MONITOR
+ * @description
+ *    This function returns the number of bytes counted on a monitor since its
+ *    last output.
+ *
+ * @param monitor       IN      Pointer to the monitor structure.
+ *
+ * @retval long long    OUT     The number of bytes since the last output
+ ******************************************************************************/
+static inline long long monitor_bytes_since_output(struct monitor* monitor)
+{
+	long long bytes = 0;
+	for (int i = 0; i < MONITOR_SHARDS; i++) {
+		bytes += monitor->shards[i].bytes;
+	}
+
+	return bytes - monitor->last.bytes;
 };
 
 /**
@@ -206,27 +706,53 @@ static inline void handle_monitor(struct monitor* monitor)
 
 	int time_since_output = current_time - monitor->last_output_time;
 
+	// Take a snapshot of the counters, the interval values are the difference from the last snapshot
+	struct monitor_counters now;
+	monitor_snapshot(monitor, &now);
+
+	long long packets     = now.packets     - monitor->last.packets;
+	long long bytes       = now.bytes       - monitor->last.bytes;
+	long long gtp_packets = now.gtp_packets - monitor->last.gtp_packets;
+	long long gtp_bytes   = now.gtp_bytes   - monitor->last.gtp_bytes;
+	long long gtp_ext     = now.gtp_ext     - monitor->last.gtp_ext;
+	long long gtp_seqno   = now.gtp_seqno   - monitor->last.gtp_seqno;
+	long long gtp_npdu    = now.gtp_npdu    - monitor->last.gtp_npdu;
+	long long kernel_drops      = now.kernel_drops      - monitor->last.kernel_drops;
+	long long interface_drops   = now.interface_drops   - monitor->last.interface_drops;
+	long long distributor_drops = now.distributor_drops - monitor->last.distributor_drops;
+
 	// Calculate some variables from the monitor
-	double packets_per_second = (monitor->packets > 0 ? (double)(monitor->packets / time_since_output) : 0.0);
-	double bytes_per_second = (monitor->bytes > 0 ? (double)(monitor->bytes / time_since_output) : 0.0);
+	double packets_per_second = (packets > 0 ? (double)(packets / time_since_output) : 0.0);
+	double bytes_per_second = (bytes > 0 ? (double)(bytes / time_since_output) : 0.0);
 	double bits_per_second = bytes_per_second * 8;
 
-	write_to_syslog("monitor %d-%s: pkts=%lld, pkts/s=%f, bytes=%lld, bytes/s=%f, Mbits/s=%f",
-			monitor->id, monitor->description, monitor->packets, packets_per_second, monitor->bytes, bytes_per_second, bits_per_second / 1000000);
-	write_to_syslog(" gtppkts=%lld, gtpbytes=%lld, gtpext=%lld, gtpseqno=%lld, gtpnpdu=%lld\n",
-			monitor->gtp_packets, monitor->gtp_bytes, monitor->gtp_ext, monitor->gtp_seqno, monitor->gtp_npdu);
+	write_to_syslog_unlimited("monitor %d-%s: pkts=%lld, pkts/s=%f, bytes=%lld, bytes/s=%f, Mbits/s=%f",
+			monitor->id, monitor->description, packets, packets_per_second, bytes, bytes_per_second, bits_per_second / 1000000);
+	write_to_syslog_unlimited(" kerneldrops=%lld, ifdrops=%lld, distdrops=%lld,",
+			kernel_drops, interface_drops, distributor_drops);
+	write_to_syslog_unlimited(" gtppkts=%lld, gtpbytes=%lld, gtpext=%lld, gtpseqno=%lld, gtpnpdu=%lld\n",
+			gtp_packets, gtp_bytes, gtp_ext, gtp_seqno, gtp_npdu);
+
+	// Output the rate achieved against the target rate if the stream is paced
+	if (monitor->target_packets_per_second > 0) {
+		write_to_syslog_unlimited(" target pkts/s=%f, achieved=%.2f%%\n",
+				monitor->target_packets_per_second, packets_per_second * 100 / monitor->target_packets_per_second);
+	}
+	if (monitor->target_bits_per_second > 0) {
+		write_to_syslog_unlimited(" target Mbits/s=%f, achieved=%.2f%%\n",
+				monitor->target_bits_per_second / 1000000, bits_per_second * 100 / monitor->target_bits_per_second);
+	}
+
+	// Output latency if it is monitored
+	if (monitor->latency != NULL) {
+		handle_monitor_latency(monitor);
+	}
 
 	// Record output time
 	monitor->last_output_time = monitor_last_output_time;
 
-	// Clear all counters
-	monitor->bytes = 0;
-	monitor->packets = 0;
-	monitor->gtp_bytes = 0;
-	monitor->gtp_packets = 0;
-	monitor->gtp_ext = 0;
-	monitor->gtp_seqno = 0;
-	monitor->gtp_npdu = 0;
+	// The snapshot becomes the base for the next interval, this clears the interval counters
+	monitor->last = now;
 };
 
 #ifdef __cplusplus
@@ -26,5 +26,12 @@
 #define PCAP_TIMEOUT      1500   // Number of milliseconds to wait before timing out on a packet capture wait
 #define PCAP_INFINITE        -1  // Loop forever on pcap_loop capturing packets
 #define PCAP_FILE_TYPE   ".pcap" // The file type of PCAP files
+#define PCAP_MIN_CHUNK_SIZE 0x100000 // Minimum size of a chunk file
+#define PCAP_RECORD_HEADER_SIZE   16 // The size of the header of a record in a PCAP file
+
+// Defines for PCAP time index files
+#define PCAP_INDEX_FILE_TYPE ".idx"  // The file type of time index files, appended to the name of the PCAP file
+#define PCAP_INDEX_MAGIC "PCAPIDX"   // The magic string at the start of a time index file
+#define PCAP_INDEX_VERSION 1         // The version of the time index file format
 
 #endif /* PCAPDEFINES_H_ */
@@ -20,12 +20,15 @@
 #ifndef PCAPSESSION_H_
 #define PCAPSESSION_H_
 
+#include <stdio.h>
+#include <stdint.h>
 #include <pthread.h>
 #include <netinet/in.h>
 #include <pcap/pcap.h>
 #include <tcp.h>
 
 #include <monitor.h>
+#include <gtp_classify.h>
 
 // The maximum number of PCAP sessions allowable
 #define PCAP_SESSION_MAX_SESSIONS 128
@@ -61,6 +64,30 @@
 // Flags for iterations
 #define PCAP_SESSION_ITERATE_INFINITY -1
 
+// States of the replay cache of a file capture session
+#define PCAP_SESSION_REPLAY_OFF       0  // Packets are neither cached nor time shifted
+#define PCAP_SESSION_REPLAY_LOADING   1  // The first iteration is being read from the files and its packets cached
+#define PCAP_SESSION_REPLAY_MEASURING 2  // The first iteration is being read from the files, it is too big to cache
+#define PCAP_SESSION_REPLAY_LOADED    3  // Iterations are replayed from the cache
+#define PCAP_SESSION_REPLAY_SHIFTING  4  // Iterations are read from the files with their time stamps shifted
+
+// Pacing modes of file capture sessions
+#define PCAP_SESSION_PACING_OFF         0  // Packets are sent as fast as they are read
+#define PCAP_SESSION_PACING_TIMED       1  // Packets are sent with the gaps between their time stamps, scaled by a speed
+#define PCAP_SESSION_PACING_PACKET_RATE 2  // Packets are sent at a fixed number of packets per second
+#define PCAP_SESSION_PACING_BIT_RATE    3  // Packets are sent at a fixed number of bits per second
+
+// Flags for address remapping
+#define PCAP_SESSION_REMAP_INNER 1  // Remap the addresses of the packet tunnelled in a G-PDU
+#define PCAP_SESSION_REMAP_OUTER 2  // Remap the addresses of the IPv4 packet carrying GTP or of other IPv4 packets
+
+// The size of the buffer the reason for an error in loading an address map is returned in
+#define PCAP_SESSION_ADDRESS_MAP_ERRBUF_SIZE 256
+
+// The number of packets buffered for a client whose capture times are kept until they are sent, later packets in the
+// same buffer are not sampled for capture to send latency
+#define PCAP_SESSION_SEND_PENDING 256
+
 // Typedef for a pcapsession_run() method that should be implemented on all modules that implement pcapsession, it is called
 // in a new thread when the session is started
 typedef void* (*pcapsession_run_function)(void *pcapsession);
@@ -69,6 +96,114 @@ typedef void* (*pcapsession_run_function)(void *pcapsession);
 // when a session is closed
 typedef void* (*pcapsession_stop_function)(void *pcapsession);
 
+// Define a struct that is the header of a time index file, the fields are in host byte order
+struct pcapsession_index_header {
+	char magic[8];                         // PCAP_INDEX_MAGIC
+	uint32_t version;                      // PCAP_INDEX_VERSION
+	uint32_t sorted;                       // 1 if the records of the PCAP file are in time stamp order, set on close
+	uint64_t interval_records;             // The largest number of records in a segment, 0 if not limited
+	uint64_t interval_usec;                // The longest time span of a segment in microseconds, 0 if not limited
+};
+
+// Define a struct that is an entry of a time index file, it describes a segment of consecutive records of the PCAP
+// file, time stamps are in microseconds since the epoch
+struct pcapsession_index_entry {
+	uint64_t offset;                       // The offset of the first record of the segment in the PCAP file
+	uint64_t length;                       // The length of the records of the segment
+	uint64_t records;                      // The number of records in the segment
+	int64_t first_usec;                    // The time stamp of the first record of the segment
+	int64_t min_usec;                      // The earliest time stamp in the segment
+	int64_t max_usec;                      // The latest time stamp in the segment
+	int64_t running_max_usec;              // The latest time stamp in this segment and all segments before it
+};
+
+// Define a struct that holds the state of writing the time index of a PCAP file as it is dumped
+struct pcapsession_indexer {
+	FILE* index_file;                      // The index file, NULL if no index is being written
+	uint64_t interval_records;             // The largest number of records in a segment, 0 if not limited
+	uint64_t interval_usec;                // The longest time span of a segment in microseconds, 0 if not limited
+	uint64_t offset;                       // The offset of the next record in the PCAP file
+	int sorted;                            // Cleared if a record is earlier than the one before it
+	int64_t last_usec;                     // The time stamp of the last record
+	struct pcapsession_index_entry entry;  // The segment being indexed
+};
+
+// Typedef for passing indexers into and out of the functions here
+typedef struct pcapsession_indexer pcapsession_indexer_t;
+
+// Define a struct that is the header of a packet in a replay cache, the packet data follows it padded to 8 bytes
+struct pcapsession_replay_record {
+	int64_t usec;                          // The time stamp of the packet in microseconds
+	uint32_t caplen;                       // The length of the packet data
+	uint32_t len;                          // The length of the packet on the wire
+};
+
+// Define a struct that holds the packets of the first iteration of a file capture in one contiguous arena, so that
+// later iterations are replayed from memory. The time stamps of each iteration are shifted on from the one before
+struct pcapsession_replay_cache {
+	int state;                             // One of the PCAP_SESSION_REPLAY_ states
+	unsigned char* arena;                  // The packet records, NULL if no packets are cached
+	size_t used;                           // The amount of the arena holding packet records
+	size_t size;                           // The size of the arena
+	size_t max_size;                       // The largest size the arena may grow to, 0 if the cache is not used
+	uint64_t packets;                      // The number of packets in the first iteration
+	int64_t first_usec;                    // The earliest time stamp in the first iteration
+	int64_t last_usec;                     // The latest time stamp in the first iteration
+	int64_t shift_usec;                    // The amount the time stamps of the current iteration are shifted by
+};
+
+// Typedef for passing replay caches into and out of the functions here
+typedef struct pcapsession_replay_cache pcapsession_replay_cache_t;
+
+// Define a struct that gives how a file capture session paces the packets it sends
+struct pcapsession_pacing {
+	int mode;                              // One of the PCAP_SESSION_PACING_ modes
+	double speed;                          // For timed pacing, the multiple of the original speed to send at
+	double rate;                           // For rate pacing, the packets or bits to send per second
+};
+
+// Typedef for passing pacing settings into and out of the functions here
+typedef struct pcapsession_pacing pcapsession_pacing_t;
+
+// Define a struct that holds the state of pacing packets. Times are in nanoseconds on the monotonic clock, relative to
+// the time pacing started or was last resynchronized
+struct pcapsession_pacer {
+	pcapsession_pacing_t pacing;           // The pacing settings
+	int started;                           // Set once the first packet is paced
+	int64_t start_nsec;                    // The monotonic clock time pacing started at
+	int64_t start_usec;                    // For timed pacing, the time stamp of the packet sent at start_nsec
+	int64_t last_usec;                     // For timed pacing, the time stamp of the last packet
+	double next_nsec;                      // For rate pacing, the time the next packet is due
+	double burst_nsec;                     // For rate pacing, how far the next packet may fall behind the clock
+};
+
+// Typedef for passing pacers into and out of the functions here
+typedef struct pcapsession_pacer pcapsession_pacer_t;
+
+// Define a struct that holds the names of the files a file capture session in tail mode has streamed, so that no file is
+// streamed twice. The names are kept in order for searching and may also be appended to a journal file, from which they
+// are loaded again when the session restarts
+struct pcapsession_file_journal {
+	char file_name[FILENAME_MAX];          // The name of the journal file, empty if the names are only held in memory
+	FILE* file;                            // The journal file, NULL if it is not open
+	char** names;                          // The names of the files streamed, in order
+	size_t count;                          // The number of names
+	size_t size;                           // The number of names there is room for
+};
+
+// Typedef for passing file journals into and out of the functions here
+typedef struct pcapsession_file_journal pcapsession_file_journal_t;
+
+// Define a struct that holds the capture times of the packets buffered for a client, the capture to send latency of the
+// packets is recorded once the buffer is written to the client socket
+struct pcapsession_send_latency {
+	struct timeval pending[PCAP_SESSION_SEND_PENDING];  // The capture times of the packets buffered, oldest first
+	unsigned int count;                    // The number of packets buffered
+};
+
+// Typedef for passing send latencies into and out of the functions here
+typedef struct pcapsession_send_latency pcapsession_send_latency_t;
+
 // Define a struct that describes a PCAP session
 struct pcapsession {
 	int id;                                // The ID of the session
@@ -88,10 +223,58 @@ struct pcapsession {
 	int interval_counter;                  // An interval counter for the number of intervals taken in transitions
 	int untunnel;                          // Indicates whether packets dumped on this session should be untunnelled
 	int iterations;                        // The number of iterations to carry out on this session
+	int live_timestamps;                   // Indicates whether packet time stamps are taken at capture, so latency can be measured from them
+	unsigned long index_records;           // For a merger, the largest number of records between time index entries
+	unsigned long index_msec;              // For a merger, the longest time in milliseconds between time index entries
+	pcapsession_indexer_t indexer;         // For a merger, the time index of the merged file
+	pcapsession_replay_cache_t replay_cache;  // For a file capture, the packets cached for iterations after the first
+	pcapsession_pacer_t pacer;             // For a file capture, the pacing of the packets sent
+	int watch_fd;                          // For a file capture in tail mode, the inotify descriptor watching the directory, -1 if none
+	pcapsession_file_journal_t journal;    // For a file capture in tail mode, the files already streamed
+	pcapsession_send_latency_t send_latency;  // For a client connection, the packets waiting to be sent
 };
 
 // Typedef for passing sessions into and out of the functions here
 typedef struct pcapsession pcapsession_t;
+
+// Define a struct that holds the state of splitting dumped packets over chunk files
+struct pcapsession_chunker {
+	pcap_t* pcap_handle;                   // The PCAP handle whose link type and snap length the chunk files take
+	pcap_dumper_t* pcap_dumper;            // The dumper of the current chunk file, NULL before the first packet
+	const char* file_name;                 // The prefix of the chunk file names
+	char chunk_file_name[FILENAME_MAX];    // The name of the current chunk file
+	unsigned long max_size;                // The maximum size of a chunk file
+	unsigned long chunk_no;                // The number of the next chunk file
+	unsigned long used;                    // The amount of data dumped to the current chunk file
+	unsigned long index_records;           // The largest number of records between time index entries
+	unsigned long index_msec;              // The longest time in milliseconds between time index entries
+	pcapsession_indexer_t indexer;         // The time index of the current chunk file
+};
+
+// Typedef for passing chunkers into and out of the functions here
+typedef struct pcapsession_chunker pcapsession_chunker_t;
+
+// Define a struct that is an entry of an address map, it maps the addresses in a prefix to the same host part in another
+// prefix, exact addresses are prefixes of length 32. Addresses are in host byte order
+struct pcapsession_address_map_entry {
+	uint32_t prefix;                       // The prefix mapped from, with the host part cleared
+	uint32_t new_prefix;                   // The prefix mapped to, with the host part cleared
+	uint8_t length;                        // The length of the prefix
+	uint8_t used;                          // 1 if the entry holds a prefix, 0 if it is free
+};
+
+// Define a struct that holds a map of IPv4 addresses and prefixes to new ones, the entries are an open addressed hash
+// table on the prefix and its length and a lookup tries the prefix lengths in the map from the longest down
+struct pcapsession_address_map {
+	struct pcapsession_address_map_entry* entries;  // The hash table
+	uint32_t size;                         // The number of entries in the hash table, a power of 2
+	uint32_t count;                        // The number of prefixes in the map
+	uint8_t lengths[33];                   // The prefix lengths in the map, longest first
+	uint8_t length_count;                  // The number of prefix lengths in the map
+};
+
+// Typedef for passing address maps into and out of the functions here
+typedef struct pcapsession_address_map pcapsession_address_map_t;
     
 // Hold a reference to the servers
 pcapsession_t session_list[PCAP_SESSION_MAX_SESSIONS];
@@ -153,13 +336,15 @@ int pcapsession_server_open(int port);
 //
 // Parameters:
 //  char* filename: The name of the file to dump to "-" for stdout
-//  addresslist_t* addresslist: The list of addresses of servers to connect to
 //  int untunnel: If true, GTP-U packets should be untunnelled
+//  unsigned long index_records: The largest number of records between time index entries, 0 if not limited
+//  unsigned long index_msec: The longest time in milliseconds between time index entries, 0 if not limited, no time
+//                            index is written if both are 0
 //
 // Returns:
 //  pcapsession_t*: Returns a pointer to the merger or NULL if opening failed
 //
-pcapsession_t* pcapsession_merger_open(char* filename, int untunnel);
+pcapsession_t* pcapsession_merger_open(char* filename, int untunnel, unsigned long index_records, unsigned long index_msec);
 
 //
 // This function handles a new client connection accepted on the server socket
@@ -190,11 +375,29 @@ int pcapsession_livecapture_open(char* interface_name);
 // Parameters:
 //  char* directory_name: The directory containing PCAP files to be streamed in
 //  int iterations: The number of iterations to use over the files
+//  unsigned long cache_mb: The megabytes of memory the packets may be cached in for iterations after the first, 0 to
+//                          read every iteration from the files with the time stamps recorded in them
+//  const pcapsession_pacing_t* pacing: How the packets are paced, NULL to send them as fast as they are read
+//
+// Returns:
+//  int: Returns a value of 1 if the file capture session is created and added to session handling
+//
+int pcapsession_filecapture_open(char* directory_name, int iterations, unsigned long cache_mb, const pcapsession_pacing_t* pacing);
+
+//
+// This function opens a PCAP file capture session that tails a directory. The PCAP files in the directory are streamed
+// in name order, then each PCAP file closed after writing in or moved into the directory is streamed once it is complete
+//
+// Parameters:
+//  char* directory_name: The directory containing PCAP files to be streamed in
+//  const char* journal_file_name: The file in which the names of the files streamed are recorded, so that they are not
+//                                 streamed again when the session restarts, NULL if no journal is kept
+//  const pcapsession_pacing_t* pacing: How the packets are paced, NULL to send them as fast as they are read
 //
 // Returns:
 //  int: Returns a value of 1 if the file capture session is created and added to session handling
 //
-int pcapsession_filecapture_open(char* directory_name, int iterations);
+int pcapsession_filecapture_open_tail(char* directory_name, const char* journal_file_name, const pcapsession_pacing_t* pacing);
 
 //
 // This function opens a new server socket connection
@@ -218,6 +421,15 @@ int pcapsession_client_open(struct sockaddr_in server_address, pcapsession_t* pc
 //
 void pcapsession_clientconn_packet_handler(unsigned char* pcapsession_param, const struct pcap_pkthdr* header, const unsigned char* data);
 
+//
+// This function records the capture to send latency of the packets buffered for a client once the buffer has been
+// flushed to the client socket, the pcap_mutex of the session must be held
+//
+// Parameters:
+//  pcapsession_t* client: The client connection session
+//
+void pcapsession_clientconn_sent(pcapsession_t* client);
+
 //
 // This function is a PCAP packet handler callback method for packet merging
 //
@@ -229,14 +441,225 @@ void pcapsession_clientconn_packet_handler(unsigned char* pcapsession_param, con
 void pcapsession_merger_packet_handler(unsigned char* pcapsession_param, const struct pcap_pkthdr* header, const unsigned char* data);
 
 //
-// This function untunnels GTP-U packets by moving the enclosed IP header up to just under the Ethernet header
+// This function untunnels GTP-U packets by moving the enclosed IP header up to just under the link layer header
 //
 // Parameters:
 //  pcapsession_t*: Returns a pointer to the merger or NULL if opening failed
+//  int linktype: The link layer type of the capture, DLT_EN10MB or DLT_LINUX_SLL
 //  struct pcap_pkthdr* header: A pointer to the header of the packet
 //  const unsigned char* data: A pointer to the packet data
 //
-void pcapsession_untunnel_packet(pcapsession_t* pcapsession, struct pcap_pkthdr* header, const unsigned char* data);
+void pcapsession_untunnel_packet(pcapsession_t* pcapsession, int linktype, struct pcap_pkthdr* header, const unsigned char* data);
+
+//
+// This function untunnels a GTP-U packet that has already been classified
+//
+// Parameters:
+//  pcapsession_t*: Returns a pointer to the merger or NULL if opening failed
+//  struct pcap_pkthdr* header: A pointer to the header of the packet
+//  const unsigned char* data: A pointer to the packet data
+//  const struct gtp_class* packet_class: The class of the packet
+//
+void pcapsession_untunnel_classified_packet(pcapsession_t* pcapsession, struct pcap_pkthdr* header, const unsigned char* data, const struct gtp_class* packet_class);
+
+//
+// This function changes the addresses of a packet that are in an address map. The addresses of the IPv4 packet tunnelled
+// in a G-PDU, of the IPv4 packet carrying GTP and of other IPv4 packets can be changed. The IPv4 header checksum and
+// any TCP or UDP checksum are updated incrementally, as is the UDP checksum of the packet carrying GTP when the
+// tunnelled packet is changed
+//
+// Parameters:
+//  int linktype: The link layer type of the capture, DLT_EN10MB or DLT_LINUX_SLL
+//  struct pcap_pkthdr* header: A pointer to the header of the packet
+//  const unsigned char* data: A pointer to the packet data
+//  const pcapsession_address_map_t* map: The address map
+//  int headers: The headers to remap, a combination of the PCAP_SESSION_REMAP_ flags
+//
+// Return:
+//  int: The number of addresses changed
+//
+int pcapsession_remap_packet(int linktype, struct pcap_pkthdr* header, const unsigned char* data, const pcapsession_address_map_t* map, int headers);
+
+//
+// This function rewrites the time stamp of a packet, the first packet keeps its time stamp and each later packet is
+// stamped one microsecond after the one before it
+//
+// Parameters:
+//  struct pcap_pkthdr* header: A pointer to the header of the packet
+//  struct timeval* last_ts: The time stamp of the previous packet, zero before the first packet
+//
+void pcapsession_restamp_packet(struct pcap_pkthdr* header, struct timeval* last_ts);
+
+//
+// This function initializes splitting dumped packets over chunk files, the files are named
+// <file_name>_<chunk number>.pcap
+//
+// Parameters:
+//  pcapsession_chunker_t* chunker: The chunker to initialize
+//  pcap_t* pcap_handle: The PCAP handle whose link type and snap length the chunk files take
+//  const char* file_name: The prefix of the chunk file names
+//  unsigned long max_size: The maximum size of a chunk file
+//
+void pcapsession_chunker_init(pcapsession_chunker_t* chunker, pcap_t* pcap_handle, const char* file_name, unsigned long max_size);
+
+//
+// This function dumps a packet to the current chunk file, closing it and starting the next one if the packet does
+// not fit
+//
+// Parameters:
+//  pcapsession_chunker_t* chunker: The chunker
+//  const struct pcap_pkthdr* header: A pointer to the header of the packet
+//  const unsigned char* data: A pointer to the packet data
+//
+// Return:
+//  int: 1 if a new chunk file was started, 0 if the packet was dumped to the current one, -1 if the new chunk file
+//       could not be opened
+//
+int pcapsession_chunker_dump(pcapsession_chunker_t* chunker, const struct pcap_pkthdr* header, const unsigned char* data);
+
+//
+// This function turns on writing a time index file for each chunk file
+//
+// Parameters:
+//  pcapsession_chunker_t* chunker: The chunker
+//  unsigned long index_records: The largest number of records between time index entries, 0 if not limited
+//  unsigned long index_msec: The longest time in milliseconds between time index entries, 0 if not limited
+//
+void pcapsession_chunker_index(pcapsession_chunker_t* chunker, unsigned long index_records, unsigned long index_msec);
+
+//
+// This function closes the current chunk file
+//
+// Parameters:
+//  pcapsession_chunker_t* chunker: The chunker
+//
+void pcapsession_chunker_close(pcapsession_chunker_t* chunker);
+
+//
+// This function initializes an empty address map
+//
+// Parameters:
+//  pcapsession_address_map_t* map: The address map
+//
+// Return:
+//  int: 1 if the address map was initialized, 0 if it could not be allocated
+//
+int pcapsession_address_map_init(pcapsession_address_map_t* map);
+
+//
+// This function adds a mapping to an address map, the mapping is given as old_ip[/length] new_ip with the two
+// separated by white space or a comma. The host part of an address in a prefix is kept when it is mapped, a mapping of
+// a prefix that is already in the map replaces it
+//
+// Parameters:
+//  pcapsession_address_map_t* map: The address map
+//  const char* mapping: The mapping
+//  char* errbuf: The reason for an error is returned here, it must be PCAP_SESSION_ADDRESS_MAP_ERRBUF_SIZE long
+//
+// Return:
+//  int: 1 if the mapping was added, 0 otherwise
+//
+int pcapsession_address_map_add(pcapsession_address_map_t* map, const char* mapping, char* errbuf);
+
+//
+// This function adds the mappings in a file to an address map, the file has a mapping on each line. Empty lines and
+// text from a # on are ignored
+//
+// Parameters:
+//  pcapsession_address_map_t* map: The address map
+//  const char* file_name: The name of the file
+//  char* errbuf: The reason for an error is returned here, it must be PCAP_SESSION_ADDRESS_MAP_ERRBUF_SIZE long
+//
+// Return:
+//  int: 1 if all mappings in the file were added, 0 otherwise
+//
+int pcapsession_address_map_load(pcapsession_address_map_t* map, const char* file_name, char* errbuf);
+
+//
+// This function looks an address up in an address map, the longest prefix that holds the address is used
+//
+// Parameters:
+//  const pcapsession_address_map_t* map: The address map
+//  uint32_t address: The address in host byte order
+//  uint32_t* new_address: The mapped address is returned here in host byte order
+//
+// Return:
+//  int: 1 if the address is mapped, 0 otherwise
+//
+int pcapsession_address_map_lookup(const pcapsession_address_map_t* map, uint32_t address, uint32_t* new_address);
+
+//
+// This function frees the memory of an address map
+//
+// Parameters:
+//  pcapsession_address_map_t* map: The address map
+//
+void pcapsession_address_map_close(pcapsession_address_map_t* map);
+
+//
+// This function opens the time index file of a PCAP file that is about to be dumped, the index file is named
+// <pcap_file_name>.idx. The index is a list of segments of consecutive records, a segment is ended when it holds
+// index_records records or when a record is index_msec or more after the first record of the segment
+//
+// Parameters:
+//  pcapsession_indexer_t* indexer: The indexer
+//  const char* pcap_file_name: The name of the PCAP file
+//  unsigned long index_records: The largest number of records in a segment, 0 if not limited
+//  unsigned long index_msec: The longest time span of a segment in milliseconds, 0 if not limited
+//
+// Return:
+//  int: 1 if the index file was opened, 0 otherwise
+//
+int pcapsession_indexer_open(pcapsession_indexer_t* indexer, const char* pcap_file_name, unsigned long index_records, unsigned long index_msec);
+
+//
+// This function adds a record just dumped to the PCAP file to its time index, nothing is done if no index file is open
+//
+// Parameters:
+//  pcapsession_indexer_t* indexer: The indexer
+//  const struct pcap_pkthdr* header: A pointer to the header of the record as it was dumped
+//
+void pcapsession_indexer_add(pcapsession_indexer_t* indexer, const struct pcap_pkthdr* header);
+
+//
+// This function writes the last segment of a time index, records in the header whether the PCAP file is in time
+// stamp order and closes the index file
+//
+// Parameters:
+//  pcapsession_indexer_t* indexer: The indexer
+//
+void pcapsession_indexer_close(pcapsession_indexer_t* indexer);
+
+//
+// This function initializes a pacer, packets are paced from the first packet waited for
+//
+// Parameters:
+//  pcapsession_pacer_t* pacer: The pacer
+//  const pcapsession_pacing_t* pacing: The pacing settings, NULL to send packets as fast as they are read
+//
+void pcapsession_pacer_init(pcapsession_pacer_t* pacer, const pcapsession_pacing_t* pacing);
+
+//
+// This function restarts timed pacing from the next packet waited for, as when the time stamps start again on a new
+// iteration over the files. Rate pacing is not affected
+//
+// Parameters:
+//  pcapsession_pacer_t* pacer: The pacer
+//
+void pcapsession_pacer_resync(pcapsession_pacer_t* pacer);
+
+//
+// This function waits until a packet is due to be sent, the wait sleeps until shortly before the packet is due and
+// then polls the clock so that packets are sent at the time they are due to within a few microseconds
+//
+// Parameters:
+//  pcapsession_pacer_t* pacer: The pacer
+//  const struct pcap_pkthdr* header: A pointer to the header of the packet
+//
+// Return:
+//  long long: The number of microseconds after the time it was due that the packet is sent
+//
+long long pcapsession_pacer_wait(pcapsession_pacer_t* pacer, const struct pcap_pkthdr* header);
 
 //
 // This function is used to change the state of a PCAP session
@@ -0,0 +1,150 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: spscring.h
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This header file implements a bounded single producer, single consumer ring of fixed size elements for passing
+ * work between two threads without locks. Positions increase forever and are masked onto the elements. The producer
+ * reserves an element, fills it in place and pushes it, the consumer peeks at the oldest element and pops it when it
+ * is done with it. Each side keeps a copy of the position of the other side so that it only reads the cache line
+ * of the other side when the ring looks full or empty
+ */
+
+#ifndef SPSCRING_H_
+#define SPSCRING_H_
+
+#include <stdlib.h>
+
+// The size of a cache line in octets, the producer and consumer positions are kept on separate lines
+#define SPSC_RING_CACHE_LINE_SIZE 64
+
+//
+// A single producer, single consumer ring
+//
+struct spsc_ring {
+	volatile unsigned long head __attribute__((aligned(SPSC_RING_CACHE_LINE_SIZE))); // The next position to push, written by the producer
+	unsigned long tail_cache;            // The producer's copy of the tail
+	volatile unsigned long tail __attribute__((aligned(SPSC_RING_CACHE_LINE_SIZE))); // The next position to pop, written by the consumer
+	unsigned long head_cache;            // The consumer's copy of the head
+	unsigned long size __attribute__((aligned(SPSC_RING_CACHE_LINE_SIZE)));          // The number of elements, a power of two
+	size_t element_size;                 // The size of an element in octets
+	char* elements;                      // The elements
+};
+
+//
+// This function opens a ring
+//
+// Parameters:
+//  struct spsc_ring* ring: The ring
+//  unsigned long size: The number of elements on the ring, must be a power of two
+//  size_t element_size: The size of an element in octets
+//
+// Return:
+//  int: 1 if the ring was opened, 0 if memory could not be allocated
+//
+static inline int spsc_ring_open(struct spsc_ring* ring, unsigned long size, size_t element_size)
+{
+	ring->head = 0;
+	ring->tail_cache = 0;
+	ring->tail = 0;
+	ring->head_cache = 0;
+	ring->size = size;
+	ring->element_size = element_size;
+	ring->elements = (char*) calloc(size, element_size);
+
+	return ring->elements != NULL;
+}
+
+//
+// This function closes a ring and frees its elements
+//
+// Parameters:
+//  struct spsc_ring* ring: The ring
+//
+static inline void spsc_ring_close(struct spsc_ring* ring)
+{
+	free(ring->elements);
+	ring->elements = NULL;
+}
+
+//
+// This function reserves the next element on a ring for the producer to fill in
+//
+// Parameters:
+//  struct spsc_ring* ring: The ring
+//
+// Return:
+//  void*: The element, NULL if the ring is full
+//
+static inline void* spsc_ring_reserve(struct spsc_ring* ring)
+{
+	if (ring->head - ring->tail_cache >= ring->size) {
+		ring->tail_cache = ring->tail;
+		if (ring->head - ring->tail_cache >= ring->size) {
+			return NULL;
+		}
+	}
+
+	return ring->elements + (ring->head & (ring->size - 1)) * ring->element_size;
+}
+
+//
+// This function hands the element reserved by the producer to the consumer
+//
+// Parameters:
+//  struct spsc_ring* ring: The ring
+//
+static inline void spsc_ring_push(struct spsc_ring* ring)
+{
+	// The element must be written before the consumer can see it
+	__sync_synchronize();
+	ring->head++;
+}
+
+//
+// This function gets the oldest element on a ring for the consumer
+//
+// Parameters:
+//  struct spsc_ring* ring: The ring
+//
+// Return:
+//  void*: The element, NULL if the ring is empty
+//
+static inline void* spsc_ring_peek(struct spsc_ring* ring)
+{
+	if (ring->tail == ring->head_cache) {
+		ring->head_cache = ring->head;
+		if (ring->tail == ring->head_cache) {
+			return NULL;
+		}
+		__sync_synchronize();
+	}
+
+	return ring->elements + (ring->tail & (ring->size - 1)) * ring->element_size;
+}
+
+//
+// This function returns the element the consumer got with spsc_ring_peek() to the producer
+//
+// Parameters:
+//  struct spsc_ring* ring: The ring
+//
+static inline void spsc_ring_pop(struct spsc_ring* ring)
+{
+	// The element must be read before the producer can reuse it
+	__sync_synchronize();
+	ring->tail++;
+}
+
+#endif /* SPSCRING_H_ */
@@ -0,0 +1,81 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: tbcd.h
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This module decodes the telephony binary coded decimal (TBCD) digit strings used for IMSIs, MSISDNs and IMEISVs in
+ * GTP information elements. Each octet holds two digits, the first in the low nibble, and an odd number of digits is
+ * padded with a filler nibble of 0xf
+ */
+
+#ifndef TBCD_H_
+#define TBCD_H_
+
+#include <sys/types.h>
+
+// The filler nibble that ends a TBCD string
+#define TBCD_FILLER 0x0f
+
+// The number of digits in the longest IMSI, MSISDN and IMEISV
+#define TBCD_IMSI_MAX_DIGITS 15
+#define TBCD_MSISDN_MAX_DIGITS 15
+#define TBCD_IMEISV_MAX_DIGITS 16
+
+// The GTP V1 MSISDN starts with an octet giving the nature of address and numbering plan before the digits
+#define TBCD_MSISDN_ADDRESS_LENGTH 1
+
+//
+// This function converts a TBCD string to a string of digits, the digits stop at the first filler. The TBCD values
+// 0xa to 0xe are written as '*', '#', 'a', 'b' and 'c'
+//
+// Parameters:
+//  const u_char* tbcd: The TBCD octets
+//  u_int length: The number of TBCD octets
+//  char* string: The string into which to write the digits, it is always terminated
+//  u_int size: The size of the string, digits that do not fit are dropped
+//
+// Return:
+//  int: The number of digits written
+//
+int tbcd2str(const u_char* tbcd, u_int length, char* string, u_int size);
+
+//
+// This function converts a TBCD string of decimal digits to a number, the digits stop at the first filler
+//
+// Parameters:
+//  const u_char* tbcd: The TBCD octets
+//  u_int length: The number of TBCD octets
+//  unsigned long long* number: The number is returned here
+//
+// Return:
+//  int: The number of digits converted, -1 if there is a digit that is not decimal or more than 19 digits
+//
+int tbcd2longlong(const u_char* tbcd, u_int length, unsigned long long* number);
+
+//
+// This function converts the body of a GTP V1 MSISDN information element to a string of digits, skipping the
+// address octet. A GTP V2 MSISDN has no address octet and is converted with tbcd2str()
+//
+// Parameters:
+//  const u_char* body: The body of the information element
+//  u_int length: The length of the body
+//  char* string: The string into which to write the digits, it is always terminated
+//  u_int size: The size of the string, digits that do not fit are dropped
+//
+// Return:
+//  int: The number of digits written
+//
+int msisdn2str(const u_char* body, u_int length, char* string, u_int size);
+
+#endif /* TBCD_H_ */
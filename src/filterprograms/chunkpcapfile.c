@@ -13,48 +13,242 @@
 * Author: LMI/LXR/SH Liam Fallon
 ************************************************************************/
 
+/**
+ * This program splits a PCAP file into chunk files. By default the chunks are cut one after the other when they reach
+ * a maximum size. The packets can instead be split by packet time period or by a hash of their TEID, of the addresses
+ * of the tunnelled packet or of their 5-tuple, so that each chunk file can be processed on its own. Splitting runs as
+ * a reader that sorts the packets into batches for a set of writer threads, each of which owns its own chunk files and
+ * keeps a bounded number of them open with large write buffers
+ */
+
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
 #include <pcap/pcap.h>
 #include <netinet/ip.h>
 #include <arpa/inet.h>
 
+#include <gtpv1.h>
+#include <gtpv1_context.h>
+#include <gtp_classify.h>
+#include <gtp_ie_iterator.h>
 #include <pcapdefines.h>
 #include <pcapsession.h>
 
-// Constants
-#define MIN_CHUNK_SIZE 0x100000
+// The ways packets are split over chunk files
+#define CHUNK_SPLIT_SIZE 0  // Into consecutive chunks of a maximum size
+#define CHUNK_SPLIT_TIME 1  // By the period of time each packet falls in
+#define CHUNK_SPLIT_TEID 2  // By a hash of the TEID of GTP packets
+#define CHUNK_SPLIT_UE   3  // By a hash of the addresses of the tunnelled packet of G-PDUs
+#define CHUNK_SPLIT_FLOW 4  // By a hash of the 5-tuple of the tunnelled packet of G-PDUs
+
+// The size of a batch of packets passed from the reader to a writer and the number of batches of each writer
+#define CHUNK_BATCH_SIZE 0x100000
+#define CHUNK_BATCHES_PER_WRITER 4
+
+// The largest number of writer threads and of hashed chunk files
+#define CHUNK_MAX_WRITERS 64
+#define CHUNK_MAX_FILES 0x10000
+
+// The defaults for the number of chunk files open at once and the size of their write buffers
+#define CHUNK_DEFAULT_OPEN_FILES 64
+#define CHUNK_DEFAULT_BUFFER_SIZE 0x100000
+
+// The magic number and version of the PCAP files written when splitting
+#define CHUNK_MAGIC 0xa1b2c3d4
+#define CHUNK_VERSION_MAJOR 2
+#define CHUNK_VERSION_MINOR 4
+
+// The size of the time stamp in the names of the chunk files of periods
+#define CHUNK_TIME_SIZE 32
+
+//
+// A batch of packets, each is its chunk file number, its record header and its data
+//
+struct chunk_batch {
+	size_t length;        // The number of octets of packets in the batch
+	unsigned char* data;  // The packets
+};
+
+//
+// The header of a packet in a batch
+//
+struct chunk_record {
+	unsigned long output;                                            // The number of the chunk file
+	uint32_t header[PCAP_RECORD_HEADER_SIZE / sizeof(uint32_t)];    // The record header as it is written
+};
+
+//
+// A chunk file open for writing
+//
+struct chunk_output {
+	unsigned long output;  // The number of the chunk file
+	FILE* file;            // The chunk file
+	char* buffer;          // The write buffer of the chunk file
+	unsigned long used;    // The count of packets written by the writer when the file was last written to
+};
+
+//
+// A writer thread, the batches are a ring filled by the reader and emptied by the writer
+//
+struct chunk_writer {
+	pthread_t thread;
+	struct chunk_batch batches[CHUNK_BATCHES_PER_WRITER];
+	unsigned int fill;                  // The batch being filled, only used by the reader
+	unsigned int head;                  // The next batch to write, only used by the writer
+	unsigned int count;                 // The number of batches handed to the writer and not yet written
+	pthread_cond_t batch_ready;         // Signalled when a batch is handed to the writer or reading ends
+	pthread_cond_t batch_free;          // Signalled when the writer has written a batch
+	struct chunk_output* outputs;       // The chunk files open for writing
+	unsigned int output_count;          // The number of chunk files open
+	struct chunk_output* last_output;   // The chunk file last written to
+	unsigned long* created;             // The numbers of the chunk files created, in ascending order
+	size_t created_count;
+	size_t created_size;
+	unsigned long packets;              // The number of packets written
+};
 
 // Define PCAP handles
 pcap_t* pcap_handle = NULL;
-pcap_dumper_t* pcap_dumper = NULL;
 
-// Variables for chunk handling
-unsigned long chunk_max_size = 0;  // Maximum chunk size in a PCAP file
-unsigned long chunk_no       = 0;  // Current chunk number
-unsigned long chunk_used     = 0;  // Amount of data output on current chunk
+// The link layer type of the input file
+int pcap_linktype = DLT_EN10MB;
+
+// The chunk files being written
+pcapsession_chunker_t chunker;
+
+// The intervals between time index entries, no time index is written if both are 0
+unsigned long index_records = 0;
+unsigned long index_msec = 0;
+
+// How packets are split and into how many files or periods of how many seconds
+int split_mode = CHUNK_SPLIT_SIZE;
+unsigned long file_count = 0;
+unsigned long period = 0;
 
-// Variables for file handling
-char* out_file_name = NULL;
+// The writer threads, the number of chunk files each keeps open and the size of their write buffers
+struct chunk_writer writers[CHUNK_MAX_WRITERS];
+long writer_count = 0;
+unsigned long open_files = CHUNK_DEFAULT_OPEN_FILES;
+unsigned long open_files_per_writer = 0;
+unsigned long buffer_size = CHUNK_DEFAULT_BUFFER_SIZE;
+
+// The name the chunk files are named after
+char* out_file = NULL;
+
+// The lock that the reader and the writers synchronise on, reading_done is set when all packets are handed over and
+// split_failed is set if a chunk file could not be written
+pthread_mutex_t chunk_mutex = PTHREAD_MUTEX_INITIALIZER;
+int reading_done = 0;
+int split_failed = 0;
 
 // Forward references for private functions
 void pcap_packet_handler(unsigned char* pcap_param, const struct pcap_pkthdr* header, const unsigned char* data);
+void pcap_split_handler(unsigned char* pcap_param, const struct pcap_pkthdr* header, const unsigned char* data);
+int chunk_split(void);
+unsigned long chunk_output_of(const struct pcap_pkthdr* header, const unsigned char* data);
+void chunk_submit(struct chunk_writer* writer);
+void* chunk_write_thread(void* argument);
+void chunk_write_batch(struct chunk_writer* writer, const struct chunk_batch* batch);
+struct chunk_output* chunk_open_output(struct chunk_writer* writer, unsigned long output);
+int chunk_close_output(struct chunk_output* chunk_output);
+int chunk_created(struct chunk_writer* writer, unsigned long output, int add);
+void chunk_file_name(unsigned long output, char* file_name);
 
 int main(int argc, char** argv) {
+	int usage = 0;
+	writer_count = sysconf(_SC_NPROCESSORS_ONLN);
+
 	// Check arguments
-	if (argc != 4) {
-		fprintf(stderr, "usage: %s in_file out_file_name chunk_max_size\n", argv[0]);
+	int opt;
+	while ((opt = getopt(argc, argv, "i:m:t:s:n:j:o:w:")) != -1) {
+		switch (opt) {
+		case 'i':
+			index_records = atol(optarg);
+			break;
+		case 'm':
+			index_msec = atol(optarg);
+			break;
+		case 't':
+			split_mode = CHUNK_SPLIT_TIME;
+			period = atol(optarg);
+			usage |= period == 0;
+			break;
+		case 's':
+			if (!strcmp(optarg, "teid")) {
+				split_mode = CHUNK_SPLIT_TEID;
+			}
+			else if (!strcmp(optarg, "ue")) {
+				split_mode = CHUNK_SPLIT_UE;
+			}
+			else if (!strcmp(optarg, "flow")) {
+				split_mode = CHUNK_SPLIT_FLOW;
+			}
+			else {
+				usage = 1;
+			}
+			break;
+		case 'n':
+			file_count = atol(optarg);
+			usage |= file_count < 1 || file_count > CHUNK_MAX_FILES;
+			break;
+		case 'j':
+			writer_count = atol(optarg);
+			usage |= writer_count < 1;
+			break;
+		case 'o':
+			open_files = atol(optarg);
+			usage |= open_files < 1;
+			break;
+		case 'w':
+			buffer_size = atol(optarg);
+			usage |= buffer_size < BUFSIZ;
+			break;
+		default:
+			usage = 1;
+			break;
+		}
+	}
+
+	// Sizes are only given when chunking by size, the number of files only when hashing
+	int hashed = split_mode != CHUNK_SPLIT_SIZE && split_mode != CHUNK_SPLIT_TIME;
+	if (split_mode == CHUNK_SPLIT_SIZE) {
+		usage |= argc - optind != 3;
+	}
+	else {
+		usage |= argc - optind != 2 || index_records != 0 || index_msec != 0;
+	}
+	usage |= hashed != (file_count != 0);
+
+	if (usage) {
+		fprintf(stderr, "usage: %s [-i index_records] [-m index_msec] in_file out_file_name chunk_max_size\n", argv[0]);
+		fprintf(stderr, "       %s -t period [-j writers] [-o open_files] [-w buffer_size] in_file out_file_name\n", argv[0]);
+		fprintf(stderr, "       %s -s teid|ue|flow -n files [-j writers] [-o open_files] [-w buffer_size] in_file out_file_name\n", argv[0]);
 		fprintf(stderr, "  if in_file is specified as -, then standard input is used\n");
 		fprintf(stderr, "  chunk_max_size is the maximum size of an output PCAP file\n");
+		fprintf(stderr, "  -i and -m write a time index file %s next to each chunk file with an entry at least every\n", PCAP_INDEX_FILE_TYPE);
+		fprintf(stderr, "  index_records records and every index_msec milliseconds\n");
+		fprintf(stderr, "  -t splits the packets into files out_file_name_YYYYMMDD_HHMMSS.pcap of period seconds each\n");
+		fprintf(stderr, "  -s splits the packets into files out_file_name_NNNNNN.pcap by a hash of the TEID, of the addresses\n");
+		fprintf(stderr, "  or of the 5-tuple of the packet tunnelled in G-PDUs, at most %d files, other packets are hashed on their\n", CHUNK_MAX_FILES);
+		fprintf(stderr, "  own addresses and 5-tuple and packets without a TEID go to file 0, both directions go to the same file\n");
+		fprintf(stderr, "  -j writes the files on this many threads, the default is the number of processors, at most %d\n", CHUNK_MAX_WRITERS);
+		fprintf(stderr, "  -o keeps at most this many files open at once, the default is %d\n", CHUNK_DEFAULT_OPEN_FILES);
+		fprintf(stderr, "  -w is the size of the write buffer of each open file, the default is %d\n", CHUNK_DEFAULT_BUFFER_SIZE);
 		return 2;
 	}
 
+	char* in_file = argv[optind];
+	out_file = argv[optind + 1];
+
 	// Save arguments
-	out_file_name = argv[2];
-	chunk_max_size = atol(argv[3]);
+	unsigned long chunk_max_size = split_mode == CHUNK_SPLIT_SIZE ? atol(argv[optind + 2]) : 0;
 
 	// check chunk size
-	if (chunk_max_size < MIN_CHUNK_SIZE) {
-		fprintf(stderr, "  chunk_max_size must be at least %d\n", MIN_CHUNK_SIZE);
+	if (split_mode == CHUNK_SPLIT_SIZE && chunk_max_size < PCAP_MIN_CHUNK_SIZE) {
+		fprintf(stderr, "  chunk_max_size must be at least %d\n", PCAP_MIN_CHUNK_SIZE);
 		return 3;
 
 	}
@@ -63,19 +257,32 @@ int main(int argc, char** argv) {
 
 	// Open PCAP file input from standard input
 	char pcap_errbuf[PCAP_ERRBUF_SIZE];
-	pcap_handle = pcap_open_offline(argv[1], pcap_errbuf);
+	pcap_handle = pcap_open_offline(in_file, pcap_errbuf);
 	if (pcap_handle == NULL) {
-		fprintf(stderr, "capture start failed on file %s: %s\n", argv[1], pcap_errbuf);
+		fprintf(stderr, "capture start failed on file %s: %s\n", in_file, pcap_errbuf);
 		return 4;
 	}
+	pcap_linktype = pcap_datalink(pcap_handle);
+
+	if (split_mode != CHUNK_SPLIT_SIZE) {
+		int split = chunk_split();
+		pcap_close(pcap_handle);
+		if (!split) {
+			return 1;
+		}
+
+		fprintf(stderr, "completed chunking\n");
+		return 0;
+	}
+
+	pcapsession_chunker_init(&chunker, pcap_handle, out_file, chunk_max_size);
+	pcapsession_chunker_index(&chunker, index_records, index_msec);
 
 	// Handle the PCAP file packets
 	pcap_loop(pcap_handle, PCAP_INFINITE, pcap_packet_handler, NULL);
 
 	// Close dumper if open
-	if (pcap_dumper != NULL) {
-		pcap_dump_close(pcap_dumper);
-	}
+	pcapsession_chunker_close(&chunker);
 
 	// Close pcap
 	pcap_close(pcap_handle);
@@ -93,35 +300,525 @@ int main(int argc, char** argv) {
 //
 void pcap_packet_handler(unsigned char* pcap_param, const struct pcap_pkthdr* header, const unsigned char* data)
 {
-	// Check if we need to close the current dumper
-	if ((chunk_used + sizeof(struct pcap_pkthdr) + header->caplen) > chunk_max_size) {
-		// Close dumping
-		pcap_dump_close(pcap_dumper);
-		pcap_dumper = NULL;
-		chunk_used = 0;
+	// Dump the packet, opening the next chunk file if it does not fit in the current one
+	int started = pcapsession_chunker_dump(&chunker, header, data);
+	if (started < 0) {
+		pcap_close(pcap_handle);
+		fprintf(stderr, "dump start failed on file %s\n", chunker.chunk_file_name);
+		exit(1);
+	}
+	else if (started) {
+		fprintf(stderr, "dumping to %s . . .\n", chunker.chunk_file_name);
+		if ((index_records != 0 || index_msec != 0) && chunker.indexer.index_file == NULL) {
+			fprintf(stderr, "index start failed on file %s%s\n", chunker.chunk_file_name, PCAP_INDEX_FILE_TYPE);
+		}
+	}
+}
+
+//
+// This function splits the packets of the input file over the chunk files by period or by hash. The writer threads
+// are started, the packets are read and handed to the writers in batches and the writers are waited for
+//
+// Return:
+//  int: 1 if all chunk files were written, 0 otherwise
+//
+int chunk_split(void)
+{
+	if (writer_count > CHUNK_MAX_WRITERS) {
+		writer_count = CHUNK_MAX_WRITERS;
+	}
+	if (split_mode != CHUNK_SPLIT_TIME && (unsigned long)writer_count > file_count) {
+		writer_count = file_count;
+	}
+
+	// Each writer keeps its share of the open files, at least one
+	open_files_per_writer = open_files / writer_count;
+	if (open_files_per_writer == 0) {
+		open_files_per_writer = 1;
 	}
 
-	// Check if we need to open the dumper
-	if (pcap_dumper == NULL) {
-		// Generate the chunk file name
-		char chunk_dump_file[FILENAME_MAX];
-		sprintf(chunk_dump_file, "%s_%06lu.pcap", out_file_name, chunk_no++);
+	for (int i = 0; i < writer_count; i++) {
+		struct chunk_writer* writer = &writers[i];
+		memset(writer, 0, sizeof(struct chunk_writer));
+		pthread_cond_init(&writer->batch_ready, NULL);
+		pthread_cond_init(&writer->batch_free, NULL);
 
-		// Open the dump
-		pcap_dumper = pcap_dump_open(pcap_handle, chunk_dump_file);
-		if (pcap_dumper == NULL) {
-			pcap_close(pcap_handle);
-			fprintf(stderr, "dump start failed on file %s\n", out_file_name);
-			exit(1);
+		writer->outputs = calloc(open_files_per_writer, sizeof(struct chunk_output));
+		if (writer->outputs == NULL) {
+			fprintf(stderr, "could not allocate the open files of %ld writers\n", writer_count);
+			return 0;
 		}
-		fprintf(stderr, "dumping to %s . . .\n", chunk_dump_file);
+
+		for (int j = 0; j < CHUNK_BATCHES_PER_WRITER; j++) {
+			writer->batches[j].data = malloc(CHUNK_BATCH_SIZE);
+			if (writer->batches[j].data == NULL) {
+				fprintf(stderr, "could not allocate the batches of %ld writers\n", writer_count);
+				return 0;
+			}
+		}
+	}
+
+	// Split on the writers that start, packets are spread over the writers by the number of writers
+	long started = 0;
+	while (started < writer_count && pthread_create(&writers[started].thread, NULL, chunk_write_thread, &writers[started]) == 0) {
+		started++;
+	}
+	if (started < writer_count) {
+		fprintf(stderr, "could only start %ld of %ld writers\n", started, writer_count);
+		for (int i = started; i < writer_count; i++) {
+			struct chunk_writer* writer = &writers[i];
+			for (int j = 0; j < CHUNK_BATCHES_PER_WRITER; j++) {
+				free(writer->batches[j].data);
+			}
+			free(writer->outputs);
+			pthread_cond_destroy(&writer->batch_ready);
+			pthread_cond_destroy(&writer->batch_free);
+		}
+		writer_count = started;
+	}
+	if (writer_count == 0) {
+		return 0;
 	}
 
-	// Dump the packet
-	pcap_dump((unsigned char*)pcap_dumper, header, data);
+	fprintf(stderr, "splitting on %ld writers\n", writer_count);
 
-	// Increment chunks used
-	chunk_used += sizeof(struct pcap_pkthdr) + header->caplen;
+	// Handle the PCAP file packets
+	pcap_loop(pcap_handle, PCAP_INFINITE, pcap_split_handler, NULL);
+
+	// Hand over the batches that are partly filled and tell the writers that reading is done
+	pthread_mutex_lock(&chunk_mutex);
+	for (int i = 0; i < writer_count; i++) {
+		struct chunk_writer* writer = &writers[i];
+		if (writer->batches[writer->fill].length != 0) {
+			writer->count++;
+		}
+	}
+	reading_done = 1;
+	for (int i = 0; i < writer_count; i++) {
+		pthread_cond_signal(&writers[i].batch_ready);
+	}
+	pthread_mutex_unlock(&chunk_mutex);
+
+	unsigned long packets = 0;
+	for (int i = 0; i < writer_count; i++) {
+		struct chunk_writer* writer = &writers[i];
+		pthread_join(writer->thread, NULL);
+		packets += writer->packets;
+
+		for (int j = 0; j < CHUNK_BATCHES_PER_WRITER; j++) {
+			free(writer->batches[j].data);
+		}
+		for (unsigned long j = 0; j < open_files_per_writer; j++) {
+			free(writer->outputs[j].buffer);
+		}
+		free(writer->outputs);
+		free(writer->created);
+		pthread_cond_destroy(&writer->batch_ready);
+		pthread_cond_destroy(&writer->batch_free);
+	}
+
+	fprintf(stderr, "split %lu packets\n", packets);
+	return !split_failed;
 }
 
+//
+// This function is a PCAP packet handler callback method for packets when splitting, it adds the packet to the batch
+// of the writer of its chunk file
+//
+// Parameters:
+//  unsigned char* pcap_param: A pointer to user data set in the pcap_loop call, in this case it is not used
+//  const struct pcap_pkthdr* header: A pointer to the header of the packet
+//  const unsigned char* data: A pointer to the packet data
+//
+void pcap_split_handler(unsigned char* pcap_param, const struct pcap_pkthdr* header, const unsigned char* data)
+{
+	struct chunk_record record;
+	record.output = chunk_output_of(header, data);
+	record.header[0] = header->ts.tv_sec;
+	record.header[1] = header->ts.tv_usec;
+	record.header[2] = header->caplen;
+	record.header[3] = header->len;
+
+	// Hand the batch over if the packet does not fit in it
+	struct chunk_writer* writer = &writers[record.output % writer_count];
+	struct chunk_batch* batch = &writer->batches[writer->fill];
+	if (batch->length + sizeof(struct chunk_record) + header->caplen > CHUNK_BATCH_SIZE) {
+		chunk_submit(writer);
+		batch = &writer->batches[writer->fill];
+	}
+
+	memcpy(batch->data + batch->length, &record, sizeof(struct chunk_record));
+	memcpy(batch->data + batch->length + sizeof(struct chunk_record), data, header->caplen);
+	batch->length += sizeof(struct chunk_record) + header->caplen;
+}
 
+//
+// This function works out which chunk file a packet goes to. A packet goes to the period its time stamp falls in or
+// to the hash of its TEID, of its addresses or of its 5-tuple modulo the number of files. The addresses and 5-tuple
+// are those of the packet tunnelled in a G-PDU or, for other packets, of the outermost IPv4 packet, and are hashed
+// so that both directions of the traffic go to the same file
+//
+// Parameters:
+//  const struct pcap_pkthdr* header: A pointer to the header of the packet
+//  const unsigned char* data: A pointer to the packet data
+//
+// Return:
+//  unsigned long: The number of the chunk file
+//
+unsigned long chunk_output_of(const struct pcap_pkthdr* header, const unsigned char* data)
+{
+	if (split_mode == CHUNK_SPLIT_TIME) {
+		return (uint32_t)header->ts.tv_sec / period;
+	}
+
+	struct gtp_class packet_class;
+	int type = gtp_classify_packet(pcap_linktype, header->caplen, data, &packet_class);
+
+	if (split_mode == CHUNK_SPLIT_TEID) {
+		if (type == GTP_CLASS_NONE) {
+			return 0;
+		}
+
+		return gtpv1_context_hash(gtp_ie_read32(data + packet_class.gtp_offset + 4), 0) % file_count;
+	}
+
+	// Find the tunnelled IPv4 packet of a G-PDU or else the outermost one
+	u_int ip = 0;
+	if (type != GTP_CLASS_NONE && type != GTP_CLASS_C && packet_class.payload_offset != 0 &&
+			packet_class.payload_offset + sizeof(struct ip) <= header->caplen && (data[packet_class.payload_offset] >> 4) == IPVERSION) {
+		ip = packet_class.payload_offset;
+	}
+	else if (type != GTP_CLASS_NONE) {
+		ip = packet_class.ip_offset;
+	}
+	else {
+		ip = gtp_classify_locate_ip(pcap_linktype, header->caplen, data, &packet_class);
+		if (ip == 0) {
+			return 0;
+		}
+	}
+
+	// The packet data need not be aligned so the headers are read an octet at a time
+	u_int low = gtp_ie_read32(data + ip + 12);
+	u_int high = gtp_ie_read32(data + ip + 16);
+	if (low > high) {
+		u_int swap = low;
+		low = high;
+		high = swap;
+	}
+
+	u_int hash = gtpv1_context_hash(low, high);
+	if (split_mode == CHUNK_SPLIT_UE) {
+		return hash % file_count;
+	}
+
+	// The ports are only hashed for unfragmented TCP and UDP packets or first fragments
+	u_int protocol = data[ip + 9];
+	u_int transport = ip + (data[ip] & 0x0f) * 4;
+	if ((protocol == IPPROTO_TCP || protocol == IPPROTO_UDP) && ((data[ip + 6] << 8 | data[ip + 7]) & IP_OFFMASK) == 0 &&
+			transport + 4 <= header->caplen) {
+		u_int low_port = data[transport] << 8 | data[transport + 1];
+		u_int high_port = data[transport + 2] << 8 | data[transport + 3];
+		if (low_port > high_port) {
+			u_int swap = low_port;
+			low_port = high_port;
+			high_port = swap;
+		}
+		hash ^= gtpv1_context_hash(low_port << 16 | high_port, protocol);
+	}
+	else {
+		hash ^= gtpv1_context_hash(0, protocol);
+	}
+
+	return hash % file_count;
+}
+
+//
+// This function hands the batch being filled to its writer and waits for the next batch to be free
+//
+// Parameters:
+//  struct chunk_writer* writer: The writer
+//
+void chunk_submit(struct chunk_writer* writer)
+{
+	pthread_mutex_lock(&chunk_mutex);
+	writer->count++;
+	pthread_cond_signal(&writer->batch_ready);
+
+	while (writer->count == CHUNK_BATCHES_PER_WRITER) {
+		pthread_cond_wait(&writer->batch_free, &chunk_mutex);
+	}
+
+	// Stop reading once a chunk file could not be written
+	if (split_failed) {
+		pcap_breakloop(pcap_handle);
+	}
+	pthread_mutex_unlock(&chunk_mutex);
+
+	writer->fill = (writer->fill + 1) % CHUNK_BATCHES_PER_WRITER;
+	writer->batches[writer->fill].length = 0;
+}
+
+//
+// This function is the body of a writer thread, it writes the batches handed to it until reading is done and then
+// closes its chunk files
+//
+// Parameters:
+//  void* argument: The writer
+//
+// Return:
+//  void*: NULL
+//
+void* chunk_write_thread(void* argument)
+{
+	struct chunk_writer* writer = argument;
+
+	pthread_mutex_lock(&chunk_mutex);
+	while (1) {
+		while (writer->count == 0 && !reading_done) {
+			pthread_cond_wait(&writer->batch_ready, &chunk_mutex);
+		}
+		if (writer->count == 0) {
+			break;
+		}
+		int failed = split_failed;
+		pthread_mutex_unlock(&chunk_mutex);
+
+		// Once a chunk file could not be written the batches are only emptied
+		if (!failed) {
+			chunk_write_batch(writer, &writer->batches[writer->head]);
+		}
+
+		pthread_mutex_lock(&chunk_mutex);
+		writer->head = (writer->head + 1) % CHUNK_BATCHES_PER_WRITER;
+		writer->count--;
+		pthread_cond_signal(&writer->batch_free);
+	}
+	pthread_mutex_unlock(&chunk_mutex);
+
+	int closed = 1;
+	for (unsigned int i = 0; i < writer->output_count; i++) {
+		closed &= chunk_close_output(&writer->outputs[i]);
+	}
+
+	if (!closed) {
+		pthread_mutex_lock(&chunk_mutex);
+		split_failed = 1;
+		pthread_mutex_unlock(&chunk_mutex);
+	}
+
+	return NULL;
+}
+
+//
+// This function writes the packets of a batch to their chunk files
+//
+// Parameters:
+//  struct chunk_writer* writer: The writer
+//  const struct chunk_batch* batch: The batch
+//
+void chunk_write_batch(struct chunk_writer* writer, const struct chunk_batch* batch)
+{
+	size_t position = 0;
+	while (position < batch->length) {
+		struct chunk_record record;
+		memcpy(&record, batch->data + position, sizeof(struct chunk_record));
+		position += sizeof(struct chunk_record);
+
+		struct chunk_output* chunk_output = chunk_open_output(writer, record.output);
+		if (chunk_output == NULL) {
+			pthread_mutex_lock(&chunk_mutex);
+			split_failed = 1;
+			pthread_mutex_unlock(&chunk_mutex);
+			return;
+		}
+
+		// Each chunk file is only written by its writer so the stream need not be locked
+		fwrite_unlocked(record.header, PCAP_RECORD_HEADER_SIZE, 1, chunk_output->file);
+		fwrite_unlocked(batch->data + position, record.header[2], 1, chunk_output->file);
+		position += record.header[2];
+
+		chunk_output->used = ++writer->packets;
+	}
+}
+
+//
+// This function finds the open chunk file with a given number, opening it if it is not open. When the writer already
+// has its share of files open the one least recently written to is closed first. A chunk file is created the first
+// time it is opened and appended to after that
+//
+// Parameters:
+//  struct chunk_writer* writer: The writer
+//  unsigned long output: The number of the chunk file
+//
+// Return:
+//  struct chunk_output*: The open chunk file, NULL if it could not be opened
+//
+struct chunk_output* chunk_open_output(struct chunk_writer* writer, unsigned long output)
+{
+	if (writer->last_output != NULL && writer->last_output->output == output) {
+		return writer->last_output;
+	}
+
+	struct chunk_output* chunk_output = NULL;
+	for (unsigned int i = 0; i < writer->output_count; i++) {
+		if (writer->outputs[i].output == output) {
+			writer->last_output = &writer->outputs[i];
+			return writer->last_output;
+		}
+
+		if (chunk_output == NULL || writer->outputs[i].used < chunk_output->used) {
+			chunk_output = &writer->outputs[i];
+		}
+	}
+
+	// Use a free slot or close the file least recently written to
+	if (writer->output_count < open_files_per_writer) {
+		chunk_output = &writer->outputs[writer->output_count++];
+	}
+	else if (!chunk_close_output(chunk_output)) {
+		return NULL;
+	}
+
+	if (chunk_output->buffer == NULL) {
+		chunk_output->buffer = malloc(buffer_size);
+		if (chunk_output->buffer == NULL) {
+			fprintf(stderr, "could not allocate a write buffer of %lu octets\n", buffer_size);
+			return NULL;
+		}
+	}
+
+	char file_name[FILENAME_MAX];
+	chunk_file_name(output, file_name);
+
+	int created = chunk_created(writer, output, 0);
+	chunk_output->file = fopen(file_name, created ? "a" : "w");
+	if (chunk_output->file == NULL || chunk_created(writer, output, 1) < 0) {
+		fprintf(stderr, "dump start failed on file %s\n", file_name);
+		if (chunk_output->file != NULL) {
+			fclose(chunk_output->file);
+			chunk_output->file = NULL;
+		}
+		return NULL;
+	}
+	setvbuf(chunk_output->file, chunk_output->buffer, _IOFBF, buffer_size);
+	chunk_output->output = output;
+	writer->last_output = chunk_output;
+
+	if (!created) {
+		struct pcap_file_header file_header;
+		memset(&file_header, 0, sizeof(struct pcap_file_header));
+		file_header.magic = CHUNK_MAGIC;
+		file_header.version_major = CHUNK_VERSION_MAJOR;
+		file_header.version_minor = CHUNK_VERSION_MINOR;
+		file_header.snaplen = pcap_snapshot(pcap_handle);
+		file_header.linktype = pcap_linktype;
+		fwrite_unlocked(&file_header, sizeof(struct pcap_file_header), 1, chunk_output->file);
+
+		fprintf(stderr, "dumping to %s . . .\n", file_name);
+	}
+
+	return chunk_output;
+}
+
+//
+// This function closes an open chunk file, writing out its buffer
+//
+// Parameters:
+//  struct chunk_output* chunk_output: The open chunk file, nothing is done if it is not open
+//
+// Return:
+//  int: 1 if the chunk file was written and closed, 0 otherwise
+//
+int chunk_close_output(struct chunk_output* chunk_output)
+{
+	if (chunk_output->file == NULL) {
+		return 1;
+	}
+
+	int error = ferror(chunk_output->file);
+	error |= fclose(chunk_output->file) != 0;
+	chunk_output->file = NULL;
+
+	if (error) {
+		char file_name[FILENAME_MAX];
+		chunk_file_name(chunk_output->output, file_name);
+		fprintf(stderr, "dump failed on file %s\n", file_name);
+		return 0;
+	}
+
+	return 1;
+}
+
+//
+// This function checks whether a writer has created a chunk file and optionally records that it has
+//
+// Parameters:
+//  struct chunk_writer* writer: The writer
+//  unsigned long output: The number of the chunk file
+//  int add: 1 to record that the chunk file is created, 0 to only check
+//
+// Return:
+//  int: 1 if the chunk file was already created, 0 if not, -1 if it could not be recorded
+//
+int chunk_created(struct chunk_writer* writer, unsigned long output, int add)
+{
+	// Find where the number is or would be in the ascending list
+	size_t low = 0;
+	size_t high = writer->created_count;
+	while (low < high) {
+		size_t middle = (low + high) / 2;
+		if (writer->created[middle] < output) {
+			low = middle + 1;
+		}
+		else {
+			high = middle;
+		}
+	}
+
+	if (low < writer->created_count && writer->created[low] == output) {
+		return 1;
+	}
+	if (!add) {
+		return 0;
+	}
+
+	if (writer->created_count == writer->created_size) {
+		size_t created_size = writer->created_size ? writer->created_size * 2 : 64;
+		unsigned long* created = realloc(writer->created, created_size * sizeof(unsigned long));
+		if (created == NULL) {
+			return -1;
+		}
+		writer->created = created;
+		writer->created_size = created_size;
+	}
+
+	memmove(&writer->created[low + 1], &writer->created[low], (writer->created_count - low) * sizeof(unsigned long));
+	writer->created[low] = output;
+	writer->created_count++;
+
+	return 0;
+}
+
+//
+// This function gives the name of a chunk file, files of periods are named after the UTC start of their period and
+// hashed files after their number
+//
+// Parameters:
+//  unsigned long output: The number of the chunk file
+//  char* file_name: The name is returned here, it must have room for FILENAME_MAX characters
+//
+void chunk_file_name(unsigned long output, char* file_name)
+{
+	if (split_mode != CHUNK_SPLIT_TIME) {
+		snprintf(file_name, FILENAME_MAX, "%s_%06lu%s", out_file, output, PCAP_FILE_TYPE);
+		return;
+	}
+
+	time_t start = output * period;
+	struct tm start_tm;
+	char start_string[CHUNK_TIME_SIZE];
+	gmtime_r(&start, &start_tm);
+	strftime(start_string, CHUNK_TIME_SIZE, "%Y%m%d_%H%M%S", &start_tm);
+	snprintf(file_name, FILENAME_MAX, "%s_%s%s", out_file, start_string, PCAP_FILE_TYPE);
+}
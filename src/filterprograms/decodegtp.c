@@ -13,10 +13,28 @@
  * Author: LMI/LXR/SH Liam Fallon
  ************************************************************************/
 
+/**
+ * This program decodes the GTP V1 packets of a PCAP file as comma separated text, or with -b as blocks of binary
+ * columns that can be loaded without parsing. The columnar output starts with a schema header giving the name, type
+ * and width of each column, each block then holds the values of each column in turn for up to DECODE_BLOCK_ROWS rows.
+ * Large capture files are split into chunks that start on record boundaries, the chunks are decoded in parallel into
+ * buffers and the buffers are written in the order of the chunks so that the output is the same as that of decoding
+ * the file serially. The start of a chunk is found by scanning for an offset at which a run of record headers chain
+ * correctly, if the chunks do not join up or a record is not one libpcap would read as is, the rest of the file is
+ * decoded serially by libpcap
+ */
+
+#include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <string.h>
+#include <time.h>
+#include <fcntl.h>
 #include <pthread.h>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <arpa/inet.h>
 #include <net/ethernet.h>
 #include <netinet/ip.h>
@@ -24,178 +42,1112 @@
 #include <pcap/pcap.h>
 
 #include <gtpv1.h>
+#include <gtp_ie_iterator.h>
+#include <tbcd.h>
 #include <pcapsession.h>
 
+// The amount of text buffered before it is written when decoding serially
+#define DECODE_FLUSH_SIZE 0x10000
+
+// The nominal size of a chunk of the capture file decoded by a thread
+#define DECODE_CHUNK_SIZE 0x1000000
+
+// The number of chunk buffers per thread, threads may run this far ahead of the chunk being written
+#define DECODE_CHUNKS_PER_THREAD 4
+
+// The largest number of decoding threads
+#define DECODE_MAX_THREADS 64
+
+// The number of consecutive record headers that must chain correctly for an offset to be taken as a record boundary
+#define DECODE_RESYNC_RECORDS 8
+
+// The sizes of the headers of a PCAP file and of its records, the magic number and version that are split
+#define DECODE_FILE_HEADER_SIZE 24
+#define DECODE_RECORD_HEADER_SIZE 16
+#define DECODE_MAGIC 0xa1b2c3d4
+#define DECODE_VERSION_MAJOR 2
+#define DECODE_VERSION_MINOR 4
+
+// The link layer types whose records libpcap passes on unchanged
+#define DECODE_LINKTYPE_ETHERNET 1
+#define DECODE_LINKTYPE_LINUX_SLL 113
+
+// The size of the buffer a time stamp is converted to text in
+#define DECODE_TIME_SIZE 32
+
+// The classes of packets in the columnar output
+#define DECODE_CLASS_NOT_GTP 0
+#define DECODE_CLASS_GTP_C 1
+#define DECODE_CLASS_GTP_U 2
+
+// The bits of the present column, each is set if the field was found in the packet
+#define DECODE_PRESENT_OPTIONS 0x01       // The sequence number, N-PDU number and next extension header type
+#define DECODE_PRESENT_ADDRESSES 0x02     // The source and destination addresses of the tunnelled packet of a G-PDU
+#define DECODE_PRESENT_IMSI 0x04          // The IMSI of a GTP-C message
+#define DECODE_PRESENT_TEID_DATA 0x08     // The TEID data I of a GTP-C message
+#define DECODE_PRESENT_TEID_CONTROL 0x10  // The TEID control plane of a GTP-C message
+#define DECODE_PRESENT_EUA 0x20           // The IPv4 end user address of a GTP-C message
+
+// The schema header of the columnar output, the byte order mark is written in the byte order of the file
+#define DECODE_COLUMNS_MAGIC "GTPCOLS"
+#define DECODE_COLUMNS_VERSION 1
+#define DECODE_COLUMNS_BYTE_ORDER 0x01020304
+#define DECODE_COLUMN_NAME_SIZE 16
+
+// The number of rows in a block of the columnar output and the alignment of the blocks
+#define DECODE_BLOCK_ROWS 0x10000
+#define DECODE_BLOCK_ALIGNMENT 8
+
+// The types of columns
+#define DECODE_COLUMN_SIGNED 1    // A signed integer in the byte order of the file
+#define DECODE_COLUMN_UNSIGNED 2  // An unsigned integer in the byte order of the file
+#define DECODE_COLUMN_ADDRESS 3   // An IPv4 address in network byte order
+#define DECODE_COLUMN_DIGITS 4    // Decimal digits padded with NUL characters
+
+//
+// A buffer of decoded text or of decoded rows, the conversion of the last time stamp to text is kept with the buffer
+//
+struct decode_buffer {
+	char* data;                             // The text or rows
+	size_t length;                          // The length of the text or rows
+	size_t size;                            // The allocated size of the buffer
+	time_t time_seconds;                    // The time stamp last converted to text
+	size_t time_length;                     // The length of the text of the time stamp, 0 if none was converted
+	char time_string[DECODE_TIME_SIZE];     // The text of the time stamp
+};
+
+//
+// The fields of a packet decoded for the columnar output
+//
+struct decode_row {
+	int64_t timestamp;                      // The time stamp of the packet in microseconds since the epoch
+	char imsi[TBCD_IMSI_MAX_DIGITS + 1];    // The IMSI of a GTP-C message
+	uint32_t teid;                          // The TEID of the GTP header
+	uint32_t source;                        // The source address of the tunnelled packet of a G-PDU
+	uint32_t destination;                   // The destination address of the tunnelled packet of a G-PDU
+	uint32_t teid_data;                     // The TEID data I of a GTP-C message
+	uint32_t teid_control;                  // The TEID control plane of a GTP-C message
+	uint32_t eua;                           // The IPv4 end user address of a GTP-C message
+	uint16_t length;                        // The length of the GTP message
+	uint16_t sequence;                      // The sequence number of the GTP header
+	uint8_t packet_class;                   // The class of the packet, one of the DECODE_CLASS_ values
+	uint8_t flags;                          // The first octet of the GTP header, the version, type and option flags
+	uint8_t message_type;                   // The GTP message type
+	uint8_t npdu;                           // The N-PDU number of the GTP header
+	uint8_t next_type;                      // The type of the first extension header
+	uint8_t present;                        // The fields found in the packet, DECODE_PRESENT_ bits
+};
+
+//
+// A column of the columnar output and the field of a row it is taken from
+//
+struct decode_column {
+	const char* name;      // The name of the column
+	uint32_t type;         // The type of the column, one of the DECODE_COLUMN_ values
+	uint32_t width;        // The width of the column in octets
+	size_t offset;         // The offset of the field in a row
+};
+
+#define DECODE_COLUMN(name, type, field) {name, type, sizeof(((struct decode_row*)0)->field), offsetof(struct decode_row, field)}
+
+// The columns, ordered from the widest so that every column of a block is aligned to its width
+const struct decode_column columns[] = {
+	DECODE_COLUMN("timestamp", DECODE_COLUMN_SIGNED, timestamp),
+	DECODE_COLUMN("imsi", DECODE_COLUMN_DIGITS, imsi),
+	DECODE_COLUMN("teid", DECODE_COLUMN_UNSIGNED, teid),
+	DECODE_COLUMN("src", DECODE_COLUMN_ADDRESS, source),
+	DECODE_COLUMN("dest", DECODE_COLUMN_ADDRESS, destination),
+	DECODE_COLUMN("teid_data", DECODE_COLUMN_UNSIGNED, teid_data),
+	DECODE_COLUMN("teid_control", DECODE_COLUMN_UNSIGNED, teid_control),
+	DECODE_COLUMN("eua", DECODE_COLUMN_ADDRESS, eua),
+	DECODE_COLUMN("length", DECODE_COLUMN_UNSIGNED, length),
+	DECODE_COLUMN("seqno", DECODE_COLUMN_UNSIGNED, sequence),
+	DECODE_COLUMN("gtp", DECODE_COLUMN_UNSIGNED, packet_class),
+	DECODE_COLUMN("flags", DECODE_COLUMN_UNSIGNED, flags),
+	DECODE_COLUMN("msgtype", DECODE_COLUMN_UNSIGNED, message_type),
+	DECODE_COLUMN("npdu", DECODE_COLUMN_UNSIGNED, npdu),
+	DECODE_COLUMN("nexttype", DECODE_COLUMN_UNSIGNED, next_type),
+	DECODE_COLUMN("present", DECODE_COLUMN_UNSIGNED, present)
+};
+
+#define DECODE_COLUMN_COUNT (sizeof(columns) / sizeof(struct decode_column))
+
+//
+// The schema header at the start of the columnar output, it is followed by a description of each column
+//
+struct decode_schema {
+	char magic[8];             // DECODE_COLUMNS_MAGIC
+	uint32_t byte_order;       // DECODE_COLUMNS_BYTE_ORDER
+	uint32_t version;          // DECODE_COLUMNS_VERSION
+	uint32_t column_count;     // The number of columns
+	uint32_t block_rows;       // The largest number of rows in a block
+};
+
+//
+// The description of a column in the schema header
+//
+struct decode_schema_column {
+	char name[DECODE_COLUMN_NAME_SIZE];     // The name of the column padded with NUL characters
+	uint32_t type;                          // The type of the column, one of the DECODE_COLUMN_ values
+	uint32_t width;                         // The width of the column in octets
+};
+
+//
+// The header of a block of the columnar output, it is followed by the values of each column in turn for the rows of
+// the block and then padding to a multiple of DECODE_BLOCK_ALIGNMENT octets
+//
+struct decode_block {
+	uint32_t row_count;        // The number of rows in the block
+	uint32_t length;           // The length of the block after this header including padding
+};
+
+//
+// A chunk of the capture file and the text decoded from it
 //
-// This function decodes a GTP packet
+struct decode_chunk {
+	long number;                     // The number of the chunk in the file
+	off_t start;                     // The offset of the first record of the chunk, -1 if no boundary was found
+	off_t end;                       // The offset after the last record decoded
+	int irregular;                   // 1 if decoding stopped at a record that must be read by libpcap
+	int decoded;                     // 1 once the chunk is decoded and until it is written
+	struct decode_buffer output;     // The decoded text
+};
+
+// The memory mapped capture file
+const unsigned char* capture_data = NULL;
+off_t capture_size = 0;
+int capture_swapped = 0;
+unsigned int capture_snaplen = 0;
+
+// The link layer type of the input file
+int pcap_linktype = DLT_EN10MB;
+
+// The chunks of the capture file, chunk n is decoded into slot n % slot_count
+struct decode_chunk* slots = NULL;
+long slot_count = 0;
+long chunk_count = 0;
+
+// The next chunk to be decoded, the number of chunks written and whether decoding is to stop
+long next_chunk = 0;
+long chunks_written = 0;
+int decode_stop = 0;
+
+// The lock and conditions that the decoding threads and the writing thread synchronise on
+pthread_mutex_t decode_mutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t chunk_decoded = PTHREAD_COND_INITIALIZER;
+pthread_cond_t slot_free = PTHREAD_COND_INITIALIZER;
+
+// Set if the packets are written as binary columns instead of text
+int columnar = 0;
+
+// The values of each column for the block of the columnar output being filled
+char* block_columns[DECODE_COLUMN_COUNT];
+uint32_t block_row_count = 0;
+
+//
+// This function grows a buffer so that it has room for more octets
 //
 // Parameters:
-//  pcapsession_t*: Returns a pointer to the merger or NULL if opening failed
+//  struct decode_buffer* buffer: The buffer
+//  size_t length: The number of octets to make room for
+//
+void decode_grow(struct decode_buffer* buffer, size_t length)
+{
+	size_t size = buffer->size ? buffer->size : DECODE_FLUSH_SIZE;
+	while (size < buffer->length + length) {
+		size *= 2;
+	}
+
+	char* data = realloc(buffer->data, size);
+	if (data == NULL) {
+		fprintf(stderr, "decode failed: out of memory\n");
+		exit(3);
+	}
+	buffer->data = data;
+	buffer->size = size;
+}
+
+//
+// This function makes room for octets at the end of a buffer
+//
+// Parameters:
+//  struct decode_buffer* buffer: The buffer
+//  size_t length: The number of octets to make room for
+//
+// Return:
+//  char*: The end of the buffer where the octets are to be written, the length of the buffer is not changed
+//
+static inline char* decode_reserve(struct decode_buffer* buffer, size_t length)
+{
+	if (buffer->size - buffer->length < length) {
+		decode_grow(buffer, length);
+	}
+
+	return buffer->data + buffer->length;
+}
+
+//
+// This function appends text to a buffer
+//
+// Parameters:
+//  struct decode_buffer* buffer: The buffer
+//  const char* text: The text
+//  size_t length: The length of the text
+//
+static inline void decode_append(struct decode_buffer* buffer, const char* text, size_t length)
+{
+	memcpy(decode_reserve(buffer, length), text, length);
+	buffer->length += length;
+}
+
+// Appends a string literal to a buffer
+#define DECODE_APPEND_LITERAL(buffer, literal) decode_append((buffer), (literal), sizeof(literal) - 1)
+
+//
+// This function appends an unsigned integer to a buffer as decimal text
+//
+// Parameters:
+//  struct decode_buffer* buffer: The buffer
+//  uint32_t value: The integer
+//  int width: The smallest number of digits, the integer is padded with leading zeros to this width, at most 10
+//
+static inline void decode_append_decimal(struct decode_buffer* buffer, uint32_t value, int width)
+{
+	char digits[10];
+	int count = 0;
+
+	do {
+		digits[sizeof(digits) - ++count] = '0' + value % 10;
+		value /= 10;
+	} while (value != 0);
+
+	while (count < width) {
+		digits[sizeof(digits) - ++count] = '0';
+	}
+
+	decode_append(buffer, digits + sizeof(digits) - count, count);
+}
+
+//
+// This function appends an unsigned integer to a buffer as lower case hexadecimal text
+//
+// Parameters:
+//  struct decode_buffer* buffer: The buffer
+//  uint32_t value: The integer
+//
+static inline void decode_append_hex(struct decode_buffer* buffer, uint32_t value)
+{
+	static const char hex_digits[] = "0123456789abcdef";
+	char digits[8];
+	int count = 0;
+
+	do {
+		digits[sizeof(digits) - ++count] = hex_digits[value & 0x0f];
+		value >>= 4;
+	} while (value != 0);
+
+	decode_append(buffer, digits + sizeof(digits) - count, count);
+}
+
+//
+// This function appends an IPv4 address to a buffer in dotted decimal notation
+//
+// Parameters:
+//  struct decode_buffer* buffer: The buffer
+//  const u_char* address: The four octets of the address in network byte order
+//
+static inline void decode_append_address(struct decode_buffer* buffer, const u_char* address)
+{
+	char* text = decode_reserve(buffer, sizeof("255.255.255.255") - 1);
+	char* start = text;
+
+	for (int i = 0; i < 4; i++) {
+		u_int octet = address[i];
+
+		if (octet >= 100) {
+			*text++ = '0' + octet / 100;
+			octet %= 100;
+			*text++ = '0' + octet / 10;
+			octet %= 10;
+		}
+		else if (octet >= 10) {
+			*text++ = '0' + octet / 10;
+			octet %= 10;
+		}
+		*text++ = '0' + octet;
+
+		if (i < 3) {
+			*text++ = '.';
+		}
+	}
+
+	buffer->length += text - start;
+}
+
+//
+// This function appends a time stamp to a buffer as local time in the format of ctime() without the newline, the text
+// of the last time stamp is kept so packets in the same second are converted once
+//
+// Parameters:
+//  struct decode_buffer* buffer: The buffer
+//  time_t seconds: The time stamp
+//
+void decode_append_time(struct decode_buffer* buffer, time_t seconds)
+{
+	if (buffer->time_length == 0 || buffer->time_seconds != seconds) {
+		buffer->time_seconds = seconds;
+		if (ctime_r(&seconds, buffer->time_string) == NULL) {
+			buffer->time_string[0] = '\n';
+		}
+		buffer->time_length = strlen(buffer->time_string) - 1;
+	}
+
+	decode_append(buffer, buffer->time_string, buffer->time_length);
+}
+
+//
+// This function writes the schema header of the columnar output to standard output and allocates the columns of a block
+//
+void decode_write_schema(void)
+{
+	struct decode_schema schema;
+	memset(&schema, 0, sizeof(struct decode_schema));
+	memcpy(schema.magic, DECODE_COLUMNS_MAGIC, sizeof(DECODE_COLUMNS_MAGIC));
+	schema.byte_order = DECODE_COLUMNS_BYTE_ORDER;
+	schema.version = DECODE_COLUMNS_VERSION;
+	schema.column_count = DECODE_COLUMN_COUNT;
+	schema.block_rows = DECODE_BLOCK_ROWS;
+	fwrite(&schema, sizeof(struct decode_schema), 1, stdout);
+
+	for (size_t i = 0; i < DECODE_COLUMN_COUNT; i++) {
+		struct decode_schema_column column;
+		memset(&column, 0, sizeof(struct decode_schema_column));
+		strncpy(column.name, columns[i].name, DECODE_COLUMN_NAME_SIZE - 1);
+		column.type = columns[i].type;
+		column.width = columns[i].width;
+		fwrite(&column, sizeof(struct decode_schema_column), 1, stdout);
+
+		block_columns[i] = malloc(DECODE_BLOCK_ROWS * columns[i].width);
+		if (block_columns[i] == NULL) {
+			fprintf(stderr, "decode failed: out of memory\n");
+			exit(3);
+		}
+	}
+}
+
+//
+// This function writes the block of the columnar output being filled to standard output and starts a new block
+//
+void decode_write_block(void)
+{
+	static const char padding[DECODE_BLOCK_ALIGNMENT];
+
+	struct decode_block block;
+	block.row_count = block_row_count;
+	block.length = 0;
+	for (size_t i = 0; i < DECODE_COLUMN_COUNT; i++) {
+		block.length += block_row_count * columns[i].width;
+	}
+
+	uint32_t padding_length = (DECODE_BLOCK_ALIGNMENT - block.length % DECODE_BLOCK_ALIGNMENT) % DECODE_BLOCK_ALIGNMENT;
+	block.length += padding_length;
+
+	fwrite(&block, sizeof(struct decode_block), 1, stdout);
+	for (size_t i = 0; i < DECODE_COLUMN_COUNT; i++) {
+		fwrite(block_columns[i], columns[i].width, block_row_count, stdout);
+	}
+	fwrite(padding, 1, padding_length, stdout);
+
+	block_row_count = 0;
+}
+
+//
+// This function moves the rows in a buffer into the columns of the blocks of the columnar output, writing each block
+// as it fills, and empties the buffer
+//
+// Parameters:
+//  struct decode_buffer* buffer: The buffer of rows
+//
+void decode_write_rows(struct decode_buffer* buffer)
+{
+	const struct decode_row* rows = (const struct decode_row*)buffer->data;
+	size_t row_count = buffer->length / sizeof(struct decode_row);
+
+	for (size_t row = 0; row < row_count; row++) {
+		for (size_t i = 0; i < DECODE_COLUMN_COUNT; i++) {
+			memcpy(block_columns[i] + block_row_count * columns[i].width, (const char*)&rows[row] + columns[i].offset, columns[i].width);
+		}
+
+		if (++block_row_count == DECODE_BLOCK_ROWS) {
+			decode_write_block();
+		}
+	}
+
+	buffer->length = 0;
+}
+
+//
+// This function writes the text or rows in a buffer to standard output and empties the buffer
+//
+// Parameters:
+//  struct decode_buffer* buffer: The buffer
+//
+void decode_flush(struct decode_buffer* buffer)
+{
+	if (columnar) {
+		decode_write_rows(buffer);
+		return;
+	}
+
+	fwrite(buffer->data, 1, buffer->length, stdout);
+	buffer->length = 0;
+}
+
+//
+// This function decodes a GTP packet as a line of text
+//
+// Parameters:
+//  struct decode_buffer* output: The buffer to which the decoded text is appended
 //  const struct pcap_pkthdr* header: A pointer to the header of the packet
 //  const unsigned char* data: A pointer to the packet data
 //
-void decode_gtp_packet(unsigned char* notused, const struct pcap_pkthdr* header, const unsigned char* data)
+void decode_gtp_packet(struct decode_buffer* output, const struct pcap_pkthdr* header, const unsigned char* data)
 {
-	struct gtpv1hdr* gtpv1hdr = gtpv1_get_header(header->caplen, data);
+	struct gtpv1hdr* gtpv1hdr = gtpv1_get_header(pcap_linktype, header->caplen, data);
 	int offset = 0;
 
-	char time_string[FILENAME_MAX];
-
-	sprintf(time_string, "%s", ctime(&header->ts.tv_sec));
-	time_string[strlen(time_string)-1] = 0;
-
-	printf("%s %09u usec:", time_string, (unsigned int)header->ts.tv_sec);
+	decode_append_time(output, header->ts.tv_sec);
+	DECODE_APPEND_LITERAL(output, " ");
+	decode_append_decimal(output, header->ts.tv_sec, 9);
+	DECODE_APPEND_LITERAL(output, " usec:");
 
 	if (gtpv1hdr == NULL) {
-		printf("not-gtp\n");
+		DECODE_APPEND_LITERAL(output, "not-gtp\n");
 		return;
 	}
 
 	if (gtpv1hdr->message_type == GTPV1_MT_G_PDU) {
-		printf("gtp-u,");
+		DECODE_APPEND_LITERAL(output, "gtp-u,");
 	}
 	else {
-		printf("gtp-c,");
+		DECODE_APPEND_LITERAL(output, "gtp-c,");
 	}
 
-	printf("%d,%d,", GTP_VER(gtpv1hdr->flag_typever), GTP_TYPE(gtpv1hdr->flag_typever));
-	printf("%d,%d,%d,", GTP_EXT_FLAG(gtpv1hdr->flag_options), GTP_SEQ_FLAG(gtpv1hdr->flag_options), GTP_NPDU_FLAG(gtpv1hdr->flag_options));
-	printf("%d[%s],%d,%x,", gtpv1hdr->message_type, gtpv1_message_types[gtpv1hdr->message_type].name, ntohs(gtpv1hdr->length), ntohl(gtpv1hdr->teid));
+	// The version, type and flags are single digits
+	char flags[] = {'0' + GTP_VER(gtpv1hdr->flag_typever), ',', '0' + GTP_TYPE(gtpv1hdr->flag_typever), ',',
+			'0' + GTP_EXT_FLAG(gtpv1hdr->flag_options), ',', '0' + GTP_SEQ_FLAG(gtpv1hdr->flag_options), ',',
+			'0' + GTP_NPDU_FLAG(gtpv1hdr->flag_options), ','};
+	decode_append(output, flags, sizeof(flags));
+
+	const char* message_type_name = gtpv1_message_type_name(gtpv1hdr->message_type);
+	decode_append_decimal(output, gtpv1hdr->message_type, 0);
+	DECODE_APPEND_LITERAL(output, "[");
+	decode_append(output, message_type_name, strlen(message_type_name));
+	DECODE_APPEND_LITERAL(output, "],");
+	decode_append_decimal(output, ntohs(gtpv1hdr->length), 0);
+	DECODE_APPEND_LITERAL(output, ",");
+	decode_append_hex(output, ntohl(gtpv1hdr->teid));
+	DECODE_APPEND_LITERAL(output, ",");
+
+	// The optional fields and the tunnelled IP header are only decoded if they were captured
+	u_int gtp_length = header->caplen - ((u_char*)gtpv1hdr - data);
 
 	// Options specified
 	if (gtpv1hdr->flag_options) {
 		struct gtpv1hdropt* gtpv1hdropt = (struct gtpv1hdropt*)(((char*)gtpv1hdr) + sizeof(struct gtpv1hdr));
 
 		offset += sizeof(struct gtpv1hdr) + sizeof(struct gtpv1hdropt);
-		printf("%x,%x,%x", ntohs(gtpv1hdropt->sequence_no), gtpv1hdropt->npdu_no, gtpv1hdropt->next_exthdrtype);
+		if (offset <= gtp_length) {
+			decode_append_hex(output, ntohs(gtpv1hdropt->sequence_no));
+			DECODE_APPEND_LITERAL(output, ",");
+			decode_append_hex(output, gtpv1hdropt->npdu_no);
+			DECODE_APPEND_LITERAL(output, ",");
+			decode_append_hex(output, gtpv1hdropt->next_exthdrtype);
+		}
+		else {
+			DECODE_APPEND_LITERAL(output, ",,");
+		}
 	}
 	else {
 		offset += sizeof(struct gtpv1hdr);
-		printf(",,");
+		DECODE_APPEND_LITERAL(output, ",,");
 	}
 
 	if (gtpv1hdr->message_type == GTPV1_MT_G_PDU) {
 		struct ip* tunnelled_ip_header = (struct ip*)(((char*)gtpv1hdr) + offset);
-		printf(",%s,", inet_ntoa(tunnelled_ip_header->ip_src));
-		printf("%s", inet_ntoa(tunnelled_ip_header->ip_dst));
-		printf("\n");
+		if (offset + sizeof(struct ip) <= gtp_length) {
+			DECODE_APPEND_LITERAL(output, ",");
+			decode_append_address(output, (const u_char*)&tunnelled_ip_header->ip_src);
+			DECODE_APPEND_LITERAL(output, ",");
+			decode_append_address(output, (const u_char*)&tunnelled_ip_header->ip_dst);
+			DECODE_APPEND_LITERAL(output, "\n");
+		}
+		else {
+			DECODE_APPEND_LITERAL(output, ",,\n");
+		}
 		return;
 	}
 
 	// No source or destination on GTP-C
-	printf(",,");
+	DECODE_APPEND_LITERAL(output, ",,");
 
-	// Checks for IMSI, TEID Data1, TEID COntrol, and EUA
+	// Checks for IMSI, TEID Data1, TEID COntrol
 	int imsi_found = 0;
 	int teidd1_found = 0;
 	int teidcp_found = 0;
-	int eua_found = 0;
 
 	// Get the next information element in the GTP-C message
-	while (offset < header->caplen) {
-		// Get the Information Element number
-		int ie = *(((unsigned char*)gtpv1hdr) + offset);
+	struct gtp_ie_iterator iterator;
+	struct gtp_ie ie;
+	if (!gtpv1_ie_iterator_init(&iterator, gtpv1hdr, gtp_length)) {
+		DECODE_APPEND_LITERAL(output, "\n");
+		return;
+	}
 
-		// Check if there is enough data to read the header
-		if (offset + gtpv1_information_elements[ie].header_length >= header->caplen) {
-			// Not enough data remaining to read header, break
-			break;
+	while (gtpv1_ie_next(&iterator, &ie)) {
+		if (ie.type == GTPV1_IE_IMSI) {
+			char imsistr[TBCD_IMSI_MAX_DIGITS + 1];
+			tbcd2str(ie.body, ie.length, imsistr, sizeof(imsistr));
+			decode_append(output, imsistr, strlen(imsistr));
+			DECODE_APPEND_LITERAL(output, ",");
+			imsi_found = 1;
 		}
 
-		// Check if this is a TLV IE
-		int body_length = gtpv1_information_elements[ie].body_length;
-		if (ie >= GTPV1_FIRST_TLV_IE) {
-			body_length = ntohs(*(unsigned short*)(((unsigned char*)gtpv1hdr) + offset + 1));
+		if (ie.type == GTPV1_IE_TEI_DATA_I) {
+			decode_append_hex(output, gtp_ie_read32(ie.body));
+			DECODE_APPEND_LITERAL(output, ",");
+			teidd1_found = 1;
 		}
 
-		// Check if there is enough data to read the header
-		if (offset + gtpv1_information_elements[ie].header_length + body_length >= header->caplen) {
-			// Not enough data remaining to read body, break
-			break;
+		if (ie.type == GTPV1_IE_TEI_CONTROL_PLANE) {
+			decode_append_hex(output, gtp_ie_read32(ie.body));
+			DECODE_APPEND_LITERAL(output, ",");
+			teidcp_found = 1;
+		}
+
+		// The body of the end user address is the PDP type and then the address
+		if (ie.type == GTPV1_IE_END_USER_ADDRESS && ie.length >= GTPV1_EUA_NO_ADDRESS_LENGTH + GTPV1_EUA_IPV4_LENGTH) {
+			decode_append_address(output, ie.body + GTPV1_EUA_NO_ADDRESS_LENGTH);
 		}
 
-		if (ie == GTPV1_IE_IMSI) {
-			struct gtpv1_imsi* imsip = (struct gtpv1_imsi*)(((unsigned char*)gtpv1hdr) + offset);
-			char imsistr[GTPV1_IMSI_LENGTH * 2];
-			imsi2str(imsip, imsistr);
-			printf ("%s,", imsistr);
+		if (ie.type > GTPV1_IE_IMSI && !imsi_found) {
+			DECODE_APPEND_LITERAL(output, ",");
 			imsi_found = 1;
 		}
 
-		if (ie == GTPV1_IE_TEI_DATA_I) {
-			struct gtpv1_teid* teidd1p = (struct gtpv1_teid*)(((unsigned char*)gtpv1hdr) + offset);
-			printf("%x,", teid2uint(teidd1p));
+		if (ie.type > GTPV1_IE_TEI_DATA_I && !teidd1_found) {
+			DECODE_APPEND_LITERAL(output, ",");
 			teidd1_found = 1;
 		}
 
-		if (ie == GTPV1_IE_TEI_CONTROL_PLANE) {
-			struct gtpv1_teid* teidcpp = (struct gtpv1_teid*)(((unsigned char*)gtpv1hdr) + offset);
-			printf("%x,", teid2uint(teidcpp));
+		if (ie.type > GTPV1_IE_TEI_CONTROL_PLANE && !teidcp_found) {
+			DECODE_APPEND_LITERAL(output, ",");
 			teidcp_found = 1;
 		}
+	}
+
+	DECODE_APPEND_LITERAL(output, "\n");
+}
+
+//
+// This function decodes a GTP packet as a row of the columnar output, the first of each information element is decoded
+//
+// Parameters:
+//  struct decode_buffer* output: The buffer to which the decoded row is appended
+//  const struct pcap_pkthdr* header: A pointer to the header of the packet
+//  const unsigned char* data: A pointer to the packet data
+//
+void decode_gtp_row(struct decode_buffer* output, const struct pcap_pkthdr* header, const unsigned char* data)
+{
+	struct decode_row* row = (struct decode_row*)decode_reserve(output, sizeof(struct decode_row));
+	memset(row, 0, sizeof(struct decode_row));
+	output->length += sizeof(struct decode_row);
+
+	row->timestamp = (int64_t)header->ts.tv_sec * 1000000 + header->ts.tv_usec;
+
+	struct gtpv1hdr* gtpv1hdr = gtpv1_get_header(pcap_linktype, header->caplen, data);
+	if (gtpv1hdr == NULL) {
+		row->packet_class = DECODE_CLASS_NOT_GTP;
+		return;
+	}
+
+	row->packet_class = gtpv1hdr->message_type == GTPV1_MT_G_PDU ? DECODE_CLASS_GTP_U : DECODE_CLASS_GTP_C;
+	row->flags = *(u_char*)gtpv1hdr;
+	row->message_type = gtpv1hdr->message_type;
+	row->length = ntohs(gtpv1hdr->length);
+	row->teid = ntohl(gtpv1hdr->teid);
+
+	// The optional fields and the tunnelled IP header are only decoded if they were captured
+	u_int gtp_length = header->caplen - ((u_char*)gtpv1hdr - data);
+	u_int offset = sizeof(struct gtpv1hdr);
+
+	if (gtpv1hdr->flag_options) {
+		struct gtpv1hdropt* gtpv1hdropt = (struct gtpv1hdropt*)(((char*)gtpv1hdr) + sizeof(struct gtpv1hdr));
+
+		offset += sizeof(struct gtpv1hdropt);
+		if (offset <= gtp_length) {
+			row->sequence = ntohs(gtpv1hdropt->sequence_no);
+			row->npdu = gtpv1hdropt->npdu_no;
+			row->next_type = gtpv1hdropt->next_exthdrtype;
+			row->present |= DECODE_PRESENT_OPTIONS;
+		}
+	}
+
+	if (gtpv1hdr->message_type == GTPV1_MT_G_PDU) {
+		struct ip* tunnelled_ip_header = (struct ip*)(((char*)gtpv1hdr) + offset);
+		if (offset + sizeof(struct ip) <= gtp_length) {
+			row->source = tunnelled_ip_header->ip_src.s_addr;
+			row->destination = tunnelled_ip_header->ip_dst.s_addr;
+			row->present |= DECODE_PRESENT_ADDRESSES;
+		}
+		return;
+	}
+
+	struct gtp_ie_iterator iterator;
+	struct gtp_ie ie;
+	if (!gtpv1_ie_iterator_init(&iterator, gtpv1hdr, gtp_length)) {
+		return;
+	}
+
+	while (gtpv1_ie_next(&iterator, &ie)) {
+		if (ie.type == GTPV1_IE_IMSI && !(row->present & DECODE_PRESENT_IMSI)) {
+			tbcd2str(ie.body, ie.length, row->imsi, sizeof(row->imsi));
+			row->present |= DECODE_PRESENT_IMSI;
+		}
+		else if (ie.type == GTPV1_IE_TEI_DATA_I && !(row->present & DECODE_PRESENT_TEID_DATA)) {
+			row->teid_data = gtp_ie_read32(ie.body);
+			row->present |= DECODE_PRESENT_TEID_DATA;
+		}
+		else if (ie.type == GTPV1_IE_TEI_CONTROL_PLANE && !(row->present & DECODE_PRESENT_TEID_CONTROL)) {
+			row->teid_control = gtp_ie_read32(ie.body);
+			row->present |= DECODE_PRESENT_TEID_CONTROL;
+		}
+		else if (ie.type == GTPV1_IE_END_USER_ADDRESS && ie.length >= GTPV1_EUA_NO_ADDRESS_LENGTH + GTPV1_EUA_IPV4_LENGTH &&
+				!(row->present & DECODE_PRESENT_EUA)) {
+			memcpy(&row->eua, ie.body + GTPV1_EUA_NO_ADDRESS_LENGTH, sizeof(row->eua));
+			row->present |= DECODE_PRESENT_EUA;
+		}
+	}
+}
+
+//
+// This function decodes a GTP packet as text or as a row of the columnar output
+//
+// Parameters:
+//  struct decode_buffer* output: The buffer to which the decoded packet is appended
+//  const struct pcap_pkthdr* header: A pointer to the header of the packet
+//  const unsigned char* data: A pointer to the packet data
+//
+static inline void decode_packet(struct decode_buffer* output, const struct pcap_pkthdr* header, const unsigned char* data)
+{
+	if (columnar) {
+		decode_gtp_row(output, header, data);
+	}
+	else {
+		decode_gtp_packet(output, header, data);
+	}
+}
 
-		if (ie == GTPV1_IE_END_USER_ADDRESS) {
-			struct gtpv1_eua* euap = (struct gtpv1_eua*)(((unsigned char*)gtpv1hdr) + offset);
+//
+// This function is a PCAP packet handler callback method for packets decoded serially by libpcap
+//
+// Parameters:
+//  unsigned char* pcap_param: A pointer to the decode buffer the text is written to
+//  const struct pcap_pkthdr* header: A pointer to the header of the packet
+//  const unsigned char* data: A pointer to the packet data
+//
+void decode_pcap_packet(unsigned char* pcap_param, const struct pcap_pkthdr* header, const unsigned char* data)
+{
+	struct decode_buffer* output = (struct decode_buffer*)pcap_param;
 
-			if (GTPV1_EUA_LENGTH(euap->length) > GTPV1_EUA_NO_ADDRESS_LENGTH) {
-				for (int i = 0; i < GTPV1_EUA_IPV4_LENGTH; i++) {
-					if (i > 0) {
-						printf(".");
-					}
-					printf ("%d", euap->address.ipv4.address[i]);
-				}
-				eua_found = 1;
+	decode_packet(output, header, data);
+	if (output->length >= DECODE_FLUSH_SIZE) {
+		decode_flush(output);
+	}
+}
+
+//
+// This function reads a 32 bit field of the memory mapped capture file in the byte order of the file
+//
+// Parameters:
+//  off_t offset: The offset of the field
+//
+// Return:
+//  uint32_t: The value of the field
+//
+static inline uint32_t decode_read32(off_t offset)
+{
+	uint32_t value;
+	memcpy(&value, capture_data + offset, sizeof(value));
+	return capture_swapped ? __builtin_bswap32(value) : value;
+}
+
+//
+// This function reads the header of a record of the memory mapped capture file
+//
+// Parameters:
+//  off_t offset: The offset of the record
+//  struct pcap_pkthdr* header: The header of the record is returned here
+//
+// Return:
+//  int: 1 if the record is present in full and libpcap would read it unchanged, 0 otherwise
+//
+int decode_read_record(off_t offset, struct pcap_pkthdr* header)
+{
+	if (offset + DECODE_RECORD_HEADER_SIZE > capture_size) {
+		return 0;
+	}
+
+	// The time stamp is stored as signed 32 bit fields
+	header->ts.tv_sec = (int32_t)decode_read32(offset);
+	header->ts.tv_usec = (int32_t)decode_read32(offset + 4);
+	header->caplen = decode_read32(offset + 8);
+	header->len = decode_read32(offset + 12);
+
+	return header->caplen <= capture_snaplen && offset + DECODE_RECORD_HEADER_SIZE + header->caplen <= capture_size;
+}
+
+//
+// This function finds the first record boundary at or after an offset of the memory mapped capture file, an offset is
+// taken as a boundary if a run of record headers from it are plausible and chain to each other or to the end of the file
+//
+// Parameters:
+//  off_t offset: The offset to start scanning from
+//
+// Return:
+//  off_t: The offset of the record boundary, -1 if none was found within a chunk of the offset
+//
+off_t decode_resync(off_t offset)
+{
+	off_t limit = offset + DECODE_CHUNK_SIZE;
+
+	for (; offset < limit && offset < capture_size; offset++) {
+		off_t record = offset;
+		int records = 0;
+
+		while (records < DECODE_RESYNC_RECORDS) {
+			struct pcap_pkthdr header;
+			if (!decode_read_record(record, &header) || header.ts.tv_usec < 0 || header.ts.tv_usec >= 1000000 ||
+					header.len < header.caplen) {
+				break;
+			}
+
+			records++;
+			record += DECODE_RECORD_HEADER_SIZE + header.caplen;
+			if (record == capture_size) {
+				records = DECODE_RESYNC_RECORDS;
 			}
 		}
 
-		if (ie > GTPV1_IE_IMSI && !imsi_found) {
-			printf(",");
-			imsi_found = 1;
+		if (records == DECODE_RESYNC_RECORDS) {
+			return offset;
 		}
+	}
 
-		if (ie > GTPV1_IE_TEI_DATA_I && !teidd1_found) {
-			printf(",");
-			teidd1_found = 1;
+	return -1;
+}
+
+//
+// This function decodes a chunk of the memory mapped capture file, records are decoded from the start of the chunk until
+// the start of the next chunk is reached or passed or until a record that libpcap would not read unchanged is met
+//
+// Parameters:
+//  struct decode_chunk* chunk: The chunk, its number is set and its boundaries and text are returned in it
+//
+void decode_chunk(struct decode_chunk* chunk)
+{
+	chunk->output.length = 0;
+	chunk->irregular = 0;
+
+	chunk->start = chunk->number == 0 ? DECODE_FILE_HEADER_SIZE : decode_resync(DECODE_FILE_HEADER_SIZE + chunk->number * DECODE_CHUNK_SIZE);
+	off_t end = chunk->number == chunk_count - 1 ? capture_size : decode_resync(DECODE_FILE_HEADER_SIZE + (chunk->number + 1) * DECODE_CHUNK_SIZE);
+
+	chunk->end = chunk->start;
+	if (chunk->start < 0) {
+		return;
+	}
+
+	// If the end of the chunk cannot be found, the chunk is left to libpcap
+	if (end < 0) {
+		chunk->irregular = 1;
+		return;
+	}
+
+	off_t offset = chunk->start;
+	while (offset < end) {
+		struct pcap_pkthdr header;
+		if (!decode_read_record(offset, &header)) {
+			chunk->irregular = 1;
+			break;
 		}
 
-		if (ie > GTPV1_IE_TEI_CONTROL_PLANE && !teidcp_found) {
-			printf(",");
-			teidcp_found = 1;
+		decode_packet(&chunk->output, &header, capture_data + offset + DECODE_RECORD_HEADER_SIZE);
+		offset += DECODE_RECORD_HEADER_SIZE + header.caplen;
+	}
+
+	chunk->end = offset;
+}
+
+//
+// This function is the main function of a decoding thread, it decodes chunks in order until all chunks are decoded or
+// decoding is stopped, running at most as many chunks ahead of the chunk being written as there are chunk buffers
+//
+// Parameters:
+//  void* notused: Not used
+//
+// Return:
+//  void*: Always NULL
+//
+void* decode_thread(void* notused)
+{
+	pthread_mutex_lock(&decode_mutex);
+
+	while (!decode_stop && next_chunk < chunk_count) {
+		if (next_chunk >= chunks_written + slot_count) {
+			pthread_cond_wait(&slot_free, &decode_mutex);
+			continue;
 		}
 
-		offset += gtpv1_information_elements[ie].header_length + body_length;
+		struct decode_chunk* chunk = &slots[next_chunk % slot_count];
+		chunk->number = next_chunk++;
+		pthread_mutex_unlock(&decode_mutex);
+
+		decode_chunk(chunk);
+
+		pthread_mutex_lock(&decode_mutex);
+		chunk->decoded = 1;
+		pthread_cond_broadcast(&chunk_decoded);
+	}
+
+	pthread_mutex_unlock(&decode_mutex);
+	return NULL;
+}
 
-		// We have processed all Information elements
-		if (offset >= sizeof(struct gtpv1hdr) + ntohs(gtpv1hdr->length)) {
+//
+// This function decodes the memory mapped capture file in chunks on a number of threads and writes the text of the
+// chunks in order for as long as the chunks join up
+//
+// Parameters:
+//  int thread_count: The number of decoding threads
+//
+// Return:
+//  off_t: The offset up to which the file was decoded, the rest must be decoded serially
+//
+off_t decode_parallel(int thread_count)
+{
+	pthread_t threads[DECODE_MAX_THREADS];
+	off_t expected = DECODE_FILE_HEADER_SIZE;
+
+	slot_count = thread_count * DECODE_CHUNKS_PER_THREAD;
+	slots = calloc(slot_count, sizeof(struct decode_chunk));
+	if (slots == NULL) {
+		return expected;
+	}
+
+	int started = 0;
+	for (; started < thread_count; started++) {
+		if (pthread_create(&threads[started], NULL, decode_thread, NULL) != 0) {
 			break;
 		}
 	}
 
-	printf("\n");
+	// If no thread could be started, everything is decoded serially
+	if (started == 0) {
+		chunk_count = 0;
+	}
+
+	for (long number = 0; number < chunk_count; number++) {
+		struct decode_chunk* chunk = &slots[number % slot_count];
+
+		pthread_mutex_lock(&decode_mutex);
+		while (!chunk->decoded) {
+			pthread_cond_wait(&chunk_decoded, &decode_mutex);
+		}
+		pthread_mutex_unlock(&decode_mutex);
+
+		// Chunks are only written while each one starts where the one before it ended
+		if (chunk->start != expected) {
+			break;
+		}
+
+		decode_flush(&chunk->output);
+		expected = chunk->end;
+		int irregular = chunk->irregular;
+
+		pthread_mutex_lock(&decode_mutex);
+		chunk->decoded = 0;
+		chunks_written++;
+		pthread_cond_broadcast(&slot_free);
+		pthread_mutex_unlock(&decode_mutex);
+
+		if (irregular) {
+			break;
+		}
+	}
+
+	// Stop the threads that are still decoding
+	pthread_mutex_lock(&decode_mutex);
+	decode_stop = 1;
+	pthread_cond_broadcast(&slot_free);
+	pthread_mutex_unlock(&decode_mutex);
+
+	for (int i = 0; i < started; i++) {
+		pthread_join(threads[i], NULL);
+	}
+
+	for (long i = 0; i < slot_count; i++) {
+		free(slots[i].output.data);
+	}
+	free(slots);
+
+	return expected;
+}
+
+//
+// This function memory maps a capture file for decoding in parallel, only regular files with the standard microsecond
+// PCAP header of version 2.4 in either byte order and with a link layer type libpcap does not rewrite are mapped
+//
+// Parameters:
+//  const char* file_name: The name of the capture file
+//
+// Return:
+//  int: 1 if the file was mapped, 0 if it must be decoded serially
+//
+int decode_map_file(const char* file_name)
+{
+	int fd = open(file_name, O_RDONLY);
+	if (fd < 0) {
+		return 0;
+	}
+
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode) || file_stat.st_size <= DECODE_FILE_HEADER_SIZE) {
+		close(fd);
+		return 0;
+	}
+
+	void* data = mmap(NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED) {
+		return 0;
+	}
+
+	capture_data = data;
+	capture_size = file_stat.st_size;
+
+	uint32_t magic;
+	memcpy(&magic, capture_data, sizeof(magic));
+	capture_swapped = magic != DECODE_MAGIC;
+
+	unsigned int version = decode_read32(4);
+	capture_snaplen = decode_read32(16);
+	unsigned int linktype = decode_read32(20);
+	if (capture_swapped) {
+		version = version >> 16 | version << 16;
+	}
 
+	if ((magic != DECODE_MAGIC && magic != __builtin_bswap32(DECODE_MAGIC)) ||
+			version != (DECODE_VERSION_MAJOR | DECODE_VERSION_MINOR << 16) ||
+			(linktype != DECODE_LINKTYPE_ETHERNET && linktype != DECODE_LINKTYPE_LINUX_SLL)) {
+		munmap(data, capture_size);
+		capture_data = NULL;
+		return 0;
+	}
 
+	madvise(data, capture_size, MADV_SEQUENTIAL);
+	return 1;
 }
 
 int main(int argc, char** argv)
 {
-	// Set up GTP V1 message types and information elements
-	init_gtpv1();
+	long thread_count = sysconf(_SC_NPROCESSORS_ONLN);
+	int usage = 0;
 
-	if (argc != 2) {
-		fprintf(stderr, "usage: %s pcap_file_name\n", argv[0]);
+	int opt;
+	while ((opt = getopt(argc, argv, "bj:")) != -1) {
+		switch (opt) {
+		case 'b':
+			columnar = 1;
+			break;
+		case 'j':
+			thread_count = atol(optarg);
+			usage |= thread_count < 1;
+			break;
+		default:
+			usage = 1;
+			break;
+		}
+	}
+
+	if (usage || argc - optind != 1) {
+		fprintf(stderr, "usage: %s [-b] [-j threads] pcap_file_name\n", argv[0]);
+		fprintf(stderr, "  -b writes the packets as blocks of binary columns instead of text\n");
+		fprintf(stderr, "  -j decodes large files on this many threads, the default is the number of processors, at most %d\n", DECODE_MAX_THREADS);
 		return 1;
 	}
 
+	if (thread_count > DECODE_MAX_THREADS) {
+		thread_count = DECODE_MAX_THREADS;
+	}
+
+	char* file_name = argv[optind];
+
+	// The time zone is set once for the conversion of time stamps on all threads
+	tzset();
+
 	char pcap_errbuf[PCAP_ERRBUF_SIZE];
-	printf("gtp,version,type,f_exthdr,f_seqno,f_npdu,msgtype,length,teid,seqno,npdu,nexttype,src,dest\n");
+	if (columnar) {
+		decode_write_schema();
+	}
+	else {
+		printf("gtp,version,type,f_exthdr,f_seqno,f_npdu,msgtype,length,teid,seqno,npdu,nexttype,src,dest\n");
+	}
 
-	pcap_t* pcap_handle = pcap_open_offline(argv[1], pcap_errbuf);
+	pcap_t* pcap_handle = pcap_open_offline(file_name, pcap_errbuf);
 	if (pcap_handle == NULL) {
 		fprintf(stderr, "decode failed: %s\n", pcap_errbuf);
 		return 2;
 	}
-	pcap_loop(pcap_handle, -1, decode_gtp_packet, NULL);
+	pcap_linktype = pcap_datalink(pcap_handle);
+
+	// Decode the file in parallel if it is large enough to split, libpcap decodes whatever is left from where that stops
+	int serial = 1;
+	if (thread_count > 1 && decode_map_file(file_name)) {
+		chunk_count = (capture_size - DECODE_FILE_HEADER_SIZE + DECODE_CHUNK_SIZE - 1) / DECODE_CHUNK_SIZE;
+
+		off_t offset = DECODE_FILE_HEADER_SIZE;
+		if (chunk_count > 1) {
+			offset = decode_parallel(thread_count);
+		}
+		munmap((void*)capture_data, capture_size);
 
+		serial = offset < capture_size;
+		if (serial && fseeko(pcap_file(pcap_handle), offset, SEEK_SET) != 0) {
+			fprintf(stderr, "decode failed: could not seek to offset %lld\n", (long long)offset);
+			pcap_close(pcap_handle);
+			return 2;
+		}
+	}
+
+	if (serial) {
+		struct decode_buffer output;
+		memset(&output, 0, sizeof(struct decode_buffer));
+		pcap_loop(pcap_handle, -1, decode_pcap_packet, (unsigned char*)&output);
+		decode_flush(&output);
+		free(output.data);
+	}
+
+	// Write the last block of the columnar output
+	if (columnar) {
+		if (block_row_count > 0) {
+			decode_write_block();
+		}
+
+		for (size_t i = 0; i < DECODE_COLUMN_COUNT; i++) {
+			free(block_columns[i]);
+		}
+	}
+
+	pcap_close(pcap_handle);
 	return 0;
 }
-
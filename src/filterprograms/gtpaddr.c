@@ -13,59 +13,112 @@
 * Author: LMI/LXR/SH Liam Fallon
 ************************************************************************/
 
+/**
+ * This program changes the IPv4 addresses of the packets of a PCAP file. The addresses are changed by an address map of
+ * exact addresses and prefixes given on the command line or in map files. The addresses of the packets tunnelled in
+ * G-PDUs are changed and optionally those of the packets carrying GTP and of other IPv4 packets, with their checksums
+ * updated
+ */
+
 #include <stdlib.h>
+#include <unistd.h>
 #include <pcap/pcap.h>
 #include <netinet/ip.h>
 #include <arpa/inet.h>
 
 #include <gtpv1.h>
 #include <pcapdefines.h>
+#include <pcapsession.h>
 
 
 // Define PCAP handles
 pcap_dumper_t* pcap_dumper = NULL;
 
-// Define old and new IP addresses
-struct in_addr old_ip;
-struct in_addr new_ip;
+// The link layer type of the input file
+int pcap_linktype = DLT_EN10MB;
+
+// The address map and the headers it is applied to
+pcapsession_address_map_t address_map;
+int remap_headers = PCAP_SESSION_REMAP_INNER;
+
+// Counts of the packets and addresses changed
+unsigned long packets_changed = 0;
+unsigned long addresses_changed = 0;
 
 // Forward references for private functions
 void pcap_packet_handler(unsigned char* pcap_param, const struct pcap_pkthdr* header, const unsigned char* data);
 
 int main(int argc, char** argv) {
-	// Check arguments
-	if (argc != 5) {
-		fprintf(stderr, "usage: %s in_file out_file old_ip new_ip\n", argv[0]);
-		fprintf(stderr, "  if in_file or out_file are specified as -, then standard input/standard output is used\n");
-		return 2;
-	}
+	int usage = 0;
+	char errbuf[PCAP_SESSION_ADDRESS_MAP_ERRBUF_SIZE];
 
-	// Save old and new IP addresses
-	if (!inet_aton(argv[3], &old_ip)) {
-		fprintf(stderr, "old Internet address %s is not valid\n", argv[3]);
+	if (!pcapsession_address_map_init(&address_map)) {
+		fprintf(stderr, "could not allocate the address map\n");
 		return 3;
 	}
 
-	if (!inet_aton(argv[4], &new_ip)) {
-		fprintf(stderr, "new Internet address %s is not valid\n", argv[4]);
-		return 3;
+	// Check arguments, map files are loaded as they are given
+	int opt;
+	while ((opt = getopt(argc, argv, "f:o")) != -1) {
+		switch (opt) {
+		case 'f':
+			if (!pcapsession_address_map_load(&address_map, optarg, errbuf)) {
+				fprintf(stderr, "%s\n", errbuf);
+				return 3;
+			}
+			break;
+		case 'o':
+			remap_headers |= PCAP_SESSION_REMAP_OUTER;
+			break;
+		default:
+			usage = 1;
+			break;
+		}
 	}
 
-	fprintf(stderr, "starting modification of packet IP addresses\n");
+	// An address mapping may be given after the files
+	if (!usage && argc - optind == 4) {
+		char mapping[FILENAME_MAX];
+		snprintf(mapping, FILENAME_MAX, "%s %s", argv[optind + 2], argv[optind + 3]);
+		if (!pcapsession_address_map_add(&address_map, mapping, errbuf)) {
+			fprintf(stderr, "%s\n", errbuf);
+			return 3;
+		}
+	}
+	else if (argc - optind != 2) {
+		usage = 1;
+	}
+
+	if (usage || address_map.count == 0) {
+		fprintf(stderr, "usage: %s [-f map_file]... [-o] in_file out_file [old_ip[/length] new_ip]\n", argv[0]);
+		fprintf(stderr, "  if in_file or out_file are specified as -, then standard input/standard output is used\n");
+		fprintf(stderr, "  the addresses of the packets tunnelled in G-PDUs that are in old_ip[/length] are changed to the same\n");
+		fprintf(stderr, "  host part in new_ip, the IP, TCP and UDP checksums are updated\n");
+		fprintf(stderr, "  -f adds the mappings in map_file, one old_ip[/length] new_ip on each line, the longest prefix is used\n");
+		fprintf(stderr, "  -o also changes the addresses of the packets carrying GTP and of other IPv4 packets\n");
+		pcapsession_address_map_close(&address_map);
+		return 2;
+	}
+
+	char* in_file = argv[optind];
+	char* out_file = argv[optind + 1];
+
+	fprintf(stderr, "starting modification of packet IP addresses with %u mappings\n", address_map.count);
 
 	// Open PCAP file input from standard input
 	char pcap_errbuf[PCAP_ERRBUF_SIZE];
-	pcap_t* pcap_handle = pcap_open_offline(argv[1], pcap_errbuf);
+	pcap_t* pcap_handle = pcap_open_offline(in_file, pcap_errbuf);
 	if (pcap_handle == NULL) {
-		fprintf(stderr, "capture start failed on file %s: %s\n", argv[1], pcap_errbuf);
+		fprintf(stderr, "capture start failed on file %s: %s\n", in_file, pcap_errbuf);
 		return 4;
 	}
+	pcap_linktype = pcap_datalink(pcap_handle);
 
 	// Open packet dumping on the standard output
-	pcap_dumper = pcap_dump_open(pcap_handle, argv[2]);
+	pcap_dumper = pcap_dump_open(pcap_handle, out_file);
 	if (pcap_dumper == NULL) {
 		pcap_close(pcap_handle);
-		fprintf(stderr, "dump start failed on file %s\n", argv[2]);
+		fprintf(stderr, "dump start failed on file %s\n", out_file);
 		return 5;
 	}
 
@@ -79,12 +132,14 @@ int main(int argc, char** argv) {
 
 	// Close pcap
 	pcap_close(pcap_handle);
+	pcapsession_address_map_close(&address_map);
 
-	fprintf(stderr, "completed modification of packet IP addresses\n");
+	fprintf(stderr, "completed modification of packet IP addresses, %lu addresses changed in %lu packets\n", addresses_changed, packets_changed);
 }
 
 //
-// This function is a PCAP packet handler callback method for packets, it modifies the IP address on the inner GTP-U tunnelled packet
+// This function is a PCAP packet handler callback method for packets, it changes the IP addresses that are in the
+// address map
 //
 // Parameters:
 //  unsigned char* pcap_param: A pointer to user data set in the pcap_loop call, in this case it is not used
@@ -93,37 +148,15 @@ int main(int argc, char** argv) {
 //
 void pcap_packet_handler(unsigned char* pcap_param, const struct pcap_pkthdr* header, const unsigned char* data)
 {
-	// Search for a GTP v1 header in the packet
-	struct gtpv1hdr* gtpv1hdr = gtpv1_get_header(header->caplen, data);
-
-	// Check if the header was found or if extension header found
-	if (gtpv1hdr == NULL || GTP_EXT_FLAG(gtpv1hdr->flag_options)) {
-		// Dump the packet and return
-		pcap_dump((unsigned char*)pcap_dumper, header, data);
-
-		return;
-	}
-
-	struct ip* inner_ip_header = NULL;
-	// Options specified
-	if (gtpv1hdr->flag_options) {
-		struct gtpv1hdropt* gtpv1hdropt = (struct gtpv1hdropt*)(((char*)gtpv1hdr) + sizeof(struct gtpv1hdr));
-
-		inner_ip_header = (struct ip*)(((char*)gtpv1hdropt) + sizeof(struct gtpv1hdropt));
-	}
-	else {
-		inner_ip_header = (struct ip*)(((char*)gtpv1hdr) + sizeof(struct gtpv1hdr));
-	}
-
-	// Change the IP address to the new address
-	if (gtpv1hdr->message_type == GTPV1_MT_G_PDU) {
-		if (inner_ip_header->ip_src.s_addr == old_ip.s_addr) {
-			inner_ip_header->ip_src = new_ip;
-		}
-		else if (inner_ip_header->ip_dst.s_addr == old_ip.s_addr) {
-			inner_ip_header->ip_dst = new_ip;
-		}
+	// Copy the header data to a new modifiable header
+	struct pcap_pkthdr new_header = *header;
+
+	// Change the IP addresses to the new addresses
+	int changed = pcapsession_remap_packet(pcap_linktype, &new_header, data, &address_map, remap_headers);
+	if (changed != 0) {
+		packets_changed++;
+		addresses_changed += changed;
 	}
 
-	pcap_dump((unsigned char*)pcap_dumper, header, data);
+	pcap_dump((unsigned char*)pcap_dumper, &new_header, data);
 }
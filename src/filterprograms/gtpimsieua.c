@@ -13,6 +13,25 @@
  * Author: LMI/LXR/SH Liam Fallon
  ************************************************************************/
 
+/**
+ * This program maps IMSIs to end user addresses by correlating GTP-C messages on their PDP contexts. GTP V1 messages
+ * on the Gn/Gp interfaces and GTP V2 messages on the S11 and S5/S8 interfaces are correlated in the same pass, a GTP V2
+ * session is correlated as a PDP context.
+ *
+ * With the -t option correlation is spread over shard threads. The reader thread parses the messages and routes each
+ * one to the shard that owns its PDP context, shards own their contexts outright and write their output lines to
+ * per shard rings, and a writer thread merges the rings in capture order. Messages are routed on the TEID and peer of
+ * the entry they address, so a request and its response meet on the same shard. Both entries of a PDP context and
+ * any pending new side must be on the same shard though, so when a response or update names a TEID for the other
+ * side of a context, the reader routes that TEID to the shard of the context. Those routes are the only state the
+ * reader keeps, shards tell the reader over a notice ring when they remove a routed entry
+ *
+ * With the -s option the contexts are saved to a snapshot file every SNAPSHOT_INTERVAL seconds of packet time and when
+ * the program exits, and loaded from it when the program starts so that responses and deletes for contexts created
+ * before a restart are still correlated. Pending requests that have timed out are not loaded
+ */
+
+#include <signal.h>
 #include <stdlib.h>
 #include <string.h>
 #include <pthread.h>
@@ -24,167 +43,1369 @@
 #include <pcap/pcap.h>
 
 #include <gtpv1.h>
+#include <gtpv1_context.h>
+#include <gtpv2.h>
+#include <gtp_ie_iterator.h>
+#include <tbcd.h>
 #include <pcapsession.h>
 #include <pcapdefines.h>
+#include <spscring.h>
+
+#define IMSI_TIMEOUT  300  // The number of seconds to wait for the response to a request
+
+#define SNAPSHOT_INTERVAL 60  // The number of seconds of packet time between snapshots
+
+#define MAX_SHARDS        64    // The maximum number of correlation shards
+#define SHARD_RING_SIZE   4096  // The number of elements on each shard ring, a power of two
+#define SHARD_IDLE_WAIT   50    // The number of microseconds threads sleep when they have nothing to do
+#define OUTPUT_LENGTH     64    // The maximum length of an output line
+
+// The places of the information elements used in correlation in the sets found in messages
+#define CORRELATION_IE_IMSI           0
+#define CORRELATION_IE_CAUSE          1
+#define CORRELATION_IE_TEIDC          2  // The control plane TEID, or the sender F-TEID for the control plane in GTP V2
+#define CORRELATION_IE_NSAPI          3  // The NSAPI, or the linked EPS bearer ID in GTP V2
+#define CORRELATION_IE_EUA            4  // The end user address, or the PDN address allocation in GTP V2
+#define CORRELATION_IE_TEARDOWN       5  // GTP V1 only
+#define CORRELATION_IE_BEARER_CONTEXT 6  // GTP V2 only
+#define CORRELATION_IE_COUNT          7
+
+// The types of event passed to correlation shards
+#define EVENT_MESSAGE 0  // A GTP-C message
+#define EVENT_PURGE   1  // A node has allocated the key, remove a stale context on it
+
+// The information elements of a GTP-C message that are used in correlation
+struct gtpc_message {
+	char imsi[GTPV1_IMSI_LENGTH * 2];    // The IMSI, empty if not present
+	int has_teidc;                       // Set if the control plane TEID is present
+	u_int teidc;                         // The control plane TEID
+	int cause;                           // The cause, -1 if not present
+	int nsapi;                           // The NSAPI, -1 if not present
+	int teardown;                        // Set if the teardown indicator is set
+	int has_eua;                         // Set if an IPv4 end user address is present
+	u_int eua;                           // The IPv4 end user address, in network byte order
+};
+
+// An event passed to a correlation shard
+struct gtpc_event {
+	unsigned long sequence;              // The capture order of the packet, starting at 1
+	struct timeval ts;                   // The packet time
+	int type;                            // The EVENT_ type
+	u_char message_type;                 // The GTP message type
+	u_int teid;                          // The TEID in the GTP header, in host byte order
+	u_int source;                        // The source address of the message
+	u_int destination;                   // The destination address of the message
+	struct gtpc_message message;         // The message information elements
+	u_int route_teid;                    // The TEID of the key routed to the shard by this event
+	u_int route_peer;                    // The peer of the key routed to the shard by this event
+	unsigned long route_sequence;        // The sequence of the route, 0 if the event does not route a key
+};
+
+// An output line on a shard output ring
+struct gtpc_output {
+	unsigned long sequence;              // The capture order of the packet the line is for
+	char text[OUTPUT_LENGTH];            // The line
+};
+
+// A notice to the reader that a routed key has been removed from a shard
+struct gtpc_route_notice {
+	u_int teid;                          // The TEID of the key
+	u_int peer;                          // The peer of the key
+	unsigned long sequence;              // The sequence of the route when the key was routed
+};
+
+// A correlation shard, it owns the contexts that are routed to it
+struct correlation_shard {
+	u_int id;                            // The index of the shard
+	pthread_t thread;                    // The shard thread
+	struct gtpv1_context_table* table;   // The PDP contexts of the shard
+	struct gtpc_event* event;            // The event being correlated
+	struct spsc_ring events;             // Events from the reader
+	struct spsc_ring output;             // Output lines to the writer
+	struct spsc_ring notices;            // Route notices to the reader
+	volatile unsigned long enqueued __attribute__((aligned(SPSC_RING_CACHE_LINE_SIZE)));  // Events put on the ring, written by the reader
+	volatile unsigned long processed __attribute__((aligned(SPSC_RING_CACHE_LINE_SIZE))); // Events correlated, written by the shard
+	volatile unsigned long processed_sequence;  // The sequence of the last event correlated
+};
+
+// The correlation shards, without the -t option there is one shard that correlates on the reader thread
+struct correlation_shard* shards = NULL;
+u_int shard_count = 1;
+int threaded = 0;
+
+// The information elements used in correlation
+struct gtp_ie_set gtpv1_correlation_ies;
+struct gtp_ie_set gtpv2_correlation_ies;
+
+// The routes of keys that are not on their home shard, kept by the reader thread
+struct gtpv1_context_table* route_table = NULL;
+
+// The sequence of the last packet read and the last packet whose events have all been put on the shard rings
+unsigned long packet_sequence = 0;
+volatile unsigned long dispatched_sequence = 0;
+volatile int reader_done = 0;
+
+// The snapshot file, the time of the last packet read and the packet time at which the next snapshot is taken
+char* snapshot_path = NULL;
+time_t snapshot_time = 0;
+time_t next_snapshot = 0;
 
-#define IMSI_MAP_SIZE 10000000
-#define IMSI_TIMEOUT  300
+// The capture, it is stopped on signals so that the final snapshot is written
+pcap_t* pcap_handle = NULL;
 
-int    imsi_map  [IMSI_MAP_SIZE];
-time_t imsi_time [IMSI_MAP_SIZE];
-char   imsi_array[IMSI_MAP_SIZE][GTPV1_IMSI_LENGTH*2];
+// The link layer type of the input file or interface
+int pcap_linktype = DLT_EN10MB;
+
+// Forward definition of private functions
+void correlation_output(struct correlation_shard* shard, unsigned long sequence, char* text);
+void write_snapshot(void);
 
 //
-// This function decodes a GTP packet
+// This function removes a PDP context, both the entry given and the entry for the other side of the context
 //
 // Parameters:
-//  pcapsession_t*: Returns a pointer to the merger or NULL if opening failed
-//  const struct pcap_pkthdr* header: A pointer to the header of the packet
-//  const unsigned char* data: A pointer to the packet data
+//  struct correlation_shard* shard: The shard that holds the context
+//  struct gtpv1_context* context: The entry for one side of the PDP context
 //
-void decode_gtp_packet(unsigned char* notused, const struct pcap_pkthdr* header, const unsigned char* data)
+void remove_pdp_context(struct correlation_shard* shard, struct gtpv1_context* context)
+{
+	struct gtpv1_context* linked = gtpv1_context_find(shard->table, context->link_teid, context->link_peer);
+	if (linked != NULL && linked != context && linked->link_teid == context->teid && linked->link_peer == context->peer) {
+		gtpv1_context_remove(shard->table, linked);
+	}
+	gtpv1_context_remove(shard->table, context);
+}
+
+//
+// This function handles a Create PDP Context Request, a pending context is added for the SGSN side
+//
+// Parameters:
+//  struct correlation_shard* shard: The shard correlating the message
+//  struct gtpc_event* event: The message, its source is the SGSN
+//
+void handle_create_request(struct correlation_shard* shard, struct gtpc_event* event)
+{
+	struct gtpc_message* message = &event->message;
+
+	// Secondary PDP contexts are addressed to the GGSN and share the control plane TEIDs of the primary
+	if (event->teid != 0 || !message->has_teidc) {
+		return;
+	}
+
+	// An established context on the same key was not deleted cleanly, replace it
+	struct gtpv1_context* context = gtpv1_context_find(shard->table, message->teidc, event->source);
+	if (context != NULL && context->state != GTPV1_CONTEXT_CREATE_PENDING) {
+		remove_pdp_context(shard, context);
+	}
+
+	context = gtpv1_context_add(shard->table, message->teidc, event->source, event->ts.tv_sec);
+	if (context == NULL) {
+		return;
+	}
+
+	// Retransmitted requests restart the wait for the response
+	gtpv1_context_set_expiry(shard->table, context, event->ts.tv_sec + IMSI_TIMEOUT);
+	context->state = GTPV1_CONTEXT_CREATE_PENDING;
+	context->nsapi = message->nsapi;
+	strcpy(context->imsi, message->imsi);
+}
+
+//
+// This function handles a Create PDP Context Response, an accepted response establishes the context and adds the GGSN side
+//
+// Parameters:
+//  struct correlation_shard* shard: The shard correlating the message
+//  struct gtpc_event* event: The message, its source is the GGSN and its destination the SGSN
+//  char* imsi: The IMSI of the context is returned here, empty if the request was not seen
+//
+void handle_create_response(struct correlation_shard* shard, struct gtpc_event* event, char* imsi)
+{
+	struct gtpc_message* message = &event->message;
+
+	struct gtpv1_context* context = gtpv1_context_find(shard->table, event->teid, event->destination);
+	if (context == NULL || context->state != GTPV1_CONTEXT_CREATE_PENDING) {
+		return;
+	}
+	strcpy(imsi, context->imsi);
+
+	if (!GTPV1_CAUSE_ACCEPTED(message->cause) || !message->has_teidc) {
+		gtpv1_context_remove(shard->table, context);
+		return;
+	}
+
+	// Establish the SGSN side
+	context->state = GTPV1_CONTEXT_ACTIVE;
+	context->eua = message->has_eua ? message->eua : 0;
+	context->link_teid = message->teidc;
+	context->link_peer = event->source;
+	gtpv1_context_set_expiry(shard->table, context, GTPV1_CONTEXT_NEVER);
+
+	// Keep what the GGSN side needs, adding a context may move the contexts
+	struct gtpv1_context sgsn_context = *context;
+
+	// An established context on the GGSN key was not deleted cleanly, replace it
+	struct gtpv1_context* ggsn_context = gtpv1_context_find(shard->table, message->teidc, event->source);
+	if (ggsn_context != NULL) {
+		remove_pdp_context(shard, ggsn_context);
+	}
+
+	ggsn_context = gtpv1_context_add(shard->table, message->teidc, event->source, GTPV1_CONTEXT_NEVER);
+	if (ggsn_context == NULL) {
+		return;
+	}
+	gtpv1_context_set_expiry(shard->table, ggsn_context, GTPV1_CONTEXT_NEVER);
+	ggsn_context->state = GTPV1_CONTEXT_ACTIVE;
+	ggsn_context->eua = sgsn_context.eua;
+	ggsn_context->nsapi = sgsn_context.nsapi;
+	ggsn_context->link_teid = sgsn_context.teid;
+	ggsn_context->link_peer = sgsn_context.peer;
+	strcpy(ggsn_context->imsi, sgsn_context.imsi);
+}
+
+//
+// This function handles an Update PDP Context Request. If the sender moves its side of the context, to a new SGSN for
+// instance, a pending context is added for the new side. A sender that moves allocates a new control plane TEID, so
+// requests without one do not move the context
+//
+// Parameters:
+//  struct correlation_shard* shard: The shard correlating the message
+//  struct gtpc_event* event: The message
+//
+void handle_update_request(struct correlation_shard* shard, struct gtpc_event* event)
+{
+	struct gtpc_message* message = &event->message;
+
+	struct gtpv1_context* context = gtpv1_context_find(shard->table, event->teid, event->destination);
+	if (context == NULL || context->state != GTPV1_CONTEXT_ACTIVE) {
+		return;
+	}
+
+	// Check if the sender side of the context changes
+	if (!message->has_teidc || (message->teidc == context->link_teid && event->source == context->link_peer)) {
+		return;
+	}
+	u_int teid = message->teidc;
+
+	struct gtpv1_context receiver_context = *context;
+
+	struct gtpv1_context* pending = gtpv1_context_find(shard->table, teid, event->source);
+	if (pending != NULL && pending->state != GTPV1_CONTEXT_UPDATE_PENDING) {
+		return;
+	}
+
+	pending = gtpv1_context_add(shard->table, teid, event->source, event->ts.tv_sec);
+	if (pending == NULL) {
+		return;
+	}
+	gtpv1_context_set_expiry(shard->table, pending, event->ts.tv_sec + IMSI_TIMEOUT);
+	pending->state = GTPV1_CONTEXT_UPDATE_PENDING;
+	pending->eua = receiver_context.eua;
+	pending->nsapi = receiver_context.nsapi;
+	pending->link_teid = receiver_context.teid;
+	pending->link_peer = receiver_context.peer;
+	strcpy(pending->imsi, receiver_context.imsi);
+}
+
+//
+// This function handles an Update PDP Context Response, an accepted response moves the side of the context that sent
+// the request
+//
+// Parameters:
+//  struct correlation_shard* shard: The shard correlating the message
+//  struct gtpc_event* event: The message
+//
+void handle_update_response(struct correlation_shard* shard, struct gtpc_event* event)
+{
+	struct gtpv1_context* pending = gtpv1_context_find(shard->table, event->teid, event->destination);
+	if (pending == NULL || pending->state != GTPV1_CONTEXT_UPDATE_PENDING) {
+		return;
+	}
+
+	struct gtpv1_context* receiver = gtpv1_context_find(shard->table, pending->link_teid, pending->link_peer);
+	if (!GTPV1_CAUSE_ACCEPTED(event->message.cause) || receiver == NULL) {
+		gtpv1_context_remove(shard->table, pending);
+		return;
+	}
+
+	// Remove the old side of the context and link in the new one
+	struct gtpv1_context* old = gtpv1_context_find(shard->table, receiver->link_teid, receiver->link_peer);
+	if (old != NULL && old != pending) {
+		gtpv1_context_remove(shard->table, old);
+	}
+	receiver->link_teid = pending->teid;
+	receiver->link_peer = pending->peer;
+
+	pending->state = GTPV1_CONTEXT_ACTIVE;
+	gtpv1_context_set_expiry(shard->table, pending, GTPV1_CONTEXT_NEVER);
+}
+
+//
+// This function handles a Delete PDP Context Request, the receiving side is marked for deletion if the whole context
+// is being deleted rather than a secondary PDP context
+//
+// Parameters:
+//  struct correlation_shard* shard: The shard correlating the message
+//  struct gtpc_event* event: The message
+//
+void handle_delete_request(struct correlation_shard* shard, struct gtpc_event* event)
 {
-	struct gtpv1hdr* gtpv1hdr = gtpv1_get_header(header->caplen, data);
-	int offset = 0;
+	struct gtpc_message* message = &event->message;
 
-	if (gtpv1hdr == NULL) {
+	struct gtpv1_context* context = gtpv1_context_find(shard->table, event->teid, event->destination);
+	if (context == NULL || context->state != GTPV1_CONTEXT_ACTIVE) {
 		return;
 	}
 
-	if (gtpv1hdr->message_type != GTPV1_MT_CREATE_PDP_CONTEXT_REQUEST && gtpv1hdr->message_type != GTPV1_MT_CREATE_PDP_CONTEXT_RESPONSE) {
+	if (message->teardown || message->nsapi < 0 || message->nsapi == context->nsapi) {
+		context->delete_pending = 1;
+	}
+}
+
+//
+// This function handles a Delete PDP Context Response, the context is removed if the deletion was accepted or the
+// receiving side did not know the context
+//
+// Parameters:
+//  struct correlation_shard* shard: The shard correlating the message
+//  struct gtpc_event* event: The message
+//
+void handle_delete_response(struct correlation_shard* shard, struct gtpc_event* event)
+{
+	struct gtpv1_context* context = gtpv1_context_find(shard->table, event->teid, event->destination);
+	if (context == NULL || context->state != GTPV1_CONTEXT_ACTIVE) {
 		return;
 	}
 
-	// Options specified
-	if (gtpv1hdr->flag_options) {
-		offset += sizeof(struct gtpv1hdr) + sizeof(struct gtpv1hdropt);
+	struct gtpv1_context* receiver = gtpv1_context_find(shard->table, context->link_teid, context->link_peer);
+	if (receiver == NULL || !receiver->delete_pending) {
+		return;
+	}
+
+	if (GTPV1_CAUSE_ACCEPTED(event->message.cause) || event->message.cause == GTPV1_CAUSE_NON_EXISTENT) {
+		remove_pdp_context(shard, context);
 	}
 	else {
-		offset += sizeof(struct gtpv1hdr);
+		receiver->delete_pending = 0;
 	}
+}
 
-	// Hold the IMSI value
+//
+// This function sends a route notice from a shard to the reader
+//
+// Parameters:
+//  struct correlation_shard* shard: The shard
+//  u_int teid: The TEID of the key that is no longer on the shard
+//  u_int peer: The peer of the key
+//  unsigned long sequence: The sequence of the route of the key
+//
+void send_route_notice(struct correlation_shard* shard, u_int teid, u_int peer, unsigned long sequence)
+{
+	struct gtpc_route_notice* notice;
+	while ((notice = (struct gtpc_route_notice*) spsc_ring_reserve(&shard->notices)) == NULL) {
+		// Once reading has finished the routes are no longer needed
+		if (reader_done) {
+			return;
+		}
+		usleep(SHARD_IDLE_WAIT);
+	}
+
+	notice->teid = teid;
+	notice->peer = peer;
+	notice->sequence = sequence;
+	spsc_ring_push(&shard->notices);
+}
+
+//
+// This function is called when a context is removed from the table of a shard, if the key of the context was routed
+// to the shard the reader is told that the route is no longer needed
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table of the shard
+//  struct gtpv1_context* context: The context being removed
+//  void* shard_param: The shard, a struct correlation_shard*
+//
+void shard_context_removed(struct gtpv1_context_table* table, struct gtpv1_context* context, void* shard_param)
+{
+	struct correlation_shard* shard = shard_param;
+	struct gtpc_event* event = shard->event;
+
+	if (context->sequence == 0) {
+		return;
+	}
+
+	// The key the event being correlated routes here is checked when the event is done, it may be added back
+	if (event != NULL && event->route_sequence != 0 && event->route_teid == context->teid && event->route_peer == context->peer) {
+		return;
+	}
+
+	send_route_notice(shard, context->teid, context->peer, context->sequence);
+}
+
+//
+// This function correlates an event on a shard
+//
+// Parameters:
+//  struct correlation_shard* shard: The shard
+//  struct gtpc_event* event: The event
+//
+void correlate_event(struct correlation_shard* shard, struct gtpc_event* event)
+{
+	// Expire requests on packet time so that capture files are handled the same way as live capture
+	shard->event = event;
+	gtpv1_context_expire(shard->table, event->ts.tv_sec);
+
+	// The IMSI of a created context
 	char imsistr[GTPV1_IMSI_LENGTH * 2];
 	strcpy(imsistr, "");
 
-	time_t time_now;
-	time(&time_now);
+	// A node is allocating the key for the context the message is addressed to, any other context on it is stale
+	if (event->type == EVENT_PURGE) {
+		struct gtpv1_context* context = gtpv1_context_find(shard->table, event->route_teid, event->route_peer);
+		if (context != NULL && (context->link_teid != event->teid || context->link_peer != event->destination)) {
+			remove_pdp_context(shard, context);
+		}
+		shard->event = NULL;
+		return;
+	}
 
-	// Get the next information element in the GTP-C message
-	while (offset < header->caplen) {
-		// Get the Information Element number
-		int ie = *(((unsigned char*)gtpv1hdr) + offset);
+	switch (event->message_type) {
+	case GTPV1_MT_CREATE_PDP_CONTEXT_REQUEST:
+		handle_create_request(shard, event);
+		break;
+	case GTPV1_MT_CREATE_PDP_CONTEXT_RESPONSE:
+		handle_create_response(shard, event, imsistr);
+		break;
+	case GTPV1_MT_UPDATE_PDP_CONTEXT_REQUEST:
+		handle_update_request(shard, event);
+		break;
+	case GTPV1_MT_UPDATE_PDP_CONTEXT_RESPONSE:
+		handle_update_response(shard, event);
+		break;
+	case GTPV1_MT_DELETE_PDP_CONTEXT_REQUEST:
+		handle_delete_request(shard, event);
+		break;
+	case GTPV1_MT_DELETE_PDP_CONTEXT_RESPONSE:
+		handle_delete_response(shard, event);
+		break;
+	}
+	shard->event = NULL;
 
-		// Check if there is enough data to read the header
-		if (offset + gtpv1_information_elements[ie].header_length >= header->caplen) {
-			// Not enough data remaining to read header, break
-			break;
+	// Mark a key routed here by the event with its route, or tell the reader the route is not needed
+	if (event->route_sequence != 0) {
+		struct gtpv1_context* context = gtpv1_context_find(shard->table, event->route_teid, event->route_peer);
+		if (context != NULL) {
+			context->sequence = event->route_sequence;
 		}
+		else {
+			send_route_notice(shard, event->route_teid, event->route_peer, event->route_sequence);
+		}
+	}
+
+	// Output the end user addresses on Create PDP Context messages, with the IMSI on responses
+	if (!event->message.has_eua) {
+		return;
+	}
+	if (event->message_type != GTPV1_MT_CREATE_PDP_CONTEXT_REQUEST && event->message_type != GTPV1_MT_CREATE_PDP_CONTEXT_RESPONSE) {
+		return;
+	}
+
+	u_char* eua = (u_char*)&event->message.eua;
+	char text[OUTPUT_LENGTH];
+	int length = snprintf(text, OUTPUT_LENGTH, "%lu,%u,%d.%d.%d.%d", (unsigned long)event->ts.tv_sec, (u_int)event->ts.tv_usec,
+			eua[0], eua[1], eua[2], eua[3]);
+	if (imsistr[0] != '\0') {
+		length += snprintf(text + length, OUTPUT_LENGTH - length, ",%s", imsistr);
+	}
+	snprintf(text + length, OUTPUT_LENGTH - length, "\n");
 
-		// Check if this is a TLV IE
-		int body_length = gtpv1_information_elements[ie].body_length;
-		if (ie >= GTPV1_FIRST_TLV_IE) {
-			body_length = ntohs(*(unsigned short*)(((unsigned char*)gtpv1hdr) + offset + 1));
+	correlation_output(shard, event->sequence, text);
+}
+
+//
+// This function outputs a line, it is written directly if correlation is not threaded, otherwise it is put on the
+// output ring of the shard for the writer to merge
+//
+// Parameters:
+//  struct correlation_shard* shard: The shard
+//  unsigned long sequence: The capture order of the packet the line is for
+//  char* text: The line
+//
+void correlation_output(struct correlation_shard* shard, unsigned long sequence, char* text)
+{
+	if (!threaded) {
+		fputs(text, stdout);
+		return;
+	}
+
+	struct gtpc_output* output;
+	while ((output = (struct gtpc_output*) spsc_ring_reserve(&shard->output)) == NULL) {
+		usleep(SHARD_IDLE_WAIT);
+	}
+
+	output->sequence = sequence;
+	strcpy(output->text, text);
+	spsc_ring_push(&shard->output);
+}
+
+//
+// This function is the entry point of a shard thread, it correlates the events on its ring until reading is done
+//
+// Parameters:
+//  void* shard_param: A transparent parameter on thread initiation, set to a struct correlation_shard* here
+//
+void* shard_run(void* shard_param)
+{
+	struct correlation_shard* shard = shard_param;
+
+	while (1) {
+		struct gtpc_event* event = (struct gtpc_event*) spsc_ring_peek(&shard->events);
+		if (event == NULL) {
+			// Check the ring again after seeing that reading is done, the last events may have come in between
+			if (reader_done && (event = (struct gtpc_event*) spsc_ring_peek(&shard->events)) == NULL) {
+				break;
+			}
+			if (event == NULL) {
+				usleep(SHARD_IDLE_WAIT);
+				continue;
+			}
 		}
 
-		// Check if there is enough data to read the header
-		if (offset + gtpv1_information_elements[ie].header_length + body_length >= header->caplen) {
-			// Not enough data remaining to read body, break
+		correlate_event(shard, event);
+
+		shard->processed_sequence = event->sequence;
+		spsc_ring_pop(&shard->events);
+		shard->processed++;
+	}
+
+	return NULL;
+}
+
+//
+// This function is the entry point of the writer thread, it merges the output rings of the shards in capture order.
+// A line is written once every shard has correlated all its events up to the packet of the line
+//
+// Parameters:
+//  void* notused_param: A transparent parameter on thread initiation, not used here
+//
+void* writer_run(void* notused_param)
+{
+	while (1) {
+		// Read the progress of the reader before that of the shards
+		int done = reader_done;
+		unsigned long horizon = dispatched_sequence;
+		__sync_synchronize();
+
+		// A shard that has correlated every event put on its ring is complete up to the reader
+		int idle = 1;
+		for (u_int i = 0; i < shard_count; i++) {
+			unsigned long enqueued = shards[i].enqueued;
+			if (shards[i].processed != enqueued) {
+				idle = 0;
+				if (shards[i].processed_sequence < horizon) {
+					horizon = shards[i].processed_sequence;
+				}
+			}
+		}
+
+		// Write lines up to the horizon, oldest first
+		int written = 0;
+		while (1) {
+			struct gtpc_output* oldest = NULL;
+			u_int oldest_shard = 0;
+			for (u_int i = 0; i < shard_count; i++) {
+				struct gtpc_output* output = (struct gtpc_output*) spsc_ring_peek(&shards[i].output);
+				if (output != NULL && output->sequence <= horizon && (oldest == NULL || output->sequence < oldest->sequence)) {
+					oldest = output;
+					oldest_shard = i;
+				}
+			}
+			if (oldest == NULL) {
+				break;
+			}
+
+			fputs(oldest->text, stdout);
+			spsc_ring_pop(&shards[oldest_shard].output);
+			written++;
+		}
+
+		if (done && idle) {
 			break;
 		}
+		if (written == 0) {
+			fflush(stdout);
+			usleep(SHARD_IDLE_WAIT);
+		}
+	}
+
+	fflush(stdout);
+	return NULL;
+}
 
-		if (ie == GTPV1_IE_IMSI) {
-			struct gtpv1_imsi* imsip = (struct gtpv1_imsi*)(((unsigned char*)gtpv1hdr) + offset);
-			imsi2str(imsip, imsistr);
+//
+// This function gets the home shard of a key, the shard the key is on if it has not been routed elsewhere. The high
+// bits of the hash are used because the tables of the shards use the low bits
+//
+// Parameters:
+//  u_int teid: The TEID
+//  u_int peer: The peer address
+//
+// Return:
+//  u_int: The shard
+//
+u_int home_shard(u_int teid, u_int peer)
+{
+	return (u_int)(((unsigned long long)gtpv1_context_hash(teid, peer) * shard_count) >> 32);
+}
+
+//
+// This function gets the shard that holds a key
+//
+// Parameters:
+//  u_int teid: The TEID
+//  u_int peer: The peer address
+//
+// Return:
+//  u_int: The shard
+//
+u_int route_shard(u_int teid, u_int peer)
+{
+	if (!threaded) {
+		return 0;
+	}
+
+	struct gtpv1_context* route = gtpv1_context_find(route_table, teid, peer);
+	return route != NULL ? route->shard : home_shard(teid, peer);
+}
+
+//
+// This function reads the route notices from the shards and removes the routes that are no longer needed. A route
+// that was changed after the notice was sent is kept
+//
+// Return:
+//  int: The number of notices read
+//
+int read_route_notices(void)
+{
+	int read = 0;
+
+	for (u_int i = 0; i < shard_count; i++) {
+		struct gtpc_route_notice* notice;
+		while ((notice = (struct gtpc_route_notice*) spsc_ring_peek(&shards[i].notices)) != NULL) {
+			struct gtpv1_context* route = gtpv1_context_find(route_table, notice->teid, notice->peer);
+			if (route != NULL && route->shard == i && route->sequence == notice->sequence) {
+				gtpv1_context_remove(route_table, route);
+			}
+			spsc_ring_pop(&shards[i].notices);
+			read++;
 		}
+	}
 
-		if (ie == GTPV1_IE_TEI_CONTROL_PLANE) {
-			struct gtpv1_teid* teidcpp = (struct gtpv1_teid*)(((unsigned char*)gtpv1hdr) + offset);
-			if (gtpv1hdr->message_type == GTPV1_MT_CREATE_PDP_CONTEXT_REQUEST) {
+	return read;
+}
 
-				for (int i = 0; i < IMSI_MAP_SIZE; i++) {
-					if (imsi_map[i] == 0 || imsi_time[i] + IMSI_TIMEOUT < time_now) {
-						imsi_map[i] = teid2uint(teidcpp);
-						imsi_time[i] = time_now;
-						strcpy(imsi_array[i], imsistr);
-						break;
-					}
-				}
+//
+// This function puts an event on the ring of a shard, or correlates it directly if correlation is not threaded
+//
+// Parameters:
+//  u_int shard_id: The shard
+//  struct gtpc_event* event: The event
+//
+void dispatch_event(u_int shard_id, struct gtpc_event* event)
+{
+	struct correlation_shard* shard = &shards[shard_id];
+
+	if (!threaded) {
+		correlate_event(shard, event);
+		return;
+	}
+
+	struct gtpc_event* slot;
+	while ((slot = (struct gtpc_event*) spsc_ring_reserve(&shard->events)) == NULL) {
+		// Take notices while the shard catches up so that it never waits on the reader
+		if (read_route_notices() == 0) {
+			usleep(SHARD_IDLE_WAIT);
+		}
+	}
+
+	*slot = *event;
+	spsc_ring_push(&shard->events);
+	shard->enqueued++;
+}
+
+//
+// This function handles a key that a node allocates for the context an event is addressed to. A stale context on the
+// key is removed on the shard that holds it, and the key is routed to the shard of the event
+//
+// Parameters:
+//  struct gtpc_event* event: The event
+//  u_int shard_id: The shard of the event
+//  u_int teid: The TEID of the key
+//  u_int peer: The peer of the key
+//
+void route_key(struct gtpc_event* event, u_int shard_id, u_int teid, u_int peer)
+{
+	event->route_teid = teid;
+	event->route_peer = peer;
+	event->route_sequence = 0;
+
+	struct gtpc_event purge = *event;
+	purge.type = EVENT_PURGE;
+
+	if (!threaded) {
+		dispatch_event(shard_id, &purge);
+		return;
+	}
+
+	struct gtpv1_context* route = gtpv1_context_find(route_table, teid, peer);
+	u_int home = home_shard(teid, peer);
+	dispatch_event(route != NULL ? route->shard : home, &purge);
+
+	if (shard_id == home) {
+		if (route != NULL) {
+			gtpv1_context_remove(route_table, route);
+		}
+		return;
+	}
+
+	if (route == NULL) {
+		route = gtpv1_context_add(route_table, teid, peer, GTPV1_CONTEXT_NEVER);
+		if (route == NULL) {
+			return;
+		}
+		gtpv1_context_set_expiry(route_table, route, GTPV1_CONTEXT_NEVER);
+	}
+
+	// A new sequence on every route means notices sent for the key before this event do not remove the route
+	route->shard = shard_id;
+	route->sequence = event->sequence;
+	event->route_sequence = route->sequence;
+}
+
+//
+// This function routes a GTP-C message to the shard that holds its context. Messages are addressed with the TEID of
+// the receiver except primary Create PDP Context Requests, which are routed on the TEID the SGSN allocated
+//
+// Parameters:
+//  struct gtpc_event* event: The message
+//
+void route_event(struct gtpc_event* event)
+{
+	struct gtpc_message* message = &event->message;
+	u_int shard_id;
+
+	if (event->message_type == GTPV1_MT_CREATE_PDP_CONTEXT_REQUEST && event->teid == 0 && message->has_teidc) {
+		shard_id = route_shard(message->teidc, event->source);
+
+		// A request on a key that was routed away from its home shard adds the key again on that shard
+		if (threaded && shard_id != home_shard(message->teidc, event->source)) {
+			struct gtpv1_context* route = gtpv1_context_find(route_table, message->teidc, event->source);
+			route->sequence = event->sequence;
+			event->route_teid = message->teidc;
+			event->route_peer = event->source;
+			event->route_sequence = route->sequence;
+		}
+	}
+	else {
+		shard_id = route_shard(event->teid, event->destination);
+	}
+
+	// Keys that the sender allocates for its side of a context go to the shard of the context
+	if (event->message_type == GTPV1_MT_CREATE_PDP_CONTEXT_RESPONSE && GTPV1_CAUSE_ACCEPTED(message->cause) && message->has_teidc) {
+		route_key(event, shard_id, message->teidc, event->source);
+	}
+	else if (event->message_type == GTPV1_MT_UPDATE_PDP_CONTEXT_REQUEST && message->has_teidc) {
+		route_key(event, shard_id, message->teidc, event->source);
+	}
+
+	dispatch_event(shard_id, event);
+}
+
+//
+// This function decodes a GTP V1 message into an event
+//
+// Parameters:
+//  const struct pcap_pkthdr* header: A pointer to the header of the packet
+//  const unsigned char* data: A pointer to the packet data
+//  struct gtpv1hdr* gtpv1hdr: The GTP V1 header in the packet
+//  struct gtpc_event* event: The event, its message is filled in
+//
+// Return:
+//  int: 1 if the message is used in correlation, 0 otherwise
+//
+int decode_gtpv1_message(const struct pcap_pkthdr* header, const unsigned char* data, struct gtpv1hdr* gtpv1hdr, struct gtpc_event* event)
+{
+	if (gtpv1hdr->message_type < GTPV1_MT_CREATE_PDP_CONTEXT_REQUEST || gtpv1hdr->message_type > GTPV1_MT_DELETE_PDP_CONTEXT_RESPONSE) {
+		return 0;
+	}
+
+	event->message_type = gtpv1hdr->message_type;
+	event->teid = ntohl(gtpv1hdr->teid);
+
+	struct gtp_ie_found found[CORRELATION_IE_COUNT];
+	gtpv1_ie_find(gtpv1hdr, header->caplen - ((u_char*)gtpv1hdr - data), &gtpv1_correlation_ies, found);
+
+	struct gtpc_message* message = &event->message;
+	u_char* gtpv1_message = (u_char*)gtpv1hdr;
+
+	if (found[CORRELATION_IE_IMSI].offset != 0) {
+		// The IMSI is a fixed length information element, its type is the octet before the body
+		tbcd2str(gtpv1_message + found[CORRELATION_IE_IMSI].offset, found[CORRELATION_IE_IMSI].length, message->imsi, sizeof(message->imsi));
+	}
+	if (found[CORRELATION_IE_CAUSE].offset != 0) {
+		message->cause = gtpv1_message[found[CORRELATION_IE_CAUSE].offset];
+	}
+	if (found[CORRELATION_IE_TEIDC].offset != 0) {
+		message->has_teidc = 1;
+		message->teidc = gtp_ie_read32(gtpv1_message + found[CORRELATION_IE_TEIDC].offset);
+	}
+	if (found[CORRELATION_IE_NSAPI].offset != 0) {
+		message->nsapi = gtpv1_message[found[CORRELATION_IE_NSAPI].offset] & 0x0f;
+	}
+	if (found[CORRELATION_IE_TEARDOWN].offset != 0) {
+		message->teardown = gtpv1_message[found[CORRELATION_IE_TEARDOWN].offset] & 0x01;
+	}
+
+	// The body of the end user address is the PDP type and then the address
+	if (found[CORRELATION_IE_EUA].length >= GTPV1_EUA_NO_ADDRESS_LENGTH + GTPV1_EUA_IPV4_LENGTH) {
+		message->has_eua = 1;
+		memcpy(&message->eua, gtpv1_message + found[CORRELATION_IE_EUA].offset + GTPV1_EUA_NO_ADDRESS_LENGTH, GTPV1_EUA_IPV4_LENGTH);
+	}
+
+	return 1;
+}
+
+//
+// This function gets the GTP V1 cause with the same meaning in correlation as a GTP V2 cause
+//
+// Parameters:
+//  int cause: The GTP V2 cause
+//
+// Return:
+//  int: The GTP V1 cause
+//
+int gtpv2_cause_to_gtpv1(int cause)
+{
+	if (GTPV2_CAUSE_ACCEPTED(cause)) {
+		return GTPV1_CAUSE_REQUEST_ACCEPTED;
+	}
+	else if (cause == GTPV2_CAUSE_CONTEXT_NOT_FOUND) {
+		return GTPV1_CAUSE_NON_EXISTENT;
+	}
+
+	return GTPV1_CAUSE_SYSTEM_FAILURE;
+}
+
+//
+// This function decodes a GTP V2 message into an event. A session is correlated in the same way as a PDP context, a
+// Create Session is handled as a Create PDP Context, a Modify Bearer as an Update PDP Context and a Delete Session as
+// a Delete PDP Context, and the event carries the GTP V1 message type and cause with the same meaning. The sender
+// F-TEID for the control plane is the control plane TEID, the PDN address allocation is the end user address and the
+// EPS bearer ID of the default bearer stands for the NSAPI
+//
+// Parameters:
+//  const struct pcap_pkthdr* header: A pointer to the header of the packet
+//  const unsigned char* data: A pointer to the packet data
+//  struct gtpv2hdr* gtpv2hdr: The GTP V2 header in the packet
+//  struct gtpc_event* event: The event, its message is filled in
+//
+// Return:
+//  int: 1 if the message is used in correlation, 0 otherwise
+//
+int decode_gtpv2_message(const struct pcap_pkthdr* header, const unsigned char* data, struct gtpv2hdr* gtpv2hdr, struct gtpc_event* event)
+{
+	switch (gtpv2hdr->message_type) {
+	case GTPV2_MT_CREATE_SESSION_REQUEST:
+		event->message_type = GTPV1_MT_CREATE_PDP_CONTEXT_REQUEST;
+		break;
+	case GTPV2_MT_CREATE_SESSION_RESPONSE:
+		event->message_type = GTPV1_MT_CREATE_PDP_CONTEXT_RESPONSE;
+		break;
+	case GTPV2_MT_MODIFY_BEARER_REQUEST:
+		event->message_type = GTPV1_MT_UPDATE_PDP_CONTEXT_REQUEST;
+		break;
+	case GTPV2_MT_MODIFY_BEARER_RESPONSE:
+		event->message_type = GTPV1_MT_UPDATE_PDP_CONTEXT_RESPONSE;
+		break;
+	case GTPV2_MT_DELETE_SESSION_REQUEST:
+		event->message_type = GTPV1_MT_DELETE_PDP_CONTEXT_REQUEST;
+		break;
+	case GTPV2_MT_DELETE_SESSION_RESPONSE:
+		event->message_type = GTPV1_MT_DELETE_PDP_CONTEXT_RESPONSE;
+		break;
+	default:
+		return 0;
+	}
+
+	// Session messages always carry a TEID, it is zero on the request that creates the session
+	if (!gtpv2hdr->flag_teid) {
+		return 0;
+	}
+	event->teid = gtpv2_get_teid(gtpv2hdr);
+
+	struct gtp_ie_found found[CORRELATION_IE_COUNT];
+	gtpv2_ie_find(gtpv2hdr, header->caplen - ((u_char*)gtpv2hdr - data), &gtpv2_correlation_ies, found);
+
+	struct gtpc_message* message = &event->message;
+	u_char* gtpv2_message = (u_char*)gtpv2hdr;
+
+	if (found[CORRELATION_IE_IMSI].offset != 0) {
+		tbcd2str(gtpv2_message + found[CORRELATION_IE_IMSI].offset, found[CORRELATION_IE_IMSI].length, message->imsi, sizeof(message->imsi));
+	}
+	if (found[CORRELATION_IE_CAUSE].length >= 1) {
+		message->cause = gtpv2_cause_to_gtpv1(gtpv2_message[found[CORRELATION_IE_CAUSE].offset]);
+	}
+	if (found[CORRELATION_IE_TEIDC].length >= GTPV2_F_TEID_LENGTH) {
+		message->has_teidc = 1;
+		message->teidc = gtp_ie_read32(gtpv2_message + found[CORRELATION_IE_TEIDC].offset + 1);
+	}
+
+	// The linked EPS bearer ID of a Delete Session Request
+	if (found[CORRELATION_IE_NSAPI].length >= 1) {
+		message->nsapi = gtpv2_message[found[CORRELATION_IE_NSAPI].offset] & 0x0f;
+	}
+
+	// The default bearer of a new session is the first bearer context to be created
+	if (event->message_type == GTPV1_MT_CREATE_PDP_CONTEXT_REQUEST && message->nsapi < 0 && found[CORRELATION_IE_BEARER_CONTEXT].offset != 0) {
+		struct gtp_ie bearer_context = {
+			.type = GTPV2_IE_BEARER_CONTEXT,
+			.length = found[CORRELATION_IE_BEARER_CONTEXT].length,
+			.body = gtpv2_message + found[CORRELATION_IE_BEARER_CONTEXT].offset
+		};
+
+		struct gtp_ie_iterator iterator;
+		struct gtp_ie ie;
+		gtpv2_ie_iterator_init_grouped(&iterator, &bearer_context);
+		while (gtpv2_ie_next(&iterator, &ie)) {
+			if (ie.type == GTPV2_IE_EBI && ie.instance == 0 && ie.length >= 1) {
+				message->nsapi = ie.body[0] & 0x0f;
+				break;
 			}
 		}
+	}
 
-		if (ie == GTPV1_IE_END_USER_ADDRESS) {
-			struct gtpv1_eua* euap = (struct gtpv1_eua*)(((unsigned char*)gtpv1hdr) + offset);
+	// The address is all zeros in requests for a dynamic address
+	u_int paa_length = found[CORRELATION_IE_EUA].length;
+	u_char* paa = gtpv2_message + found[CORRELATION_IE_EUA].offset;
+	if (paa_length >= 1 + GTPV2_PAA_IPV4_LENGTH && GTPV2_PAA_PDN_TYPE(paa[0]) == GTPV2_PAA_PDN_TYPE_IPV4) {
+		memcpy(&message->eua, paa + 1, GTPV2_PAA_IPV4_LENGTH);
+	}
+	else if (paa_length >= 1 + GTPV2_PAA_IPV6_LENGTH + GTPV2_PAA_IPV4_LENGTH && GTPV2_PAA_PDN_TYPE(paa[0]) == GTPV2_PAA_PDN_TYPE_IPV4V6) {
+		memcpy(&message->eua, paa + 1 + GTPV2_PAA_IPV6_LENGTH, GTPV2_PAA_IPV4_LENGTH);
+	}
+	message->has_eua = message->eua != 0;
 
-			if (GTPV1_EUA_LENGTH(euap->length) > GTPV1_EUA_NO_ADDRESS_LENGTH) {
-				printf("%lu,%u,", header->ts.tv_sec, header->ts.tv_usec);
+	return 1;
+}
 
-				for (int i = 0; i < GTPV1_EUA_IPV4_LENGTH; i++) {
-					if (i > 0) {
-						printf(".");
-					}
-					printf ("%d", euap->address.ipv4.address[i]);
-				}
+//
+// This function decodes a GTP-C packet of either version and correlates its message
+//
+// Parameters:
+//  unsigned char* notused: Not used
+//  const struct pcap_pkthdr* header: A pointer to the header of the packet
+//  const unsigned char* data: A pointer to the packet data
+//
+void decode_gtp_packet(unsigned char* notused, const struct pcap_pkthdr* header, const unsigned char* data)
+{
+	// Hold the message and the information elements used in correlation
+	struct gtpc_event event;
+	memset(&event, 0, sizeof(event));
+	event.message.cause = -1;
+	event.message.nsapi = -1;
 
-				if (gtpv1hdr->message_type == GTPV1_MT_CREATE_PDP_CONTEXT_RESPONSE) {
-					for (int i = 0; i < IMSI_MAP_SIZE; i++) {
-						if (imsi_map[i] == ntohl(gtpv1hdr->teid)) {
-							printf(",%s", imsi_array[i]);
-							imsi_map[i] = 0;
-							break;
-						}
-					}
-				}
-				printf("\n");
+	struct gtpv1hdr* gtpv1hdr = gtpv1_get_header(pcap_linktype, header->caplen, data);
+	if (gtpv1hdr != NULL) {
+		if (!decode_gtpv1_message(header, data, gtpv1hdr, &event)) {
+			return;
+		}
+	}
+	else {
+		struct gtpv2hdr* gtpv2hdr = gtpv2_get_header(pcap_linktype, header->caplen, data);
+		if (gtpv2hdr == NULL || !decode_gtpv2_message(header, data, gtpv2hdr, &event)) {
+			return;
+		}
+	}
+
+	struct ip* ip_header = gtpv1_get_ip_header(pcap_linktype, header->caplen, data);
+
+	event.sequence = ++packet_sequence;
+	event.ts = header->ts;
+	event.type = EVENT_MESSAGE;
+	event.source = ip_header->ip_src.s_addr;
+	event.destination = ip_header->ip_dst.s_addr;
+
+	route_event(&event);
+	if (threaded) {
+		// Every event for this packet is on a shard ring
+		__sync_synchronize();
+		dispatched_sequence = event.sequence;
+
+		read_route_notices();
+	}
+
+	if (snapshot_path == NULL) {
+		return;
+	}
+
+	snapshot_time = header->ts.tv_sec;
+	if (next_snapshot == 0) {
+		next_snapshot = snapshot_time + SNAPSHOT_INTERVAL;
+	}
+	else if (snapshot_time >= next_snapshot) {
+		write_snapshot();
+		next_snapshot = snapshot_time + SNAPSHOT_INTERVAL;
+	}
+}
+
+//
+// This function gets the shard a context in a snapshot is loaded on. Both entries of an established context go to the
+// home shard of the lower of their keys, and a pending new side goes with the context it is linked to, so every
+// context is whole on one shard
+//
+// Parameters:
+//  struct gtpv1_context_table* loaded: The contexts in the snapshot
+//  struct gtpv1_context* context: The context
+//
+// Return:
+//  u_int: The shard
+//
+u_int snapshot_shard(struct gtpv1_context_table* loaded, struct gtpv1_context* context)
+{
+	if (context->state == GTPV1_CONTEXT_UPDATE_PENDING) {
+		struct gtpv1_context* receiver = gtpv1_context_find(loaded, context->link_teid, context->link_peer);
+		if (receiver == NULL || receiver->state != GTPV1_CONTEXT_ACTIVE) {
+			return home_shard(context->teid, context->peer);
+		}
+		context = receiver;
+	}
+
+	if (context->state == GTPV1_CONTEXT_ACTIVE) {
+		struct gtpv1_context* linked = gtpv1_context_find(loaded, context->link_teid, context->link_peer);
+		if (linked != NULL && linked->link_teid == context->teid && linked->link_peer == context->peer
+				&& (linked->teid < context->teid || (linked->teid == context->teid && linked->peer < context->peer))) {
+			context = linked;
+		}
+	}
+
+	return home_shard(context->teid, context->peer);
+}
+
+//
+// This function loads the contexts in the snapshot file onto the shards, it is called before the shard threads start.
+// Contexts that are not on their home shard are routed to the shard they are loaded on
+//
+// Parameters:
+//  int live: Set if capturing live, pending requests are then checked against the current time rather than the
+//            time of the snapshot
+//
+void load_snapshot(int live)
+{
+	char errbuf[GTPV1_SNAPSHOT_ERRBUF_SIZE];
+	size_t size;
+
+	// There is no snapshot on the first run
+	if (access(snapshot_path, F_OK) != 0) {
+		return;
+	}
+
+	struct gtpv1_snapshot_header* header = gtpv1_snapshot_map(snapshot_path, &size, errbuf);
+	if (header == NULL) {
+		fprintf(stderr, "could not load snapshot %s, starting without it: %s\n", snapshot_path, errbuf);
+		return;
+	}
+
+	struct gtpv1_snapshot_record* records = (struct gtpv1_snapshot_record*)((char*)header + header->header_size);
+	time_t now = live ? time(NULL) : (time_t)header->time;
+	u_int loaded_count = 0;
+
+	// Without shards the contexts are loaded straight into the table, otherwise the contexts are looked up first
+	// to find the shard of each one
+	struct gtpv1_context_table* loaded = shards[0].table;
+	if (threaded) {
+		loaded = gtpv1_context_table_open(IMSI_TIMEOUT);
+		if (loaded == NULL) {
+			fprintf(stderr, "could not load snapshot %s, starting without it: out of memory\n", snapshot_path);
+			gtpv1_snapshot_unmap(header, size);
+			return;
+		}
+	}
+
+	for (u_int i = 0; i < header->record_count; i++) {
+		if (records[i].expiry != GTPV1_CONTEXT_NEVER && records[i].expiry <= now) {
+			continue;
+		}
+		if (gtpv1_context_restore(loaded, &records[i]) != NULL) {
+			loaded_count++;
+		}
+	}
+
+	for (u_int i = 0; threaded && i < header->record_count; i++) {
+		struct gtpv1_context* context = gtpv1_context_find(loaded, records[i].teid, records[i].peer);
+		if (context == NULL) {
+			continue;
+		}
+
+		u_int shard_id = snapshot_shard(loaded, context);
+		context = gtpv1_context_restore(shards[shard_id].table, &records[i]);
+		if (context == NULL || shard_id == home_shard(records[i].teid, records[i].peer)) {
+			continue;
+		}
+
+		struct gtpv1_context* route = gtpv1_context_add(route_table, records[i].teid, records[i].peer, GTPV1_CONTEXT_NEVER);
+		if (route == NULL) {
+			continue;
+		}
+		gtpv1_context_set_expiry(route_table, route, GTPV1_CONTEXT_NEVER);
+		route->shard = shard_id;
+		route->sequence = ++packet_sequence;
+		context->sequence = route->sequence;
+	}
+
+	if (threaded) {
+		gtpv1_context_table_close(loaded);
+	}
+
+	// Expire the requests that time out between the snapshot and the first packet
+	for (u_int i = 0; i < shard_count; i++) {
+		shards[i].table->wheel_time = header->time;
+	}
+
+	fprintf(stderr, "loaded %u contexts from snapshot %s, discarded %u timed out requests\n", loaded_count, snapshot_path,
+			header->record_count - loaded_count);
+	snapshot_time = header->time;
+	gtpv1_snapshot_unmap(header, size);
+}
+
+//
+// This function writes the contexts of all shards to the snapshot file. Shard threads are let finish the events on
+// their rings first, the reader is not putting events on the rings so the tables do not change while they are saved
+//
+void write_snapshot(void)
+{
+	// Take notices while waiting so that no shard waits on the reader
+	for (u_int i = 0; threaded && i < shard_count; i++) {
+		while (shards[i].processed != shards[i].enqueued) {
+			if (read_route_notices() == 0) {
+				usleep(SHARD_IDLE_WAIT);
 			}
 		}
+	}
+	__sync_synchronize();
 
-		offset += gtpv1_information_elements[ie].header_length + body_length;
+	struct gtpv1_snapshot_record* record_sets[MAX_SHARDS];
+	u_int record_counts[MAX_SHARDS];
+	char errbuf[GTPV1_SNAPSHOT_ERRBUF_SIZE];
 
-		// We have processed all Information elements
-		if (offset >= sizeof(struct gtpv1hdr) + ntohs(gtpv1hdr->length)) {
-			break;
+	u_int record_count = 0;
+	for (u_int i = 0; i < shard_count; i++) {
+		record_count += shards[i].table->count;
+	}
+
+	struct gtpv1_snapshot_record* records = (struct gtpv1_snapshot_record*) malloc((record_count + 1) * sizeof(struct gtpv1_snapshot_record));
+	if (records == NULL) {
+		fprintf(stderr, "could not write snapshot %s: out of memory\n", snapshot_path);
+		return;
+	}
+
+	record_count = 0;
+	for (u_int i = 0; i < shard_count; i++) {
+		record_sets[i] = records + record_count;
+		record_counts[i] = gtpv1_context_save(shards[i].table, record_sets[i]);
+		record_count += record_counts[i];
+	}
+
+	if (!gtpv1_snapshot_write(snapshot_path, record_sets, record_counts, shard_count, snapshot_time, errbuf)) {
+		fprintf(stderr, "could not write snapshot %s: %s\n", snapshot_path, errbuf);
+	}
+
+	free(records);
+}
+
+//
+// This function stops the capture on a signal, the final snapshot is written once the capture loop returns
+//
+// Parameters:
+//  int signal_number: The signal
+//
+void stop_capture(int signal_number)
+{
+	// A second signal ends the program without waiting for the snapshot
+	signal(signal_number, SIG_DFL);
+
+	if (pcap_handle != NULL) {
+		pcap_breakloop(pcap_handle);
+	}
+}
+
+//
+// This function opens the correlation shards and, if correlation is threaded, starts the shard and writer threads
+//
+// Parameters:
+//  pthread_t* writer_thread: The writer thread is returned here
+//  int live: Set if capturing live
+//
+// Return:
+//  int: 1 if the shards were opened, 0 otherwise
+//
+int open_shards(pthread_t* writer_thread, int live)
+{
+	shards = (struct correlation_shard*) calloc(shard_count, sizeof(struct correlation_shard));
+	if (shards == NULL) {
+		return 0;
+	}
+
+	for (u_int i = 0; i < shard_count; i++) {
+		shards[i].id = i;
+		shards[i].table = gtpv1_context_table_open(IMSI_TIMEOUT);
+		if (shards[i].table == NULL) {
+			return 0;
 		}
 	}
+
+	if (threaded) {
+		route_table = gtpv1_context_table_open(IMSI_TIMEOUT);
+		if (route_table == NULL) {
+			return 0;
+		}
+	}
+
+	// The snapshot is loaded before the shard threads start
+	if (snapshot_path != NULL) {
+		load_snapshot(live);
+	}
+
+	if (!threaded) {
+		return 1;
+	}
+
+	for (u_int i = 0; i < shard_count; i++) {
+		gtpv1_context_set_remove_handler(shards[i].table, shard_context_removed, &shards[i]);
+
+		if (!spsc_ring_open(&shards[i].events, SHARD_RING_SIZE, sizeof(struct gtpc_event))
+				|| !spsc_ring_open(&shards[i].output, SHARD_RING_SIZE, sizeof(struct gtpc_output))
+				|| !spsc_ring_open(&shards[i].notices, SHARD_RING_SIZE, sizeof(struct gtpc_route_notice))) {
+			return 0;
+		}
+
+		if (pthread_create(&shards[i].thread, NULL, shard_run, &shards[i]) != 0) {
+			return 0;
+		}
+	}
+
+	return pthread_create(writer_thread, NULL, writer_run, NULL) == 0;
+}
+
+//
+// This function waits for the shard and writer threads to finish, writes the final snapshot and closes the correlation shards
+//
+// Parameters:
+//  pthread_t writer_thread: The writer thread
+//
+void close_shards(pthread_t writer_thread)
+{
+	if (threaded) {
+		__sync_synchronize();
+		reader_done = 1;
+
+		for (u_int i = 0; i < shard_count; i++) {
+			pthread_join(shards[i].thread, NULL);
+		}
+		pthread_join(writer_thread, NULL);
+	}
+
+	if (snapshot_path != NULL) {
+		write_snapshot();
+	}
+
+	if (threaded) {
+		for (u_int i = 0; i < shard_count; i++) {
+			spsc_ring_close(&shards[i].events);
+			spsc_ring_close(&shards[i].output);
+			spsc_ring_close(&shards[i].notices);
+		}
+		gtpv1_context_table_close(route_table);
+	}
+
+	for (u_int i = 0; i < shard_count; i++) {
+		gtpv1_context_table_close(shards[i].table);
+	}
+	free(shards);
 }
 
 int main(int argc, char** argv)
 {
-	// Set up GTP V1 message types and information elements
-	init_gtpv1();
+	u_char gtpv1_types[CORRELATION_IE_COUNT] = {
+			GTPV1_IE_IMSI, GTPV1_IE_CAUSE, GTPV1_IE_TEI_CONTROL_PLANE, GTPV1_IE_NSAPI, GTPV1_IE_END_USER_ADDRESS, GTPV1_IE_TEARDOWN_IND, 0
+	};
+	u_char gtpv2_types[CORRELATION_IE_COUNT] = {
+			GTPV2_IE_IMSI, GTPV2_IE_CAUSE, GTPV2_IE_F_TEID, GTPV2_IE_EBI, GTPV2_IE_PAA, 0, GTPV2_IE_BEARER_CONTEXT
+	};
+	gtp_ie_set_init(&gtpv1_correlation_ies, gtpv1_types, CORRELATION_IE_COUNT);
+	gtp_ie_set_init(&gtpv2_correlation_ies, gtpv2_types, CORRELATION_IE_COUNT);
+
+	char* interface_name = NULL;
+	char* file_name = NULL;
 
-	// Initialize the IMSI array
-	for (unsigned long long i = 0; i < IMSI_MAP_SIZE; i++) {
-		imsi_map[i] = 0;
-		imsi_array[i][0] = '\0';
+	// Check arguments
+	int opt;
+	while ((opt = getopt(argc, argv, "t:s:i:f:")) != -1) {
+		switch (opt) {
+		case 't':
+			threaded = 1;
+			shard_count = atoi(optarg);
+			break;
+		case 's':
+			snapshot_path = optarg;
+			break;
+		case 'i':
+			interface_name = optarg;
+			break;
+		case 'f':
+			file_name = optarg;
+			break;
+		default:
+			shard_count = 0;
+			break;
+		}
 	}
 
-	if (argc != 3) {
-		fprintf(stderr, "usage: %s -i|-f pcap_file_name\n", argv[0]);
+	if (shard_count < 1 || shard_count > MAX_SHARDS || (interface_name == NULL) == (file_name == NULL) || optind != argc) {
+		fprintf(stderr, "usage: %s [-t shards] [-s snapshot_file] -i|-f pcap_file_name\n", argv[0]);
+		fprintf(stderr, "  with -t, correlation is spread over 1 to %d shard threads\n", MAX_SHARDS);
+		fprintf(stderr, "  with -s, contexts are loaded from the snapshot file at startup and saved to it every %d seconds and on exit\n", SNAPSHOT_INTERVAL);
 		return 1;
 	}
 
+	// Initialize the correlation shards
+	pthread_t writer_thread;
+	if (!open_shards(&writer_thread, interface_name != NULL)) {
+		fprintf(stderr, "could not open %u correlation shards\n", shard_count);
+		return 2;
+	}
+
 	char pcap_errbuf[PCAP_ERRBUF_SIZE];
-	pcap_t* pcap_handle = NULL;
 
-	if (!strcmp(argv[1], "-i")) {
-		pcap_handle = pcap_open_live(argv[2], PCAP_MAX_SNAPLEN, PCAP_PROMISCUOUS, PCAP_TIMEOUT, pcap_errbuf);
-	}
-	else if (!strcmp(argv[1], "-f")) {
-		pcap_handle = pcap_open_offline(argv[2], pcap_errbuf);
+	if (interface_name != NULL) {
+		pcap_handle = pcap_open_live(interface_name, PCAP_MAX_SNAPLEN, PCAP_PROMISCUOUS, PCAP_TIMEOUT, pcap_errbuf);
 	}
 	else {
-		fprintf(stderr, "invalid argument %s\n", argv[1]);
-		return 1;
+		pcap_handle = pcap_open_offline(file_name, pcap_errbuf);
 	}
 
 	if (pcap_handle == NULL) {
 		fprintf(stderr, "decode failed: %s\n", pcap_errbuf);
+		close_shards(writer_thread);
 		return 2;
 	}
+	pcap_linktype = pcap_datalink(pcap_handle);
+
+	signal(SIGINT, stop_capture);
+	signal(SIGTERM, stop_capture);
 
 	pcap_loop(pcap_handle, -1, decode_gtp_packet, NULL);
+	pcap_close(pcap_handle);
+	pcap_handle = NULL;
 
+	close_shards(writer_thread);
 	return 0;
 }
-
@@ -25,6 +25,9 @@
 // Define PCAP handles
 pcap_dumper_t* pcap_dumper = NULL;
 
+// The link layer type of the input file
+int pcap_linktype = DLT_EN10MB;
+
 // Define old and new IP addresses
 struct in_addr old_ip;
 struct in_addr new_ip;
@@ -49,6 +52,7 @@ int main(int argc, char** argv) {
 		fprintf(stderr, "capture start failed on file %s: %s\n", argv[1], pcap_errbuf);
 		return 4;
 	}
+	pcap_linktype = pcap_datalink(pcap_handle);
 
 	// Open packet dumping on the standard output
 	pcap_dumper = pcap_dump_open(pcap_handle, argv[2]);
@@ -89,7 +93,7 @@ void pcap_packet_handler(unsigned char* pcap_param, const struct pcap_pkthdr* he
 	new_header.ts     = header->ts;
 
 	// Untunnel the packet
-	pcapsession_untunnel_packet(NULL, &new_header, data);
+	pcapsession_untunnel_packet(NULL, pcap_linktype, &new_header, data);
 
 	// Dump the packet
 	pcap_dump((unsigned char*)pcap_dumper, &new_header, data);
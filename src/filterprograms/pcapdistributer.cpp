@@ -104,6 +104,9 @@ int main(int argc, char *argv[])
 	pthread_t supervision_thread;
 	char* capture_location;
 	char live_str[FILENAME_MAX], capture_location_str[FILENAME_MAX], port_str[FILENAME_MAX], iterations_str[FILENAME_MAX];
+	char cache_str[FILENAME_MAX] = "";
+	char speed_str[FILENAME_MAX] = "", packet_rate_str[FILENAME_MAX] = "", bit_rate_str[FILENAME_MAX] = "";
+	char tail_str[FILENAME_MAX] = "", journal_str[FILENAME_MAX] = "";
 	char config_str[MAX_MESSAGE_BODY_SIZE];
 	MagicStringTester licenceTester;
 
@@ -124,6 +127,9 @@ int main(int argc, char *argv[])
 	// Register signals with signal handler
 	register_signals_with_shutdown(sighandler);
 
+	// Publish monitor statistics for pcapstat, monitors fall back to private memory if this fails
+	monitor_stats_open("pcapdistributer");
+
 	// Get the configuration file name
 	int cfg_file_length = get_config_file_path(pcap_dist_cfg_file, argv[2]);
 	write_to_syslog("configuration file name is : %s\n", pcap_dist_cfg_file);
@@ -139,11 +145,71 @@ int main(int argc, char *argv[])
 	get_property(LIVE_CAPTURE_PROPERTY, live_str);
 	get_property(FILE_CAPTURE_ITERATIONS_PROPERTY, iterations_str);
 
+	// The replay cache property is optional, every iteration is read from the files if it is not set
+	if (get_property(FILE_CAPTURE_CACHE_PROPERTY, cache_str) < 0) {
+		cache_str[0] = '\0';
+	}
+
+	// The pacing properties are optional, at most one may be set, packets are sent as fast as they are read if none is
+	if (get_property(FILE_CAPTURE_SPEED_PROPERTY, speed_str) < 0) {
+		speed_str[0] = '\0';
+	}
+	if (get_property(FILE_CAPTURE_PACKET_RATE_PROPERTY, packet_rate_str) < 0) {
+		packet_rate_str[0] = '\0';
+	}
+	if (get_property(FILE_CAPTURE_BIT_RATE_PROPERTY, bit_rate_str) < 0) {
+		bit_rate_str[0] = '\0';
+	}
+
+	// The tail properties are optional, the directory is not watched for new files if tail is not set
+	if (get_property(FILE_CAPTURE_TAIL_PROPERTY, tail_str) < 0) {
+		tail_str[0] = '\0';
+	}
+	if (get_property(FILE_CAPTURE_JOURNAL_PROPERTY, journal_str) < 0) {
+		journal_str[0] = '\0';
+	}
+
 	capture_location = capture_location_str;
 	strip_char_from_string(capture_location, '\\');
+	strip_char_from_string(journal_str, '\\');
 	int live = atoi(live_str);
 	int distribution_port = atoi(port_str);
 	int iterations = atoi(iterations_str);
+	unsigned long cache_mb = strtoul(cache_str, NULL, 10);
+	int tail = atoi(tail_str);
+
+	pcapsession_pacing_t pacing;
+	memset(&pacing, 0, sizeof(pcapsession_pacing_t));
+	pacing.mode = PCAP_SESSION_PACING_OFF;
+	int pacing_count = 0;
+	if (atof(speed_str) > 0) {
+		pacing.mode = PCAP_SESSION_PACING_TIMED;
+		pacing.speed = atof(speed_str);
+		pacing_count++;
+	}
+	if (atof(packet_rate_str) > 0) {
+		pacing.mode = PCAP_SESSION_PACING_PACKET_RATE;
+		pacing.rate = atof(packet_rate_str);
+		pacing_count++;
+	}
+	if (atof(bit_rate_str) > 0) {
+		pacing.mode = PCAP_SESSION_PACING_BIT_RATE;
+		pacing.rate = atof(bit_rate_str);
+		pacing_count++;
+	}
+	if (pacing_count > 1) {
+		write_to_syslog("only one of %s, %s and %s may be set\n",
+				FILE_CAPTURE_SPEED_PROPERTY, FILE_CAPTURE_PACKET_RATE_PROPERTY, FILE_CAPTURE_BIT_RATE_PROPERTY);
+		exit(1);
+	}
+
+	// A tailed directory streams each file once and runs until it is stopped, so files are not iterated or cached, the
+	// file capture properties do not apply to live capture
+	if (!live && tail && (cache_mb > 0 || iterations != PCAP_SESSION_ITERATE_INFINITY)) {
+		write_to_syslog("%s may not be set with %s, and %s must be %d with it\n",
+				FILE_CAPTURE_CACHE_PROPERTY, FILE_CAPTURE_TAIL_PROPERTY, FILE_CAPTURE_ITERATIONS_PROPERTY, PCAP_SESSION_ITERATE_INFINITY);
+		exit(1);
+	}
 
 	// Check the port number is valid
 	if (distribution_port < 1 || distribution_port > HIGHEST_IP_PORT) {
@@ -180,10 +246,18 @@ int main(int argc, char *argv[])
 			exit(1);
 		}
 	}
+	else if (tail) {
+		// Kick off directory packet capture of the files in the directory and the files completed in it from now on
+		write_to_syslog( "starting directory tail packet capture\n");
+		if (!pcapsession_filecapture_open_tail(capture_location, journal_str[0] != '\0' ? journal_str : NULL, &pacing)) {
+			write_to_syslog( "failed to start directory tail packet capture\n");
+			exit(1);
+		}
+	}
 	else {
 		// Kick off directory packet capture
 		write_to_syslog( "starting directory packet capture\n");
-		if (!pcapsession_filecapture_open(capture_location, iterations)) {
+		if (!pcapsession_filecapture_open(capture_location, iterations, cache_mb, &pacing)) {
 			write_to_syslog( "failed to start directory packet capture\n");
 			exit(1);
 		}
@@ -217,7 +291,8 @@ static void sighandler(int sig)
 
 	write_to_syslog("server termination ordered: signal=%d\n", sig);
 	pcapsession_handling_close();
-	closelog();
+	monitor_stats_close();
+	close_logger();
 }
 
 /**
@@ -0,0 +1,508 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: pcapextract.c
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This program extracts the records of a time range from a PCAP file into a new PCAP file. The time index written
+ * next to the PCAP file by pcapmerger or chunkpcapfile is binary searched for the first segment of records that can
+ * hold the start of the range, segments entirely inside the range are copied in the kernel with copy_file_range() or
+ * sendfile() and only the records of segments at the edges of the range are read. Records after the last whole entry
+ * of the index, as in a file still being written, or of a file without an index are read one by one
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/sendfile.h>
+#include <pcap/pcap.h>
+
+#include <pcapdefines.h>
+#include <pcapsession.h>
+
+// The size of the buffers records are read into
+#define PCAPEXTRACT_BUFFER_SIZE 0x100000
+
+// The magic number of PCAP files with microsecond time stamps
+#define PCAPEXTRACT_MAGIC 0xa1b2c3d4
+
+// The ways of copying records, each is tried in turn until one works for the input and output files
+#define PCAPEXTRACT_COPY_FILE_RANGE 0  // Copy in the kernel, sharing blocks on file systems that support it
+#define PCAPEXTRACT_SENDFILE        1  // Copy in the kernel, also to pipes
+#define PCAPEXTRACT_READ_WRITE      2  // Copy through a buffer
+
+// The input and output files
+int in_fd = -1;
+int out_fd = -1;
+off_t in_size = 0;
+int in_swapped = 0;
+
+// The time range to extract in microseconds since the epoch, the end is not included
+int64_t start_usec = 0;
+int64_t end_usec = 0;
+
+// The range of the input file waiting to be copied, contiguous records are copied together
+off_t copy_offset = 0;
+off_t copy_length = 0;
+int copy_method = PCAPEXTRACT_COPY_FILE_RANGE;
+
+// The amount of record data extracted
+unsigned long long extracted = 0;
+
+// The buffers that records are scanned in and copied through
+unsigned char scan_buffer[PCAPEXTRACT_BUFFER_SIZE];
+unsigned char copy_buffer[PCAPEXTRACT_BUFFER_SIZE];
+
+// Forward references for private functions
+int pcapextract_parse_time(const char* text, int64_t* usec);
+struct pcapsession_index_entry* pcapextract_load_index(const char* file_name, struct pcapsession_index_header* index_header, size_t* count);
+int pcapextract_check_entry(const struct pcapsession_index_entry* entry);
+int pcapextract_scan(off_t offset, off_t limit);
+int pcapextract_copy(off_t offset, off_t length);
+int pcapextract_flush(void);
+int pcapextract_write(const void* data, size_t length);
+
+int main(int argc, char** argv) {
+	char* index_file = NULL;
+	int usage = 0;
+
+	// Check arguments
+	int opt;
+	while ((opt = getopt(argc, argv, "i:")) != -1) {
+		switch (opt) {
+		case 'i':
+			index_file = optarg;
+			break;
+		default:
+			usage = 1;
+			break;
+		}
+	}
+
+	if (usage || argc - optind != 4) {
+		fprintf(stderr, "usage: %s [-i index_file] in_file out_file start_time end_time\n", argv[0]);
+		fprintf(stderr, "  copies the records of in_file time stamped from start_time up to but not including end_time to out_file\n");
+		fprintf(stderr, "  times are in seconds since the epoch with an optional fraction, such as 1700000000.25\n");
+		fprintf(stderr, "  the time index is read from in_file%s unless -i is given\n", PCAP_INDEX_FILE_TYPE);
+		fprintf(stderr, "  if out_file is specified as -, then standard output is used\n");
+		return 2;
+	}
+
+	char* in_file = argv[optind];
+	char* out_file = argv[optind + 1];
+
+	if (!pcapextract_parse_time(argv[optind + 2], &start_usec) || !pcapextract_parse_time(argv[optind + 3], &end_usec)) {
+		fprintf(stderr, "times %s and %s are not valid\n", argv[optind + 2], argv[optind + 3]);
+		return 3;
+	}
+
+	// The input must be a regular file so that it can be read at any offset
+	struct stat in_stat;
+	in_fd = open(in_file, O_RDONLY);
+	if (in_fd < 0 || fstat(in_fd, &in_stat) != 0 || !S_ISREG(in_stat.st_mode)) {
+		fprintf(stderr, "extract failed on file %s: not a readable regular file\n", in_file);
+		return 4;
+	}
+	in_size = in_stat.st_size;
+
+	struct pcap_file_header file_header;
+	if (pread(in_fd, &file_header, sizeof(struct pcap_file_header), 0) != sizeof(struct pcap_file_header) ||
+			(file_header.magic != PCAPEXTRACT_MAGIC && file_header.magic != __builtin_bswap32(PCAPEXTRACT_MAGIC))) {
+		fprintf(stderr, "extract failed on file %s: not a PCAP file with microsecond time stamps\n", in_file);
+		return 4;
+	}
+	in_swapped = file_header.magic != PCAPEXTRACT_MAGIC;
+
+	if (strcmp(out_file, "-") == 0) {
+		out_fd = STDOUT_FILENO;
+	}
+	else {
+		out_fd = open(out_file, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	}
+	if (out_fd < 0 || !pcapextract_write(&file_header, sizeof(struct pcap_file_header))) {
+		fprintf(stderr, "dump start failed on file %s\n", out_file);
+		return 5;
+	}
+
+	// Load the time index, without one the whole file is scanned
+	char index_file_name[FILENAME_MAX];
+	if (index_file == NULL) {
+		snprintf(index_file_name, FILENAME_MAX, "%s%s", in_file, PCAP_INDEX_FILE_TYPE);
+		index_file = index_file_name;
+	}
+
+	struct pcapsession_index_header index_header;
+	memset(&index_header, 0, sizeof(struct pcapsession_index_header));
+	size_t count = 0;
+	struct pcapsession_index_entry* entries = pcapextract_load_index(index_file, &index_header, &count);
+	if (entries == NULL) {
+		fprintf(stderr, "no time index in file %s, scanning all of %s\n", index_file, in_file);
+	}
+
+	// Only the entries that chain from the start of the file and whose records are all in the file are used
+	off_t indexed_end = sizeof(struct pcap_file_header);
+	size_t valid = 0;
+	while (valid < count && entries[valid].offset == (uint64_t)indexed_end && entries[valid].offset + entries[valid].length <= (uint64_t)in_size) {
+		indexed_end += entries[valid].length;
+		valid++;
+	}
+
+	// An index written for another file is detected by the first records of its first and last segments
+	if (valid != 0 && (!pcapextract_check_entry(&entries[0]) || !pcapextract_check_entry(&entries[valid - 1]))) {
+		fprintf(stderr, "time index in file %s does not match %s, scanning all of %s\n", index_file, in_file, in_file);
+		indexed_end = sizeof(struct pcap_file_header);
+		valid = 0;
+	}
+
+	// The running maximum time stamp never decreases, so the first segment that can hold the start of the range is
+	// the first whose running maximum reaches it
+	size_t low = 0;
+	size_t high = valid;
+	while (low < high) {
+		size_t middle = low + (high - low) / 2;
+		if (entries[middle].running_max_usec < start_usec) {
+			low = middle + 1;
+		}
+		else {
+			high = middle;
+		}
+	}
+
+	int result = 1;
+	int done = 0;
+	for (size_t i = low; i < valid && result; i++) {
+		const struct pcapsession_index_entry* entry = &entries[i];
+
+		// In a file in time stamp order no later segment can hold records in the range
+		if (index_header.sorted && entry->min_usec >= end_usec) {
+			done = 1;
+			break;
+		}
+
+		if (entry->max_usec < start_usec || entry->min_usec >= end_usec) {
+			continue;
+		}
+
+		// An index that does not match its file is abandoned and the rest of the file is scanned
+		if (!pcapextract_check_entry(entry)) {
+			fprintf(stderr, "time index in file %s does not match %s at offset %llu, scanning the rest of the file\n",
+					index_file, in_file, (unsigned long long)entry->offset);
+			indexed_end = entry->offset;
+			break;
+		}
+
+		if (entry->min_usec >= start_usec && entry->max_usec < end_usec) {
+			result = pcapextract_copy(entry->offset, entry->length);
+		}
+		else {
+			result = pcapextract_scan(entry->offset, entry->offset + entry->length);
+		}
+	}
+
+	// Scan the records that are not indexed
+	if (result && !done) {
+		result = pcapextract_scan(indexed_end, in_size);
+	}
+
+	if (result) {
+		result = pcapextract_flush();
+	}
+
+	free(entries);
+	close(in_fd);
+	if (out_fd != STDOUT_FILENO) {
+		close(out_fd);
+	}
+
+	if (!result) {
+		fprintf(stderr, "extract failed writing file %s: %s\n", out_file, strerror(errno));
+		return 5;
+	}
+
+	fprintf(stderr, "extracted %llu octets of records from %s\n", extracted, in_file);
+	return 0;
+}
+
+//
+// This function parses a time given as seconds since the epoch with an optional decimal fraction
+//
+// Parameters:
+//  const char* text: The time
+//  int64_t* usec: The time in microseconds since the epoch is returned here
+//
+// Return:
+//  int: 1 if the time is valid, 0 otherwise
+//
+int pcapextract_parse_time(const char* text, int64_t* usec)
+{
+	char* end;
+	errno = 0;
+	long long seconds = strtoll(text, &end, 10);
+	if (end == text || errno != 0 || seconds < 0) {
+		return 0;
+	}
+
+	// Digits after the sixth decimal place are ignored
+	int64_t fraction = 0;
+	int digits = 0;
+	if (*end == '.') {
+		for (end++; isdigit((unsigned char)*end); end++) {
+			if (digits < 6) {
+				fraction = fraction * 10 + (*end - '0');
+				digits++;
+			}
+		}
+	}
+	for (; digits < 6; digits++) {
+		fraction *= 10;
+	}
+
+	*usec = (int64_t)seconds * 1000000 + fraction;
+	return *end == '\0';
+}
+
+//
+// This function loads a time index file
+//
+// Parameters:
+//  const char* file_name: The name of the time index file
+//  struct pcapsession_index_header* index_header: The header of the index is returned here
+//  size_t* count: The number of entries is returned here
+//
+// Return:
+//  struct pcapsession_index_entry*: The entries of the index, to be freed by the caller, NULL if the file cannot be
+//                                   read or is not a time index
+//
+struct pcapsession_index_entry* pcapextract_load_index(const char* file_name, struct pcapsession_index_header* index_header, size_t* count)
+{
+	FILE* index_file = fopen(file_name, "r");
+	if (index_file == NULL) {
+		return NULL;
+	}
+
+	struct stat index_stat;
+	if (fstat(fileno(index_file), &index_stat) != 0 ||
+			fread(index_header, sizeof(struct pcapsession_index_header), 1, index_file) != 1 ||
+			memcmp(index_header->magic, PCAP_INDEX_MAGIC, sizeof(PCAP_INDEX_MAGIC)) != 0 ||
+			index_header->version != PCAP_INDEX_VERSION) {
+		fclose(index_file);
+		return NULL;
+	}
+
+	// A partly written entry at the end of an index still being written is ignored
+	size_t entry_count = (index_stat.st_size - sizeof(struct pcapsession_index_header)) / sizeof(struct pcapsession_index_entry);
+	struct pcapsession_index_entry* entries = malloc((entry_count + 1) * sizeof(struct pcapsession_index_entry));
+	if (entries == NULL) {
+		fclose(index_file);
+		return NULL;
+	}
+
+	*count = fread(entries, sizeof(struct pcapsession_index_entry), entry_count, index_file);
+	fclose(index_file);
+	return entries;
+}
+
+//
+// This function checks that the first record of a segment of the time index is in the PCAP file
+//
+// Parameters:
+//  const struct pcapsession_index_entry* entry: The entry of the segment
+//
+// Return:
+//  int: 1 if the record at the offset of the segment has the time stamp of its first record, 0 otherwise
+//
+int pcapextract_check_entry(const struct pcapsession_index_entry* entry)
+{
+	uint32_t record_header[PCAP_RECORD_HEADER_SIZE / sizeof(uint32_t)];
+	if (pread(in_fd, record_header, PCAP_RECORD_HEADER_SIZE, entry->offset) != PCAP_RECORD_HEADER_SIZE) {
+		return 0;
+	}
+
+	for (int i = 0; in_swapped && i < PCAP_RECORD_HEADER_SIZE / sizeof(uint32_t); i++) {
+		record_header[i] = __builtin_bswap32(record_header[i]);
+	}
+
+	return (int64_t)(int32_t)record_header[0] * 1000000 + (int32_t)record_header[1] == entry->first_usec;
+}
+
+//
+// This function reads the records between two offsets of the input file and copies those in the time range, reading
+// stops early at a record that runs past the end
+//
+// Parameters:
+//  off_t offset: The offset of the first record
+//  off_t limit: The offset after the last record
+//
+// Return:
+//  int: 1 if the records were copied, 0 if writing the output failed
+//
+int pcapextract_scan(off_t offset, off_t limit)
+{
+	while (offset + PCAP_RECORD_HEADER_SIZE <= limit) {
+		off_t wanted = limit - offset < PCAPEXTRACT_BUFFER_SIZE ? limit - offset : PCAPEXTRACT_BUFFER_SIZE;
+		ssize_t length = pread(in_fd, scan_buffer, wanted, offset);
+		if (length <= 0) {
+			return 1;
+		}
+
+		size_t position = 0;
+		while (position + PCAP_RECORD_HEADER_SIZE <= (size_t)length) {
+			uint32_t record_header[PCAP_RECORD_HEADER_SIZE / sizeof(uint32_t)];
+			memcpy(record_header, scan_buffer + position, PCAP_RECORD_HEADER_SIZE);
+			for (int i = 0; in_swapped && i < PCAP_RECORD_HEADER_SIZE / sizeof(uint32_t); i++) {
+				record_header[i] = __builtin_bswap32(record_header[i]);
+			}
+
+			// A record that does not fit in the rest of the buffer is read again at the start of the next one
+			size_t record_length = PCAP_RECORD_HEADER_SIZE + record_header[2];
+			if (position + record_length > (size_t)length) {
+				break;
+			}
+
+			int64_t usec = (int64_t)(int32_t)record_header[0] * 1000000 + (int32_t)record_header[1];
+			if (usec >= start_usec && usec < end_usec && !pcapextract_copy(offset + position, record_length)) {
+				return 0;
+			}
+
+			position += record_length;
+		}
+
+		// Stop at a record too long for the buffer or cut off at the limit
+		if (position == 0) {
+			return 1;
+		}
+		offset += position;
+	}
+
+	return 1;
+}
+
+//
+// This function adds a range of the input file to the output, ranges that follow on from each other are copied
+// together
+//
+// Parameters:
+//  off_t offset: The offset of the range
+//  off_t length: The length of the range
+//
+// Return:
+//  int: 1 if the range was added, 0 if writing the output failed
+//
+int pcapextract_copy(off_t offset, off_t length)
+{
+	extracted += length;
+
+	if (copy_length != 0 && copy_offset + copy_length == offset) {
+		copy_length += length;
+		return 1;
+	}
+
+	if (!pcapextract_flush()) {
+		return 0;
+	}
+
+	copy_offset = offset;
+	copy_length = length;
+	return 1;
+}
+
+//
+// This function copies the range of the input file waiting to be copied to the output, in the kernel if the input and
+// output files allow it
+//
+// Return:
+//  int: 1 if the range was copied, 0 if writing the output failed
+//
+int pcapextract_flush(void)
+{
+	while (copy_length > 0) {
+		ssize_t copied;
+
+		if (copy_method == PCAPEXTRACT_COPY_FILE_RANGE) {
+			loff_t in_offset = copy_offset;
+			copied = copy_file_range(in_fd, &in_offset, out_fd, NULL, copy_length, 0);
+			if (copied < 0 && (errno == EXDEV || errno == EINVAL || errno == EBADF || errno == ENOSYS || errno == EOPNOTSUPP)) {
+				copy_method = PCAPEXTRACT_SENDFILE;
+				continue;
+			}
+		}
+		else if (copy_method == PCAPEXTRACT_SENDFILE) {
+			off_t in_offset = copy_offset;
+			copied = sendfile(out_fd, in_fd, &in_offset, copy_length);
+			if (copied < 0 && (errno == EINVAL || errno == ENOSYS)) {
+				copy_method = PCAPEXTRACT_READ_WRITE;
+				continue;
+			}
+		}
+		else {
+			size_t wanted = copy_length < PCAPEXTRACT_BUFFER_SIZE ? copy_length : PCAPEXTRACT_BUFFER_SIZE;
+			copied = pread(in_fd, copy_buffer, wanted, copy_offset);
+			if (copied > 0 && !pcapextract_write(copy_buffer, copied)) {
+				return 0;
+			}
+		}
+
+		if (copied < 0 && errno == EINTR) {
+			continue;
+		}
+
+		// The input file cannot have shrunk below a range that was read from it
+		if (copied <= 0) {
+			if (copied == 0) {
+				errno = EIO;
+			}
+			return 0;
+		}
+
+		copy_offset += copied;
+		copy_length -= copied;
+	}
+
+	return 1;
+}
+
+//
+// This function writes data to the output
+//
+// Parameters:
+//  const void* data: The data
+//  size_t length: The length of the data
+//
+// Return:
+//  int: 1 if the data was written, 0 otherwise
+//
+int pcapextract_write(const void* data, size_t length)
+{
+	const unsigned char* position = data;
+
+	while (length > 0) {
+		ssize_t written = write(out_fd, position, length);
+		if (written < 0 && errno == EINTR) {
+			continue;
+		}
+		if (written <= 0) {
+			return 0;
+		}
+
+		position += written;
+		length -= written;
+	}
+
+	return 1;
+}
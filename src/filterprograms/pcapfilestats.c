@@ -13,99 +13,818 @@
  * Author: LMI/LXR/SH Liam Fallon
  ************************************************************************/
 
+/**
+ * This program gathers statistics on a set of PCAP files: packet and byte counts, the first and last time stamps, the
+ * split of packets into GTP V1 signalling, GTP-U, GTP V2 signalling and other traffic, the count of each GTP message
+ * type and histograms of packet sizes and of the times between packets. Files and the PCAP files in directories are
+ * shared out over a pool of threads, each of which memory maps the files it reads, and the statistics of all files
+ * are written as one JSON or CSV report
+ */
+
+#include <dirent.h>
+#include <fcntl.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <pcap/pcap.h>
 #include <netinet/ip.h>
 #include <arpa/inet.h>
 
 #include <gtpv1.h>
+#include <gtpv1_message_types.h>
+#include <gtpv2.h>
+#include <gtpv2_message_types.h>
+#include <gtp_classify.h>
+#include <monitor.h>
 #include <pcapdefines.h>
 #include <pcapsession.h>
 
-// Forward references for private functions
-void pcap_packet_handler(unsigned char* pcap_param, const struct pcap_pkthdr* header, const unsigned char* data);
-void print_pcap_stats();
+// The largest number of threads
+#define FILESTATS_MAX_THREADS 64
+
+// The magic numbers of PCAP files with microsecond and nanosecond time stamps and the version that is memory mapped
+#define FILESTATS_MAGIC 0xa1b2c3d4
+#define FILESTATS_MAGIC_NSEC 0xa1b23c4d
+#define FILESTATS_VERSION_MAJOR 2
+#define FILESTATS_VERSION_MINOR 4
+#define FILESTATS_FILE_HEADER_SIZE 24
+
+// Records longer than this are taken as a sign of a corrupt file
+#define FILESTATS_MAX_CAPLEN 0x40000
+
+// The report formats
+#define FILESTATS_FORMAT_JSON 0
+#define FILESTATS_FORMAT_CSV  1
+
+// The classes of packets
+#define FILESTATS_CLASS_GTPV1_C 0
+#define FILESTATS_CLASS_GTPV1_U 1
+#define FILESTATS_CLASS_GTPV2_C 2
+#define FILESTATS_CLASS_OTHER   3
+#define FILESTATS_CLASSES       4
 
-// Hold the file name
-char * file_name;
+// The outcome of reading a file
+#define FILESTATS_FILE_OK        0
+#define FILESTATS_FILE_FAILED    1  // The file could not be opened as a PCAP file
+#define FILESTATS_FILE_TRUNCATED 2  // The file ends in a partial or corrupt record
 
-// Variables to hold statistics
-unsigned long long packet_count = 0;
-unsigned long long byte_count   = 0;
-struct timeval first_timestamp;
-struct timeval last_timestamp;
+// The size of the buffer a time stamp is formatted in
+#define FILESTATS_TIME_SIZE 256
+
+//
+// The statistics of a file or of a set of files
+//
+struct filestats {
+	unsigned long long files;                                  // The number of files read
+	unsigned long long files_failed;                           // The number of files that could not be opened
+	unsigned long long files_truncated;                        // The number of files that end in a partial record
+	unsigned long long packets;                                // The number of packets
+	unsigned long long bytes;                                  // The length of the packets on the wire
+	unsigned long long captured_bytes;                         // The length of the packets as captured
+	struct timeval first_timestamp;                            // The earliest first time stamp of a file
+	struct timeval last_timestamp;                             // The latest last time stamp of a file
+	unsigned long long class_packets[FILESTATS_CLASSES];       // The number of packets of each class
+	unsigned long long class_bytes[FILESTATS_CLASSES];         // The length of the packets of each class
+	unsigned long long gtpv1_types[MAX_GTPV1_MESSAGE_TYPES];   // The number of GTP V1 messages of each type
+	unsigned long long gtpv2_types[MAX_GTPV2_MESSAGE_TYPES];   // The number of GTP V2 messages of each type
+	unsigned long long sizes[MONITOR_HISTOGRAM_BUCKETS];       // The histogram of the lengths of the packets
+	unsigned long long gaps[MONITOR_HISTOGRAM_BUCKETS];        // The histogram of the microseconds between packets
+	unsigned long long gap_count;                              // The number of times between packets
+	unsigned long long gap_total;                              // The sum of the times between packets
+	long long gap_min;                                         // The shortest time between packets
+	long long gap_max;                                         // The longest time between packets
+	unsigned long long out_of_order;                           // The number of packets earlier than the one before
+	long long last_usec;                                       // While reading a file, the time stamp of its last packet
+};
+
+//
+// The summary of a file in the report
+//
+struct filestats_file {
+	char* name;                                                // The name of the file
+	int status;                                                // One of the FILESTATS_FILE_ values
+	unsigned long long packets;                                // The number of packets
+	unsigned long long bytes;                                  // The length of the packets on the wire
+	struct timeval first_timestamp;                            // The time stamp of the first packet
+	struct timeval last_timestamp;                             // The time stamp of the last packet
+};
+
+//
+// The state of reading a file through libpcap
+//
+struct filestats_reader {
+	struct filestats* stats;                                   // The statistics of the file
+	int linktype;                                              // The link layer type of the file
+};
+
+// The names of the classes of packets in the report
+const char* const class_names[FILESTATS_CLASSES] = {"gtpv1_c", "gtpv1_u", "gtpv2_c", "other"};
+
+// The files to read, the next file to read is handed out under the lock
+struct filestats_file* files = NULL;
+size_t file_count = 0;
+size_t file_size = 0;
+size_t next_file = 0;
+pthread_mutex_t filestats_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// The statistics of all files, each thread adds its totals here when it is done
+struct filestats total_stats;
+
+// The report format
+int format = FILESTATS_FORMAT_JSON;
+
+// Forward references for private functions
+int filestats_add_path(char* path, int explicit);
+void* filestats_thread(void* notused);
+int filestats_read_file(const char* file_name, struct filestats* stats);
+int filestats_map_file(const char* file_name, struct filestats* stats);
+void pcap_packet_handler(unsigned char* pcap_param, const struct pcap_pkthdr* header, const unsigned char* data);
+void filestats_merge(struct filestats* total, const struct filestats* stats);
+void print_pcap_stats(const char* file_name, const struct filestats* stats);
+void filestats_write_json(void);
+void filestats_write_csv(void);
+void filestats_write_json_string(const char* text);
+void filestats_write_csv_string(const char* text);
 
 int main(int argc, char** argv) {
+	int usage = 0;
+	long thread_count = sysconf(_SC_NPROCESSORS_ONLN);
+
 	// Check arguments
-	if (argc != 2) {
-		fprintf(stderr, "usage: %s in_file\n", argv[0]);
-		fprintf(stderr, "  if in_file is specified as -, then standard input/standard output is used\n");
+	int opt;
+	while ((opt = getopt(argc, argv, "j:f:")) != -1) {
+		switch (opt) {
+		case 'j':
+			thread_count = atol(optarg);
+			usage |= thread_count < 1;
+			break;
+		case 'f':
+			if (!strcmp(optarg, "json")) {
+				format = FILESTATS_FORMAT_JSON;
+			}
+			else if (!strcmp(optarg, "csv")) {
+				format = FILESTATS_FORMAT_CSV;
+			}
+			else {
+				usage = 1;
+			}
+			break;
+		default:
+			usage = 1;
+			break;
+		}
+	}
+
+	if (usage || optind == argc) {
+		fprintf(stderr, "usage: %s [-j threads] [-f json|csv] in_file|directory...\n", argv[0]);
+		fprintf(stderr, "  if in_file is specified as -, then standard input is used\n");
+		fprintf(stderr, "  the %s files in directories and their subdirectories are read\n", PCAP_FILE_TYPE);
+		fprintf(stderr, "  -j reads files on this many threads, the default is the number of processors, at most %d\n", FILESTATS_MAX_THREADS);
+		fprintf(stderr, "  -f is the format of the report written to standard output, the default is json\n");
+		return 1;
+	}
+
+	for (int i = optind; i < argc; i++) {
+		if (!filestats_add_path(argv[i], 1)) {
+			return 1;
+		}
+	}
+
+	if (thread_count > FILESTATS_MAX_THREADS) {
+		thread_count = FILESTATS_MAX_THREADS;
+	}
+	if ((size_t)thread_count > file_count) {
+		thread_count = file_count;
+	}
+
+	memset(&total_stats, 0, sizeof(struct filestats));
+
+	// Read the files on the pool of threads
+	pthread_t threads[FILESTATS_MAX_THREADS];
+	long started = 0;
+	while (started < thread_count && pthread_create(&threads[started], NULL, filestats_thread, NULL) == 0) {
+		started++;
+	}
+	if (started < thread_count) {
+		fprintf(stderr, "could only start %ld of %ld threads\n", started, thread_count);
+	}
+
+	// The files are read on this thread if no thread started
+	if (started == 0) {
+		filestats_thread(NULL);
+	}
+	for (int i = 0; i < started; i++) {
+		pthread_join(threads[i], NULL);
+	}
+
+	if (format == FILESTATS_FORMAT_JSON) {
+		filestats_write_json();
+	}
+	else {
+		filestats_write_csv();
+	}
+
+	for (size_t i = 0; i < file_count; i++) {
+		free(files[i].name);
+	}
+	free(files);
+
+	return total_stats.files_failed != 0 ? 2 : 0;
+}
+
+//
+// This function adds a file to the files to read, or the PCAP files in a directory and its subdirectories
+//
+// Parameters:
+//  char* path: The name of the file or directory
+//  int explicit: 1 if the path was given on the command line, so a file is read whatever its name
+//
+// Return:
+//  int: 1 if the path was added, 0 if memory ran out
+//
+int filestats_add_path(char* path, int explicit)
+{
+	struct stat path_stat;
+	if (strcmp(path, "-") && stat(path, &path_stat) == 0 && S_ISDIR(path_stat.st_mode)) {
+		// The entries of a directory are read in name order so that reports of the same directory are alike
+		struct dirent** entries;
+		int entry_count = scandir(path, &entries, NULL, alphasort);
+		if (entry_count < 0) {
+			fprintf(stderr, "could not read directory %s\n", path);
+			return 1;
+		}
+
+		int added = 1;
+		for (int i = 0; i < entry_count; i++) {
+			if (added && strcmp(entries[i]->d_name, ".") && strcmp(entries[i]->d_name, "..")) {
+				char entry_path[FILENAME_MAX];
+				snprintf(entry_path, FILENAME_MAX, "%s/%s", path, entries[i]->d_name);
+				added = filestats_add_path(entry_path, 0);
+			}
+			free(entries[i]);
+		}
+		free(entries);
+
+		return added;
+	}
+
+	// Files found in directories are only read if they are PCAP files
+	size_t length = strlen(path);
+	if (!explicit && (length < strlen(PCAP_FILE_TYPE) || strcmp(path + length - strlen(PCAP_FILE_TYPE), PCAP_FILE_TYPE))) {
 		return 1;
 	}
 
-	file_name = argv[1];
+	if (file_count == file_size) {
+		size_t new_size = file_size ? file_size * 2 : 64;
+		struct filestats_file* new_files = realloc(files, new_size * sizeof(struct filestats_file));
+		if (new_files == NULL) {
+			fprintf(stderr, "could not allocate a list of %lu files\n", new_size);
+			return 0;
+		}
+		files = new_files;
+		file_size = new_size;
+	}
+
+	memset(&files[file_count], 0, sizeof(struct filestats_file));
+	files[file_count].name = strdup(path);
+	if (files[file_count].name == NULL) {
+		fprintf(stderr, "could not allocate a list of %lu files\n", file_size);
+		return 0;
+	}
+	file_count++;
+
+	return 1;
+}
+
+//
+// This function is the body of a thread of the pool, it reads files until there are none left and then adds the
+// statistics of all the files it read to the totals
+//
+// Parameters:
+//  void* notused: Not used
+//
+// Return:
+//  void*: NULL
+//
+void* filestats_thread(void* notused)
+{
+	struct filestats* thread_stats = calloc(1, sizeof(struct filestats));
+	struct filestats* stats = malloc(sizeof(struct filestats));
+	if (thread_stats == NULL || stats == NULL) {
+		fprintf(stderr, "could not allocate file statistics\n");
+		free(thread_stats);
+		free(stats);
+		return NULL;
+	}
+
+	while (1) {
+		pthread_mutex_lock(&filestats_mutex);
+		size_t index = next_file++;
+		pthread_mutex_unlock(&filestats_mutex);
+		if (index >= file_count) {
+			break;
+		}
+
+		struct filestats_file* file = &files[index];
+		file->status = filestats_read_file(file->name, stats);
+		file->packets = stats->packets;
+		file->bytes = stats->bytes;
+		file->first_timestamp = stats->first_timestamp;
+		file->last_timestamp = stats->last_timestamp;
+
+		if (file->status != FILESTATS_FILE_FAILED) {
+			print_pcap_stats(file->name, stats);
+		}
+		filestats_merge(thread_stats, stats);
+	}
+
+	pthread_mutex_lock(&filestats_mutex);
+	filestats_merge(&total_stats, thread_stats);
+	pthread_mutex_unlock(&filestats_mutex);
+
+	free(thread_stats);
+	free(stats);
+	return NULL;
+}
+
+//
+// This function adds a packet to the statistics of a file
+//
+// Parameters:
+//  struct filestats* stats: The statistics of the file
+//  int linktype: The link layer type of the file
+//  const struct pcap_pkthdr* header: A pointer to the header of the packet
+//  const unsigned char* data: A pointer to the packet data
+//
+static inline void filestats_add_packet(struct filestats* stats, int linktype, const struct pcap_pkthdr* header, const unsigned char* data)
+{
+	long long usec = (long long)header->ts.tv_sec * 1000000 + header->ts.tv_usec;
+
+	// This is the first packet, otherwise count the time since the packet before
+	if (stats->packets == 0) {
+		stats->first_timestamp.tv_sec  = header->ts.tv_sec;
+		stats->first_timestamp.tv_usec = header->ts.tv_usec;
+	}
+	else if (usec < stats->last_usec) {
+		stats->out_of_order++;
+	}
+	else {
+		long long gap = usec - stats->last_usec;
+		stats->gaps[monitor_histogram_bucket(gap)]++;
+		if (stats->gap_count == 0 || gap < stats->gap_min) {
+			stats->gap_min = gap;
+		}
+		if (gap > stats->gap_max) {
+			stats->gap_max = gap;
+		}
+		stats->gap_count++;
+		stats->gap_total += gap;
+	}
+
+	// Get last time stamp
+	stats->last_timestamp.tv_sec  = header->ts.tv_sec;
+	stats->last_timestamp.tv_usec = header->ts.tv_usec;
+	stats->last_usec = usec;
+
+	// Increment statistics
+	stats->packets++;
+	stats->bytes += header->len;
+	stats->captured_bytes += header->caplen;
+	stats->sizes[monitor_histogram_bucket(header->len)]++;
+
+	// Classify the packet, GTP V2 is only looked for in packets that are not GTP V1
+	int packet_class = FILESTATS_CLASS_OTHER;
+	struct gtp_class gtp_class;
+	const u_char* gtpv2hdr;
+	if (gtp_classify_packet(linktype, header->caplen, data, &gtp_class) != GTP_CLASS_NONE) {
+		u_char message_type = data[gtp_class.gtp_offset + 1];
+		packet_class = message_type == GTPV1_MT_G_PDU ? FILESTATS_CLASS_GTPV1_U : FILESTATS_CLASS_GTPV1_C;
+		stats->gtpv1_types[message_type]++;
+	}
+	else if ((gtpv2hdr = (const u_char*)gtpv2_get_header(linktype, header->caplen, data)) != NULL) {
+		// The message type is read as a byte as the header may not be aligned in a memory mapped file
+		packet_class = FILESTATS_CLASS_GTPV2_C;
+		stats->gtpv2_types[gtpv2hdr[1]]++;
+	}
+
+	stats->class_packets[packet_class]++;
+	stats->class_bytes[packet_class] += header->len;
+}
+
+//
+// This function reads a PCAP file and gathers its statistics, standard PCAP files are memory mapped and other files
+// are read through libpcap
+//
+// Parameters:
+//  const char* file_name: The name of the file, - for standard input
+//  struct filestats* stats: The statistics of the file are returned here
+//
+// Return:
+//  int: One of the FILESTATS_FILE_ values
+//
+int filestats_read_file(const char* file_name, struct filestats* stats)
+{
+	memset(stats, 0, sizeof(struct filestats));
+	stats->files = 1;
 
-	// Open PCAP file input from standard input
+	int status = filestats_map_file(file_name, stats);
+	if (status >= 0) {
+		stats->files_truncated = status == FILESTATS_FILE_TRUNCATED;
+		return status;
+	}
+
+	// Open PCAP file input
 	char pcap_errbuf[PCAP_ERRBUF_SIZE];
 	pcap_t* pcap_handle = pcap_open_offline(file_name, pcap_errbuf);
 	if (pcap_handle == NULL) {
 		fprintf(stderr, "capture start failed on file %s: %s\n", file_name, pcap_errbuf);
-		return 2;
+		stats->files_failed = 1;
+		return FILESTATS_FILE_FAILED;
 	}
 
 	// Handle the PCAP file packets
-	pcap_loop(pcap_handle, PCAP_INFINITE, pcap_packet_handler, NULL);
+	struct filestats_reader reader;
+	reader.stats = stats;
+	reader.linktype = pcap_datalink(pcap_handle);
+	status = pcap_loop(pcap_handle, PCAP_INFINITE, pcap_packet_handler, (unsigned char*)&reader) < 0 ? FILESTATS_FILE_TRUNCATED : FILESTATS_FILE_OK;
 
 	// Close pcap
 	pcap_close(pcap_handle);
 
-	print_pcap_stats();
+	stats->files_truncated = status == FILESTATS_FILE_TRUNCATED;
+	return status;
+}
+
+//
+// This function reads a PCAP file by memory mapping it, only regular files with the standard microsecond or
+// nanosecond PCAP header of version 2.4 in either byte order are mapped
+//
+// Parameters:
+//  const char* file_name: The name of the file
+//  struct filestats* stats: The statistics of the file are returned here
+//
+// Return:
+//  int: One of the FILESTATS_FILE_ values, -1 if the file was not mapped and must be read through libpcap
+//
+int filestats_map_file(const char* file_name, struct filestats* stats)
+{
+	int fd = open(file_name, O_RDONLY);
+	if (fd < 0) {
+		return -1;
+	}
+
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode) || file_stat.st_size < FILESTATS_FILE_HEADER_SIZE) {
+		close(fd);
+		return -1;
+	}
+
+	const unsigned char* data = mmap(NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED) {
+		return -1;
+	}
+	size_t size = file_stat.st_size;
+
+	uint32_t file_header[FILESTATS_FILE_HEADER_SIZE / sizeof(uint32_t)];
+	memcpy(file_header, data, FILESTATS_FILE_HEADER_SIZE);
+	int swapped = file_header[0] == __builtin_bswap32(FILESTATS_MAGIC) || file_header[0] == __builtin_bswap32(FILESTATS_MAGIC_NSEC);
+	int nanoseconds = file_header[0] == FILESTATS_MAGIC_NSEC || file_header[0] == __builtin_bswap32(FILESTATS_MAGIC_NSEC);
+	for (size_t i = 1; swapped && i < FILESTATS_FILE_HEADER_SIZE / sizeof(uint32_t); i++) {
+		file_header[i] = __builtin_bswap32(file_header[i]);
+	}
+
+	// The major and minor version are 16 bit fields in the first word after the magic number
+	unsigned int version = swapped ? (file_header[1] >> 16 | file_header[1] << 16) : file_header[1];
+	if ((!swapped && !nanoseconds && file_header[0] != FILESTATS_MAGIC) ||
+			version != (FILESTATS_VERSION_MAJOR | FILESTATS_VERSION_MINOR << 16)) {
+		munmap((void*)data, size);
+		return -1;
+	}
+	int linktype = file_header[5];
+
+	madvise((void*)data, size, MADV_SEQUENTIAL);
+
+	int status = FILESTATS_FILE_OK;
+	size_t offset = FILESTATS_FILE_HEADER_SIZE;
+	while (offset < size) {
+		uint32_t record_header[PCAP_RECORD_HEADER_SIZE / sizeof(uint32_t)];
+		if (offset + PCAP_RECORD_HEADER_SIZE > size) {
+			status = FILESTATS_FILE_TRUNCATED;
+			break;
+		}
+
+		memcpy(record_header, data + offset, PCAP_RECORD_HEADER_SIZE);
+		for (size_t i = 0; swapped && i < PCAP_RECORD_HEADER_SIZE / sizeof(uint32_t); i++) {
+			record_header[i] = __builtin_bswap32(record_header[i]);
+		}
+
+		if (record_header[2] > FILESTATS_MAX_CAPLEN || offset + PCAP_RECORD_HEADER_SIZE + record_header[2] > size) {
+			status = FILESTATS_FILE_TRUNCATED;
+			break;
+		}
+
+		// The time stamp is stored as signed 32 bit fields
+		struct pcap_pkthdr header;
+		header.ts.tv_sec = (int32_t)record_header[0];
+		header.ts.tv_usec = nanoseconds ? (int32_t)(record_header[1] / 1000) : (int32_t)record_header[1];
+		header.caplen = record_header[2];
+		header.len = record_header[3];
+
+		filestats_add_packet(stats, linktype, &header, data + offset + PCAP_RECORD_HEADER_SIZE);
+		offset += PCAP_RECORD_HEADER_SIZE + header.caplen;
+	}
+
+	munmap((void*)data, size);
+	return status;
 }
 
 //
 // This function is a PCAP packet handler callback method for packet
 //
 // Parameters:
-//  unsigned char* pcap_param: A pointer to user data set in the pcap_loop call, in this case it is not used
+//  unsigned char* pcap_param: A pointer to user data set in the pcap_loop call, in this case the reader of the file
 //  const struct pcap_pkthdr* header: A pointer to the header of the packet
 //  const unsigned char* data: A pointer to the packet data
 //
 void pcap_packet_handler(unsigned char* pcap_param, const struct pcap_pkthdr* header, const unsigned char* data)
 {
-	// This is the first packet
-	if (packet_count == 0) {
-		first_timestamp.tv_sec  = header->ts.tv_sec;
-		first_timestamp.tv_usec = header->ts.tv_usec;
+	struct filestats_reader* reader = (struct filestats_reader*)pcap_param;
+	filestats_add_packet(reader->stats, reader->linktype, header, data);
+}
+
+//
+// This function adds the statistics of a file or of a set of files to a total
+//
+// Parameters:
+//  struct filestats* total: The total
+//  const struct filestats* stats: The statistics to add
+//
+void filestats_merge(struct filestats* total, const struct filestats* stats)
+{
+	total->files += stats->files;
+	total->files_failed += stats->files_failed;
+	total->files_truncated += stats->files_truncated;
+
+	// The time span of the total covers the first and last packets of all files that have packets
+	if (stats->packets != 0) {
+		if (total->packets == 0 || timercmp(&stats->first_timestamp, &total->first_timestamp, <)) {
+			total->first_timestamp = stats->first_timestamp;
+		}
+		if (total->packets == 0 || timercmp(&stats->last_timestamp, &total->last_timestamp, >)) {
+			total->last_timestamp = stats->last_timestamp;
+		}
 	}
 
-	// Increment statistics
-	packet_count++;
-	byte_count += header->len;
+	total->packets += stats->packets;
+	total->bytes += stats->bytes;
+	total->captured_bytes += stats->captured_bytes;
 
-	// Get last time stamp
-	last_timestamp.tv_sec  = header->ts.tv_sec;
-	last_timestamp.tv_usec = header->ts.tv_usec;
+	for (int i = 0; i < FILESTATS_CLASSES; i++) {
+		total->class_packets[i] += stats->class_packets[i];
+		total->class_bytes[i] += stats->class_bytes[i];
+	}
+	for (int i = 0; i < MAX_GTPV1_MESSAGE_TYPES; i++) {
+		total->gtpv1_types[i] += stats->gtpv1_types[i];
+	}
+	for (int i = 0; i < MAX_GTPV2_MESSAGE_TYPES; i++) {
+		total->gtpv2_types[i] += stats->gtpv2_types[i];
+	}
+	for (int i = 0; i < MONITOR_HISTOGRAM_BUCKETS; i++) {
+		total->sizes[i] += stats->sizes[i];
+		total->gaps[i] += stats->gaps[i];
+	}
 
-	// Print statistics every 1,000,000 packets
-	if (packet_count % 1000000 == 0) {
-		print_pcap_stats();
+	if (stats->gap_count != 0) {
+		if (total->gap_count == 0 || stats->gap_min < total->gap_min) {
+			total->gap_min = stats->gap_min;
+		}
+		if (stats->gap_max > total->gap_max) {
+			total->gap_max = stats->gap_max;
+		}
 	}
+	total->gap_count += stats->gap_count;
+	total->gap_total += stats->gap_total;
+	total->out_of_order += stats->out_of_order;
 }
 
 //
-// This function prints packet capture statistics
+// This function prints the packet capture statistics of a file
 //
-void print_pcap_stats()
+// Parameters:
+//  const char* file_name: The name of the file
+//  const struct filestats* stats: The statistics of the file
+//
+void print_pcap_stats(const char* file_name, const struct filestats* stats)
 {
 	// Format start and end times to strings
-	char first_timestamp_string[256];
-	char last_timestamp_string[256];
+	char first_timestamp_string[FILESTATS_TIME_SIZE];
+	char last_timestamp_string[FILESTATS_TIME_SIZE];
+	struct tm timestamp_tm;
+
+	time_t first_sec = stats->first_timestamp.tv_sec;
+	localtime_r(&first_sec, &timestamp_tm);
+	strftime(first_timestamp_string, FILESTATS_TIME_SIZE, "%s_%Y-%m-%d_%H:%M:%S", &timestamp_tm);
 
-	struct tm* timestamp_tm = gmtime(&first_timestamp.tv_sec);
-	strftime(first_timestamp_string, 256, "%s_%Y-%m-%d_%H:%M:%S", timestamp_tm);
+	time_t last_sec = stats->last_timestamp.tv_sec;
+	localtime_r(&last_sec, &timestamp_tm);
+	strftime(last_timestamp_string, FILESTATS_TIME_SIZE, "%s_%Y-%m-%d_%H:%M:%S", &timestamp_tm);
 
-	timestamp_tm  = gmtime(&last_timestamp.tv_sec);
-	strftime(last_timestamp_string,  256, "%s_%Y-%m-%d_%H:%M:%S", timestamp_tm);
+	fprintf(stderr, "%s,pkts:%llu,bytes:%llu,start:%s.%06lu,end:%s.%06lu\n", file_name, stats->packets, stats->bytes, first_timestamp_string, stats->first_timestamp.tv_usec, last_timestamp_string, stats->last_timestamp.tv_usec);
+}
+
+//
+// This function writes the report as a JSON object
+//
+void filestats_write_json(void)
+{
+	const struct filestats* stats = &total_stats;
+	static const char* const status_names[] = {"ok", "failed", "truncated"};
+
+	printf("{\n");
+	printf("  \"files\": %llu,\n  \"files_failed\": %llu,\n  \"files_truncated\": %llu,\n", stats->files, stats->files_failed, stats->files_truncated);
+	printf("  \"packets\": %llu,\n  \"bytes\": %llu,\n  \"captured_bytes\": %llu,\n", stats->packets, stats->bytes, stats->captured_bytes);
+	printf("  \"first\": %ld.%06ld,\n  \"last\": %ld.%06ld,\n", (long)stats->first_timestamp.tv_sec, (long)stats->first_timestamp.tv_usec, (long)stats->last_timestamp.tv_sec, (long)stats->last_timestamp.tv_usec);
+
+	printf("  \"classes\": {");
+	for (int i = 0; i < FILESTATS_CLASSES; i++) {
+		printf("%s\n    \"%s\": {\"packets\": %llu, \"bytes\": %llu}", i ? "," : "", class_names[i], stats->class_packets[i], stats->class_bytes[i]);
+	}
+	printf("\n  },\n");
+
+	// Only the message types and histogram buckets that have packets are written
+	printf("  \"gtpv1_message_types\": [");
+	const char* separator = "";
+	for (int i = 0; i < MAX_GTPV1_MESSAGE_TYPES; i++) {
+		if (stats->gtpv1_types[i] != 0) {
+			printf("%s\n    {\"type\": %d, \"name\": ", separator, i);
+			filestats_write_json_string(gtpv1_message_type_name(i));
+			printf(", \"packets\": %llu}", stats->gtpv1_types[i]);
+			separator = ",";
+		}
+	}
+	printf("\n  ],\n");
+
+	printf("  \"gtpv2_message_types\": [");
+	separator = "";
+	for (int i = 0; i < MAX_GTPV2_MESSAGE_TYPES; i++) {
+		if (stats->gtpv2_types[i] != 0) {
+			printf("%s\n    {\"type\": %d, \"name\": ", separator, i);
+			filestats_write_json_string(gtpv2_message_type_name(i));
+			printf(", \"packets\": %llu}", stats->gtpv2_types[i]);
+			separator = ",";
+		}
+	}
+	printf("\n  ],\n");
+
+	printf("  \"sizes\": [");
+	separator = "";
+	for (int i = 0; i < MONITOR_HISTOGRAM_BUCKETS; i++) {
+		if (stats->sizes[i] != 0) {
+			printf("%s\n    {\"max\": %lld, \"packets\": %llu}", separator, monitor_histogram_value(i), stats->sizes[i]);
+			separator = ",";
+		}
+	}
+	printf("\n  ],\n");
+
+	printf("  \"inter_arrival_usec\": {\n    \"count\": %llu,\n    \"out_of_order\": %llu,\n", stats->gap_count, stats->out_of_order);
+	printf("    \"min\": %lld,\n    \"max\": %lld,\n    \"mean\": %.3f,\n", stats->gap_min, stats->gap_max, stats->gap_count ? (double)stats->gap_total / stats->gap_count : 0.0);
+	printf("    \"histogram\": [");
+	separator = "";
+	for (int i = 0; i < MONITOR_HISTOGRAM_BUCKETS; i++) {
+		if (stats->gaps[i] != 0) {
+			printf("%s\n      {\"max\": %lld, \"count\": %llu}", separator, monitor_histogram_value(i), stats->gaps[i]);
+			separator = ",";
+		}
+	}
+	printf("\n    ]\n  },\n");
+
+	printf("  \"per_file\": [");
+	for (size_t i = 0; i < file_count; i++) {
+		const struct filestats_file* file = &files[i];
+		printf("%s\n    {\"file\": ", i ? "," : "");
+		filestats_write_json_string(file->name);
+		printf(", \"status\": \"%s\", \"packets\": %llu, \"bytes\": %llu, \"first\": %ld.%06ld, \"last\": %ld.%06ld}", status_names[file->status], file->packets, file->bytes,
+				(long)file->first_timestamp.tv_sec, (long)file->first_timestamp.tv_usec, (long)file->last_timestamp.tv_sec, (long)file->last_timestamp.tv_usec);
+	}
+	printf("\n  ]\n}\n");
+}
+
+//
+// This function writes the report as CSV, with a row for each statistic giving its scope, which is total or the name
+// of a file, its name, a key for statistics that have more than one value and the value
+//
+void filestats_write_csv(void)
+{
+	const struct filestats* stats = &total_stats;
+	static const char* const status_names[] = {"ok", "failed", "truncated"};
+
+	printf("scope,statistic,key,value\n");
+	printf("total,files,,%llu\ntotal,files_failed,,%llu\ntotal,files_truncated,,%llu\n", stats->files, stats->files_failed, stats->files_truncated);
+	printf("total,packets,,%llu\ntotal,bytes,,%llu\ntotal,captured_bytes,,%llu\n", stats->packets, stats->bytes, stats->captured_bytes);
+	printf("total,first,,%ld.%06ld\ntotal,last,,%ld.%06ld\n", (long)stats->first_timestamp.tv_sec, (long)stats->first_timestamp.tv_usec, (long)stats->last_timestamp.tv_sec, (long)stats->last_timestamp.tv_usec);
+
+	for (int i = 0; i < FILESTATS_CLASSES; i++) {
+		printf("total,class_packets,%s,%llu\ntotal,class_bytes,%s,%llu\n", class_names[i], stats->class_packets[i], class_names[i], stats->class_bytes[i]);
+	}
+	for (int i = 0; i < MAX_GTPV1_MESSAGE_TYPES; i++) {
+		if (stats->gtpv1_types[i] != 0) {
+			printf("total,gtpv1_message_type,%d %s,%llu\n", i, gtpv1_message_type_name(i), stats->gtpv1_types[i]);
+		}
+	}
+	for (int i = 0; i < MAX_GTPV2_MESSAGE_TYPES; i++) {
+		if (stats->gtpv2_types[i] != 0) {
+			printf("total,gtpv2_message_type,%d %s,%llu\n", i, gtpv2_message_type_name(i), stats->gtpv2_types[i]);
+		}
+	}
+	for (int i = 0; i < MONITOR_HISTOGRAM_BUCKETS; i++) {
+		if (stats->sizes[i] != 0) {
+			printf("total,size,<=%lld,%llu\n", monitor_histogram_value(i), stats->sizes[i]);
+		}
+	}
 
-	fprintf(stderr, "%s,pkts:%llu,bytes:%llu,start:%s.%06lu,end:%s.%06lu\n", file_name, packet_count, byte_count, first_timestamp_string, first_timestamp.tv_usec, last_timestamp_string, last_timestamp.tv_usec);
+	printf("total,inter_arrival_usec_count,,%llu\ntotal,out_of_order,,%llu\n", stats->gap_count, stats->out_of_order);
+	printf("total,inter_arrival_usec_min,,%lld\ntotal,inter_arrival_usec_max,,%lld\n", stats->gap_min, stats->gap_max);
+	printf("total,inter_arrival_usec_mean,,%.3f\n", stats->gap_count ? (double)stats->gap_total / stats->gap_count : 0.0);
+	for (int i = 0; i < MONITOR_HISTOGRAM_BUCKETS; i++) {
+		if (stats->gaps[i] != 0) {
+			printf("total,inter_arrival_usec,<=%lld,%llu\n", monitor_histogram_value(i), stats->gaps[i]);
+		}
+	}
+
+	for (size_t i = 0; i < file_count; i++) {
+		const struct filestats_file* file = &files[i];
+		const char* statistics[] = {"status", "packets", "bytes", "first", "last"};
+		for (size_t j = 0; j < sizeof(statistics) / sizeof(statistics[0]); j++) {
+			filestats_write_csv_string(file->name);
+			printf(",%s,,", statistics[j]);
+			switch (j) {
+			case 0:
+				printf("%s\n", status_names[file->status]);
+				break;
+			case 1:
+				printf("%llu\n", file->packets);
+				break;
+			case 2:
+				printf("%llu\n", file->bytes);
+				break;
+			case 3:
+				printf("%ld.%06ld\n", (long)file->first_timestamp.tv_sec, (long)file->first_timestamp.tv_usec);
+				break;
+			case 4:
+				printf("%ld.%06ld\n", (long)file->last_timestamp.tv_sec, (long)file->last_timestamp.tv_usec);
+				break;
+			}
+		}
+	}
+}
+
+//
+// This function writes a string as a quoted JSON string
+//
+// Parameters:
+//  const char* text: The string
+//
+void filestats_write_json_string(const char* text)
+{
+	putchar('"');
+	for (const unsigned char* character = (const unsigned char*)text; *character != '\0'; character++) {
+		if (*character == '"' || *character == '\\') {
+			printf("\\%c", *character);
+		}
+		else if (*character < ' ') {
+			printf("\\u%04x", *character);
+		}
+		else {
+			putchar(*character);
+		}
+	}
+	putchar('"');
+}
+
+//
+// This function writes a string as a CSV field, the field is quoted if it holds a comma, a quote or a line break
+//
+// Parameters:
+//  const char* text: The string
+//
+void filestats_write_csv_string(const char* text)
+{
+	if (strpbrk(text, ",\"\r\n") == NULL) {
+		fputs(text, stdout);
+		return;
+	}
+
+	putchar('"');
+	for (const char* character = text; *character != '\0'; character++) {
+		if (*character == '"') {
+			putchar('"');
+		}
+		putchar(*character);
+	}
+	putchar('"');
 }
@@ -105,6 +105,7 @@ int main(int argc, char *argv[])
 {
 	pthread_t supervision_thread;
 	char untunnel_str[FILENAME_MAX], output_path_str[FILENAME_MAX];
+	char index_records_str[FILENAME_MAX] = "", index_interval_str[FILENAME_MAX] = "";
 	char config_str[MAX_MESSAGE_BODY_SIZE];
 	char host_values[MAX_ADDRESSES][FILENAME_MAX];
 	char port_values[MAX_ADDRESSES][FILENAME_MAX];
@@ -128,6 +129,9 @@ int main(int argc, char *argv[])
 	// Register signals with signal handler
 	register_signals_with_shutdown(sighandler);
 
+	// Publish monitor statistics for pcapstat, monitors fall back to private memory if this fails
+	monitor_stats_open("pcapmerger");
+
 	// Get the configuration file name
 	int cfg_file_length = get_config_file_path(pcap_merge_cfg_file, argv[2]);
 	write_to_syslog("configuration file name is : %s\n", pcap_merge_cfg_file);
@@ -144,7 +148,17 @@ int main(int argc, char *argv[])
 	get_property(UNTUNNEL_GTP_PROPERTY, untunnel_str);
 	get_property(OUTPUT_PATH_PROPERTY, output_path_str);
 
+	// The time index properties are optional, no time index is written if neither is set
+	if (get_property(INDEX_RECORDS_PROPERTY, index_records_str) < 0) {
+		index_records_str[0] = '\0';
+	}
+	if (get_property(INDEX_INTERVAL_PROPERTY, index_interval_str) < 0) {
+		index_interval_str[0] = '\0';
+	}
+
 	int untunnel = atoi(untunnel_str);
+	unsigned long index_records = strtoul(index_records_str, NULL, 10);
+	unsigned long index_msec = strtoul(index_interval_str, NULL, 10);
 	strip_char_from_string(output_path_str, '\\');
 
 	// Get the host and port properties
@@ -153,7 +167,7 @@ int main(int argc, char *argv[])
 
 	// Sanity check that host and port counts are the same
 	if (host_length != port_length) {
-		write_to_syslog( "unmatched number of distribution server hosts %d and ports %d\n", host_length, port_length);
+		write_to_syslog( "unmatched number of distribution server hosts %zu and ports %zu\n", host_length, port_length);
 		exit(1);
 	}
 
@@ -180,7 +194,7 @@ int main(int argc, char *argv[])
 
 	// Kick off packet merging and dumping to standard output
 	write_to_syslog( "starting packet merging and dumping\n");
-	pcapsession_t* pcap_merger = pcapsession_merger_open(output_path_str, untunnel);
+	pcapsession_t* pcap_merger = pcapsession_merger_open(output_path_str, untunnel, index_records, index_msec);
 	if (pcap_merger == NULL) {
 		write_to_syslog( "failed to start packet merging and dumping\n");
 		exit(1);
@@ -224,7 +238,8 @@ static void sighandler(int sig)
 
 	write_to_syslog("server termination ordered: signal=%d\n", sig);
 	pcapsession_handling_close();
-	closelog();
+	monitor_stats_close();
+	close_logger();
 }
 
 /**
@@ -0,0 +1,308 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: pcappipe.c
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This program prepares a PCAP file in a single pass, applying an ordered list of stages to each packet in memory
+ * before dumping it to one output file or to chunk files. The stages are the ones of gtpuntunnel, gtpaddr,
+ * usectstamp and chunkpcapfile, plus a BPF filter, so a pipeline of those programs is replaced by one read and one
+ * write of the capture
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pcap/pcap.h>
+#include <netinet/ip.h>
+#include <arpa/inet.h>
+
+#include <pcapdefines.h>
+#include <pcapsession.h>
+
+// The largest number of stages in a pipeline
+#define PCAPPIPE_MAX_STAGES 32
+
+// The kinds of stage
+#define PCAPPIPE_STAGE_UNTUNNEL 0  // Untunnel GTP-U packets
+#define PCAPPIPE_STAGE_REMAP    1  // Change an address of the packets tunnelled in G-PDUs
+#define PCAPPIPE_STAGE_RESTAMP  2  // Stamp the packets one microsecond apart
+#define PCAPPIPE_STAGE_FILTER   3  // Drop the packets that do not match a BPF filter
+
+// Define a struct that describes a stage of the pipeline
+struct pcappipe_stage {
+	int type;                              // The kind of stage, one of the PCAPPIPE_STAGE_ values
+	char* argument;                        // The option argument of the stage
+	pcapsession_address_map_t map;         // For address remapping, the addresses to change and what to change them to
+	struct bpf_program filter_program;     // For filtering, the compiled filter
+	struct timeval last_ts;                // For time stamp rewriting, the time stamp of the previous packet
+};
+
+// Define PCAP handles
+pcap_t* pcap_handle = NULL;
+pcap_dumper_t* pcap_dumper = NULL;
+
+// The link layer type of the input file
+int pcap_linktype = DLT_EN10MB;
+
+// The stages of the pipeline in the order they are applied
+struct pcappipe_stage stages[PCAPPIPE_MAX_STAGES];
+int stage_count = 0;
+
+// The chunk files being written, if the output is chunked
+pcapsession_chunker_t chunker;
+unsigned long chunk_max_size = 0;
+
+// Packet counts
+unsigned long packets_read = 0;
+unsigned long packets_written = 0;
+
+// Set if a chunk file could not be opened
+int dump_failed = 0;
+
+// Forward references for private functions
+int pcappipe_add_stage(int type, char* argument, int map_file);
+int pcappipe_compile_filters(void);
+void pcap_packet_handler(unsigned char* pcap_param, const struct pcap_pkthdr* header, const unsigned char* data);
+
+int main(int argc, char** argv) {
+	int usage = 0;
+
+	// Check arguments, the stages are kept in the order they are given
+	int opt;
+	while ((opt = getopt(argc, argv, "ua:A:tf:c:")) != -1) {
+		switch (opt) {
+		case 'u':
+			usage |= !pcappipe_add_stage(PCAPPIPE_STAGE_UNTUNNEL, NULL, 0);
+			break;
+		case 'a':
+		case 'A':
+			usage |= !pcappipe_add_stage(PCAPPIPE_STAGE_REMAP, optarg, opt == 'A');
+			break;
+		case 't':
+			usage |= !pcappipe_add_stage(PCAPPIPE_STAGE_RESTAMP, NULL, 0);
+			break;
+		case 'f':
+			usage |= !pcappipe_add_stage(PCAPPIPE_STAGE_FILTER, optarg, 0);
+			break;
+		case 'c':
+			chunk_max_size = atol(optarg);
+			usage |= chunk_max_size < PCAP_MIN_CHUNK_SIZE;
+			break;
+		default:
+			usage = 1;
+			break;
+		}
+	}
+
+	if (usage || argc - optind != 2) {
+		fprintf(stderr, "usage: %s [-u] [-a old_ip[/length],new_ip] [-A map_file] [-t] [-f filter] [-c chunk_max_size] in_file out_file\n", argv[0]);
+		fprintf(stderr, "  the stages are applied to each packet in the order they are given, -a, -A and -f may be repeated\n");
+		fprintf(stderr, "  -u untunnels GTP-U packets\n");
+		fprintf(stderr, "  -a changes the addresses in old_ip[/length] to new_ip in the packets tunnelled in G-PDUs, so it must come\n");
+		fprintf(stderr, "  before -u, the checksums are updated\n");
+		fprintf(stderr, "  -A changes the addresses by the mappings in map_file as gtpaddr -f does, so it must come before -u\n");
+		fprintf(stderr, "  -t stamps the packets one microsecond apart from the time stamp of the first packet\n");
+		fprintf(stderr, "  -f drops the packets that do not match the BPF filter\n");
+		fprintf(stderr, "  -c splits the output over files out_file_NNNNNN.pcap of at most chunk_max_size, at least %d\n", PCAP_MIN_CHUNK_SIZE);
+		fprintf(stderr, "  if in_file or out_file are specified as -, then standard input/standard output is used\n");
+		return 2;
+	}
+
+	char* in_file = argv[optind];
+	char* out_file = argv[optind + 1];
+
+	fprintf(stderr, "starting pipeline of %d stages\n", stage_count);
+
+	// Open PCAP file input
+	char pcap_errbuf[PCAP_ERRBUF_SIZE];
+	pcap_handle = pcap_open_offline(in_file, pcap_errbuf);
+	if (pcap_handle == NULL) {
+		fprintf(stderr, "capture start failed on file %s: %s\n", in_file, pcap_errbuf);
+		return 4;
+	}
+	pcap_linktype = pcap_datalink(pcap_handle);
+
+	// The filters are compiled for the link layer type of the input file
+	if (!pcappipe_compile_filters()) {
+		pcap_close(pcap_handle);
+		return 3;
+	}
+
+	// Open packet dumping on the output file, chunk files are opened as packets arrive
+	if (chunk_max_size != 0) {
+		pcapsession_chunker_init(&chunker, pcap_handle, out_file, chunk_max_size);
+	}
+	else {
+		pcap_dumper = pcap_dump_open(pcap_handle, out_file);
+		if (pcap_dumper == NULL) {
+			pcap_close(pcap_handle);
+			fprintf(stderr, "dump start failed on file %s\n", out_file);
+			return 5;
+		}
+	}
+
+	// Handle the PCAP file packets
+	pcap_loop(pcap_handle, PCAP_INFINITE, pcap_packet_handler, NULL);
+
+	// Close dumper if open
+	if (pcap_dumper != NULL) {
+		pcap_dump_close(pcap_dumper);
+	}
+	pcapsession_chunker_close(&chunker);
+
+	// Free the filters and address maps
+	for (int i = 0; i < stage_count; i++) {
+		if (stages[i].type == PCAPPIPE_STAGE_FILTER) {
+			pcap_freecode(&stages[i].filter_program);
+		}
+		else if (stages[i].type == PCAPPIPE_STAGE_REMAP) {
+			pcapsession_address_map_close(&stages[i].map);
+		}
+	}
+
+	// Close pcap
+	pcap_close(pcap_handle);
+
+	if (dump_failed) {
+		return 5;
+	}
+
+	fprintf(stderr, "completed pipeline, %lu packets read, %lu packets written\n", packets_read, packets_written);
+	return 0;
+}
+
+//
+// This function adds a stage to the end of the pipeline
+//
+// Parameters:
+//  int type: The kind of stage, one of the PCAPPIPE_STAGE_ values
+//  char* argument: The option argument of the stage, NULL if it has none
+//  int map_file: For address remapping, 1 if the argument is the name of a map file, 0 if it is a single mapping
+//
+// Return:
+//  int: 1 if the stage was added, 0 if the pipeline is full or the argument is not valid
+//
+int pcappipe_add_stage(int type, char* argument, int map_file)
+{
+	if (stage_count == PCAPPIPE_MAX_STAGES) {
+		fprintf(stderr, "a pipeline may have at most %d stages\n", PCAPPIPE_MAX_STAGES);
+		return 0;
+	}
+
+	struct pcappipe_stage* stage = &stages[stage_count];
+	memset(stage, 0, sizeof(struct pcappipe_stage));
+	stage->type = type;
+	stage->argument = argument;
+
+	// The addresses of a remapping are given as old_ip[/length],new_ip or in a map file
+	if (type == PCAPPIPE_STAGE_REMAP) {
+		char errbuf[PCAP_SESSION_ADDRESS_MAP_ERRBUF_SIZE];
+		if (!pcapsession_address_map_init(&stage->map)) {
+			fprintf(stderr, "could not allocate the address map of %s\n", argument);
+			return 0;
+		}
+
+		int valid = map_file ? pcapsession_address_map_load(&stage->map, argument, errbuf) : pcapsession_address_map_add(&stage->map, argument, errbuf);
+		if (!valid) {
+			fprintf(stderr, "address change %s is not valid: %s\n", argument, errbuf);
+			pcapsession_address_map_close(&stage->map);
+			return 0;
+		}
+	}
+
+	stage_count++;
+	return 1;
+}
+
+//
+// This function compiles the filters of the pipeline for the input file
+//
+// Return:
+//  int: 1 if all filters compiled, 0 otherwise
+//
+int pcappipe_compile_filters(void)
+{
+	for (int i = 0; i < stage_count; i++) {
+		if (stages[i].type != PCAPPIPE_STAGE_FILTER) {
+			continue;
+		}
+
+		if (pcap_compile(pcap_handle, &stages[i].filter_program, stages[i].argument, 1, PCAP_NETMASK_UNKNOWN) != 0) {
+			fprintf(stderr, "filter \"%s\" is not valid: %s\n", stages[i].argument, pcap_geterr(pcap_handle));
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+//
+// This function is a PCAP packet handler callback method for packets, it applies the stages of the pipeline to the
+// packet in order and dumps it unless a filter drops it
+//
+// Parameters:
+//  unsigned char* pcap_param: A pointer to user data set in the pcap_loop call, in this case it is not used
+//  const struct pcap_pkthdr* header: A pointer to the header of the packet
+//  const unsigned char* data: A pointer to the packet data
+//
+void pcap_packet_handler(unsigned char* pcap_param, const struct pcap_pkthdr* header, const unsigned char* data)
+{
+	packets_read++;
+
+	// Copy the header data to a new modifiable header
+	struct pcap_pkthdr new_header = *header;
+
+	for (int i = 0; i < stage_count; i++) {
+		struct pcappipe_stage* stage = &stages[i];
+
+		switch (stage->type) {
+		case PCAPPIPE_STAGE_UNTUNNEL:
+			pcapsession_untunnel_packet(NULL, pcap_linktype, &new_header, data);
+			break;
+
+		case PCAPPIPE_STAGE_REMAP:
+			pcapsession_remap_packet(pcap_linktype, &new_header, data, &stage->map, PCAP_SESSION_REMAP_INNER);
+			break;
+
+		case PCAPPIPE_STAGE_RESTAMP:
+			pcapsession_restamp_packet(&new_header, &stage->last_ts);
+			break;
+
+		case PCAPPIPE_STAGE_FILTER:
+			if (!pcap_offline_filter(&stage->filter_program, &new_header, data)) {
+				return;
+			}
+			break;
+		}
+	}
+
+	packets_written++;
+
+	// Dump the packet
+	if (chunk_max_size == 0) {
+		pcap_dump((unsigned char*)pcap_dumper, &new_header, data);
+		return;
+	}
+
+	int started = pcapsession_chunker_dump(&chunker, &new_header, data);
+	if (started < 0) {
+		fprintf(stderr, "dump start failed on file %s\n", chunker.chunk_file_name);
+		dump_failed = 1;
+		pcap_breakloop(pcap_handle);
+	}
+	else if (started) {
+		fprintf(stderr, "dumping to %s . . .\n", chunker.chunk_file_name);
+	}
+}
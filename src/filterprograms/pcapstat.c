@@ -0,0 +1,309 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: pcapstat.c
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This program reads the statistics segment of a running pcapdistributer or pcapmerger and prints the
+ * per monitor rates and latency percentiles at a given interval
+ */
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <monitor.h>
+
+// The default interval between samples in seconds
+#define PCAPSTAT_DEFAULT_INTERVAL 1.0
+
+// Forward references for private functions
+int pcapstat_find_segment(char* segment_path);
+struct monitor_stats_header* pcapstat_map_segment(char* segment_path);
+void pcapstat_sample(struct monitor_stats_header* header, struct monitor_stats_slot* slots);
+void pcapstat_print(struct monitor_stats_slot* previous, struct monitor_stats_slot* current, int slot_count, double interval);
+
+int main(int argc, char** argv) {
+	double interval = PCAPSTAT_DEFAULT_INTERVAL;
+	long count = 0;
+
+	// Check arguments
+	int opt;
+	while ((opt = getopt(argc, argv, "i:c:")) != -1) {
+		switch (opt) {
+		case 'i':
+			interval = atof(optarg);
+			break;
+		case 'c':
+			count = atol(optarg);
+			break;
+		default:
+			interval = 0;
+			break;
+		}
+	}
+
+	if (interval <= 0 || count < 0 || argc - optind > 1) {
+		fprintf(stderr, "usage: %s [-i interval_seconds] [-c count] [segment]\n", argv[0]);
+		fprintf(stderr, "  the interval may be fractional, a count of 0 samples until the program being monitored exits\n");
+		fprintf(stderr, "  if segment is not specified, the single segment in %s is used\n", MONITOR_STATS_DIRECTORY);
+		return 2;
+	}
+
+	// Find the segment to read
+	char segment_path[FILENAME_MAX];
+	if (optind < argc) {
+		strncpy(segment_path, argv[optind], FILENAME_MAX);
+		segment_path[FILENAME_MAX-1] = 0;
+	}
+	else if (!pcapstat_find_segment(segment_path)) {
+		return 3;
+	}
+
+	struct monitor_stats_header* header = pcapstat_map_segment(segment_path);
+	if (header == NULL) {
+		return 4;
+	}
+
+	printf("reading %s, program %s, pid %d\n", segment_path, header->program_name, (int)header->pid);
+
+	// Two sets of slot copies, the previous sample and the current one
+	struct monitor_stats_slot* previous = (struct monitor_stats_slot*) calloc(header->slot_count, sizeof(struct monitor_stats_slot));
+	struct monitor_stats_slot* current  = (struct monitor_stats_slot*) calloc(header->slot_count, sizeof(struct monitor_stats_slot));
+	if (previous == NULL || current == NULL) {
+		fprintf(stderr, "could not allocate memory for %d slots\n", header->slot_count);
+		return 5;
+	}
+
+	struct timespec sleep_time;
+	sleep_time.tv_sec  = (time_t)interval;
+	sleep_time.tv_nsec = (long)((interval - (double)sleep_time.tv_sec) * 1000000000.0);
+
+	pcapstat_sample(header, previous);
+	for (long sample = 0; count == 0 || sample < count; sample++) {
+		nanosleep(&sleep_time, NULL);
+
+		pcapstat_sample(header, current);
+		pcapstat_print(previous, current, header->slot_count, interval);
+
+		struct monitor_stats_slot* swap = previous;
+		previous = current;
+		current = swap;
+
+		// Stop when the program being monitored is gone
+		if (kill(header->pid, 0) != 0 && errno == ESRCH) {
+			printf("process %d has exited\n", (int)header->pid);
+			break;
+		}
+	}
+
+	free(previous);
+	free(current);
+	return 0;
+}
+
+//
+// This function looks for statistics segments, if there is exactly one it is returned, otherwise the segments are listed
+//
+// Parameters:
+//  char* segment_path: The path of the segment found, FILENAME_MAX characters long
+//
+// Return:
+//  int: 1 if a single segment was found, 0 otherwise
+//
+int pcapstat_find_segment(char* segment_path)
+{
+	DIR* directory = opendir(MONITOR_STATS_DIRECTORY);
+	if (directory == NULL) {
+		fprintf(stderr, "could not open %s: %s\n", MONITOR_STATS_DIRECTORY, strerror(errno));
+		return 0;
+	}
+
+	int segment_count = 0;
+	struct dirent* dir_entry = NULL;
+	while ((dir_entry = readdir(directory)) != NULL) {
+		if (strncmp(dir_entry->d_name, MONITOR_STATS_PREFIX, strlen(MONITOR_STATS_PREFIX))) {
+			continue;
+		}
+
+		segment_count++;
+		snprintf(segment_path, FILENAME_MAX, "%s/%s", MONITOR_STATS_DIRECTORY, dir_entry->d_name);
+
+		// The segment name ends in the PID of its owner
+		char* pid_str = strrchr(dir_entry->d_name, '.');
+		int pid = pid_str == NULL ? 0 : atoi(pid_str + 1);
+		int running = pid > 0 && (kill(pid, 0) == 0 || errno == EPERM);
+		fprintf(stderr, "  %s%s\n", segment_path, running ? "" : " (process not running)");
+	}
+	closedir(directory);
+
+	if (segment_count == 0) {
+		fprintf(stderr, "no statistics segments found in %s\n", MONITOR_STATS_DIRECTORY);
+		return 0;
+	}
+	else if (segment_count > 1) {
+		fprintf(stderr, "%d statistics segments found, specify the segment to read\n", segment_count);
+		return 0;
+	}
+
+	return 1;
+}
+
+//
+// This function maps a statistics segment read only and checks that its layout is the one this program was built with
+//
+// Parameters:
+//  char* segment_path: The path of the segment
+//
+// Return:
+//  struct monitor_stats_header*: The header of the mapped segment, NULL on errors
+//
+struct monitor_stats_header* pcapstat_map_segment(char* segment_path)
+{
+	int fd = open(segment_path, O_RDONLY);
+	if (fd < 0) {
+		fprintf(stderr, "could not open %s: %s\n", segment_path, strerror(errno));
+		return NULL;
+	}
+
+	struct stat segment_stat;
+	if (fstat(fd, &segment_stat) != 0 || (size_t)segment_stat.st_size < sizeof(struct monitor_stats_header)) {
+		fprintf(stderr, "%s is not a statistics segment\n", segment_path);
+		close(fd);
+		return NULL;
+	}
+
+	void* segment = mmap(NULL, segment_stat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (segment == MAP_FAILED) {
+		fprintf(stderr, "could not map %s: %s\n", segment_path, strerror(errno));
+		return NULL;
+	}
+
+	struct monitor_stats_header* header = (struct monitor_stats_header*)segment;
+	if (memcmp(header->magic, MONITOR_STATS_MAGIC, sizeof(header->magic))) {
+		fprintf(stderr, "%s is not a statistics segment or is not ready yet\n", segment_path);
+		return NULL;
+	}
+
+	if (header->version != MONITOR_STATS_VERSION
+			|| header->header_size != sizeof(struct monitor_stats_header)
+			|| header->slot_size != sizeof(struct monitor_stats_slot)) {
+		fprintf(stderr, "%s has version %d, this program reads version %d\n", segment_path, header->version, MONITOR_STATS_VERSION);
+		return NULL;
+	}
+
+	if ((size_t)segment_stat.st_size < header->header_size + (size_t)header->slot_size * header->slot_count) {
+		fprintf(stderr, "%s is truncated\n", segment_path);
+		return NULL;
+	}
+
+	return header;
+}
+
+//
+// This function takes a copy of every slot in a statistics segment
+//
+// Parameters:
+//  struct monitor_stats_header* header: The header of the segment
+//  struct monitor_stats_slot* slots: The slot copies
+//
+void pcapstat_sample(struct monitor_stats_header* header, struct monitor_stats_slot* slots)
+{
+	struct monitor_stats_slot* segment_slots = (struct monitor_stats_slot*)(header + 1);
+
+	for (int i = 0; i < header->slot_count; i++) {
+		if (!monitor_stats_read_slot(&segment_slots[i], &slots[i])) {
+			slots[i].in_use = 0;
+		}
+	}
+}
+
+//
+// This function prints the difference between two samples of a statistics segment
+//
+// Parameters:
+//  struct monitor_stats_slot* previous: The previous sample
+//  struct monitor_stats_slot* current: The current sample
+//  int slot_count: The number of slots in each sample
+//  double interval: The time between the samples in seconds
+//
+void pcapstat_print(struct monitor_stats_slot* previous, struct monitor_stats_slot* current, int slot_count, double interval)
+{
+	char time_str[32];
+	time_t now = time(NULL);
+	strftime(time_str, sizeof(time_str), "%H:%M:%S", localtime(&now));
+
+	printf("%s %4s %-24s %12s %10s %14s %10s %10s %10s %10s %12s %14s %8s %8s %8s\n", time_str,
+			"id", "monitor", "pkts", "pkt/s", "bytes", "Mbit/s", "kdrops", "ifdrops", "distdrops",
+			"gtp_pkts", "gtp_bytes", "ext", "seqno", "npdu");
+
+	for (int i = 0; i < slot_count; i++) {
+		// Only diff monitors that were open in the slot over the whole interval
+		if (!current[i].in_use || !previous[i].in_use || current[i].generation != previous[i].generation) {
+			continue;
+		}
+
+		struct monitor_counters then, now;
+		monitor_snapshot(&previous[i].monitor, &then);
+		monitor_snapshot(&current[i].monitor, &now);
+
+		long long packets = now.packets - then.packets;
+		long long bytes = now.bytes - then.bytes;
+
+		printf("%8s %4d %-24.24s %12lld %10.0f %14lld %10.2f %10lld %10lld %10lld %12lld %14lld %8lld %8lld %8lld\n", "",
+				current[i].monitor.id, current[i].monitor.description,
+				packets, packets / interval, bytes, bytes * 8 / interval / 1000000.0,
+				now.kernel_drops - then.kernel_drops, now.interface_drops - then.interface_drops,
+				now.distributor_drops - then.distributor_drops,
+				now.gtp_packets - then.gtp_packets, now.gtp_bytes - then.gtp_bytes,
+				now.gtp_ext - then.gtp_ext, now.gtp_seqno - then.gtp_seqno, now.gtp_npdu - then.gtp_npdu);
+
+		// Paced streams show the rate achieved against the target rate
+		const struct monitor* monitor = &current[i].monitor;
+		if (monitor->target_packets_per_second > 0) {
+			printf("%8s %4s target pkt/s=%.0f, achieved=%.2f%%\n", "", "",
+					monitor->target_packets_per_second, packets / interval * 100 / monitor->target_packets_per_second);
+		}
+		if (monitor->target_bits_per_second > 0) {
+			printf("%8s %4s target Mbit/s=%.2f, achieved=%.2f%%\n", "", "",
+					monitor->target_bits_per_second / 1000000.0, bytes * 8 / interval * 100 / monitor->target_bits_per_second);
+		}
+
+		if (!current[i].latency_in_use || !previous[i].latency_in_use) {
+			continue;
+		}
+
+		long long counts[MONITOR_HISTOGRAM_BUCKETS];
+		for (int b = 0; b < MONITOR_HISTOGRAM_BUCKETS; b++) {
+			counts[b] = current[i].latency.counts[b] - previous[i].latency.counts[b];
+		}
+
+		long long percentiles[MONITOR_PERCENTILES];
+		long long total = monitor_histogram_percentiles(counts, percentiles);
+		if (total > 0) {
+			printf("%8s %4s latency %s: count=%lld, p50=%lldus, p99=%lldus, p99.9=%lldus, max=%lldus\n", "", "",
+					current[i].latency.description, total, percentiles[0], percentiles[1], percentiles[2], percentiles[3]);
+		}
+	}
+
+	fflush(stdout);
+}
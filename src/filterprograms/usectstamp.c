@@ -21,13 +21,13 @@
 #include <gtpv1.h>
 #include <logger.h>
 #include <pcapdefines.h>
+#include <pcapsession.h>
 
 // Define PCAP handles
 pcap_dumper_t* pcap_dumper = NULL;
 
 // Hold the last value of the time stamp
-time_t tv_sec = 0;
-time_t tv_usec = 0;
+struct timeval last_ts = {0, 0};
 
 // Forward references for private functions
 void pcap_packet_handler(unsigned char* pcap_param, const struct pcap_pkthdr* header, const unsigned char* data);
@@ -83,30 +83,11 @@ int main(int argc, char** argv) {
 //
 void pcap_packet_handler(unsigned char* pcap_param, const struct pcap_pkthdr* header, const unsigned char* data)
 {
-	// Check if the time stamp has been set yet
-	if (tv_sec == 0) {
-		// Initialize the time stamp
-		tv_sec = header->ts.tv_sec;
-		tv_usec = header->ts.tv_usec;
-	}
-	else {
-		// Increment microsecond count
-		tv_usec++;
-
-		// Check if microseconds have looped
-		if (tv_usec >= 1000000) {
-			tv_sec++;
-			tv_usec = 0;
-		}
-	}
+	// Copy the header data to a new modifiable header
+	struct pcap_pkthdr new_header = *header;
 
 	// Modify the time stamp
-	// Copy the header data to a new modifiable header
-	struct pcap_pkthdr new_header;
-	new_header.caplen     = header->caplen;
-	new_header.len        = header->len;
-	new_header.ts.tv_sec  = tv_sec;
-	new_header.ts.tv_usec = tv_usec;
+	pcapsession_restamp_packet(&new_header, &last_ts);
 
 	// Dump the modified packet
 	pcap_dump((unsigned char*)pcap_dumper, &new_header, data);
@@ -0,0 +1,255 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: gtp_classify.c
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This module classifies packets as GTP V1 signalling, GTP-U or other traffic and walks the encapsulations in front of
+ * the outer IPv4 header
+ */
+
+#include <gtp_classify.h>
+
+// The offsets of the protocol type and of the payload in a Linux cooked capture header
+#define GTP_CLASSIFY_SLL_TYPE_OFFSET 14
+#define GTP_CLASSIFY_SLL_LENGTH 16
+
+// The Ethernet types of tags and label stacks not defined in net/ethernet.h
+#define GTP_CLASSIFY_ETHERTYPE_QINQ 0x88a8
+#define GTP_CLASSIFY_ETHERTYPE_QINQ_OLD 0x9100
+#define GTP_CLASSIFY_ETHERTYPE_MPLS 0x8847
+#define GTP_CLASSIFY_ETHERTYPE_MPLS_MULTICAST 0x8848
+
+// An MPLS label stack entry, the bottom of stack bit is the lowest bit of its third octet, and the control word in front
+// of an Ethernet pseudowire, which starts with a zero nibble where an IP header starts with its version
+#define GTP_CLASSIFY_MPLS_LABEL_LENGTH 4
+#define GTP_CLASSIFY_MPLS_CONTROL_WORD_LENGTH 4
+
+// The GRE flags, the checksum, key and sequence number flags each add four octets to the header
+#define GTP_CLASSIFY_GRE_LENGTH 4
+#define GTP_CLASSIFY_GRE_CHECKSUM 0x8000
+#define GTP_CLASSIFY_GRE_ROUTING 0x4000
+#define GTP_CLASSIFY_GRE_KEY 0x2000
+#define GTP_CLASSIFY_GRE_SEQUENCE 0x1000
+#define GTP_CLASSIFY_GRE_VERSION 0x0007
+
+// The GRE protocol types of mirrored traffic, ERSPAN type II has an eight octet header unless it is the header free
+// type I without a sequence number, ERSPAN type III has a twelve octet header and an optional eight octet subheader
+#define GTP_CLASSIFY_GRE_ERSPAN 0x88be
+#define GTP_CLASSIFY_GRE_ERSPAN_III 0x22eb
+#define GTP_CLASSIFY_GRE_TEB 0x6558
+#define GTP_CLASSIFY_ERSPAN_II_LENGTH 8
+#define GTP_CLASSIFY_ERSPAN_III_LENGTH 12
+#define GTP_CLASSIFY_ERSPAN_III_SUBHEADER_LENGTH 8
+
+// Forward definition of private functions
+static inline u_int gtp_classify_enter_ethernet(u_int length, const u_char* data, u_int* offset, u_int* type_offset, struct gtp_class* packet_class);
+
+//
+// This function classifies a packet whose link layer headers and encapsulations are not recognised by
+// gtp_classify_packet() by walking them with gtp_classify_locate_ip()
+//
+// Parameters:
+//  int linktype: The link layer type of the capture, DLT_EN10MB or DLT_LINUX_SLL
+//  u_int length: The amount of data present in the data buffer
+//  const u_char* data: A pointer to the packet data
+//  struct gtp_class* packet_class: The class of the packet is returned here, the offsets are only set for GTP packets
+//
+// Return:
+//  int: The class of the packet
+//
+int gtp_classify_encapsulated_packet(int linktype, u_int length, const u_char* data, struct gtp_class* packet_class)
+{
+	u_int ip = gtp_classify_locate_ip(linktype, length, data, packet_class);
+	if (ip == 0) {
+		packet_class->type = GTP_CLASS_NONE;
+		return GTP_CLASS_NONE;
+	}
+
+	return gtp_classify_ip(linktype, ip, length, data, packet_class);
+}
+
+//
+// This function walks the link layer header and any tags, label stacks and mirroring encapsulations in front of the
+// IPv4 header of a packet. The offsets of the link layer header and of the protocol type announcing the IPv4 header are
+// returned in the class of the packet
+//
+// Parameters:
+//  int linktype: The link layer type of the capture, DLT_EN10MB or DLT_LINUX_SLL
+//  u_int length: The amount of data present in the data buffer
+//  const u_char* data: A pointer to the packet data
+//  struct gtp_class* packet_class: The offsets of the link layer header are returned here
+//
+// Return:
+//  u_int: The offset of the IPv4 header, 0 if there is none
+//
+u_int gtp_classify_locate_ip(int linktype, u_int length, const u_char* data, struct gtp_class* packet_class)
+{
+	u_int offset;
+	u_int type_offset;
+
+	switch (linktype) {
+	case DLT_EN10MB:
+		type_offset = ETHER_ADDR_LEN * 2;
+		offset = sizeof(struct ether_header);
+		break;
+
+	case DLT_LINUX_SLL:
+		type_offset = GTP_CLASSIFY_SLL_TYPE_OFFSET;
+		offset = GTP_CLASSIFY_SLL_LENGTH;
+		break;
+
+	default:
+		return 0;
+	}
+
+	if (length < offset) {
+		return 0;
+	}
+
+	packet_class->mirrored = 0;
+	packet_class->l2_offset = 0;
+	u_int type = data[type_offset] << 8 | data[type_offset + 1];
+
+	for (int layer = 0; layer < GTP_CLASSIFY_MAX_LAYERS; layer++) {
+		switch (type) {
+		case ETHERTYPE_VLAN:
+		case GTP_CLASSIFY_ETHERTYPE_QINQ:
+		case GTP_CLASSIFY_ETHERTYPE_QINQ_OLD:
+			// A tag holds the priority and VLAN identifier followed by the type of what comes after it
+			if (length < offset + TAG_ETHER_802_1_Q_LENGTH) {
+				return 0;
+			}
+
+			type_offset = offset + 2;
+			type = data[type_offset] << 8 | data[type_offset + 1];
+			offset += TAG_ETHER_802_1_Q_LENGTH;
+			break;
+
+		case GTP_CLASSIFY_ETHERTYPE_MPLS:
+		case GTP_CLASSIFY_ETHERTYPE_MPLS_MULTICAST:
+			if (length <= offset + GTP_CLASSIFY_MPLS_LABEL_LENGTH) {
+				return 0;
+			}
+
+			offset += GTP_CLASSIFY_MPLS_LABEL_LENGTH;
+			if (!(data[offset - 2] & 0x01)) {
+				break;
+			}
+
+			// The payload of the label stack has no type, it is recognised by its first nibble
+			type_offset = 0;
+			if ((data[offset] >> 4) == IPVERSION) {
+				type = ETHERTYPE_IP;
+			}
+			else if ((data[offset] >> 4) == 0) {
+				offset += GTP_CLASSIFY_MPLS_CONTROL_WORD_LENGTH;
+				type = gtp_classify_enter_ethernet(length, data, &offset, &type_offset, packet_class);
+			}
+			else {
+				return 0;
+			}
+			break;
+
+		case ETHERTYPE_IP:
+			if (length < offset + sizeof(struct ip) || (data[offset] >> 4) != IPVERSION) {
+				return 0;
+			}
+
+			// Any IPv4 packet other than a GRE tunnel is the one that may carry GTP
+			packet_class->type_offset = type_offset;
+			if (data[offset + 9] != IPPROTO_GRE) {
+				return offset;
+			}
+
+			// GRE with source routing or of another version than 0 is not walked
+			u_int gre = offset + (data[offset] & 0x0f) * 4;
+			if (length < gre + GTP_CLASSIFY_GRE_LENGTH) {
+				return offset;
+			}
+
+			u_int flags = data[gre] << 8 | data[gre + 1];
+			if (flags & (GTP_CLASSIFY_GRE_ROUTING | GTP_CLASSIFY_GRE_VERSION)) {
+				return offset;
+			}
+
+			u_int payload = gre + GTP_CLASSIFY_GRE_LENGTH;
+			payload += (flags & GTP_CLASSIFY_GRE_CHECKSUM) ? 4 : 0;
+			payload += (flags & GTP_CLASSIFY_GRE_KEY) ? 4 : 0;
+			payload += (flags & GTP_CLASSIFY_GRE_SEQUENCE) ? 4 : 0;
+
+			switch (data[gre + 2] << 8 | data[gre + 3]) {
+			case GTP_CLASSIFY_GRE_ERSPAN:
+				payload += (flags & GTP_CLASSIFY_GRE_SEQUENCE) ? GTP_CLASSIFY_ERSPAN_II_LENGTH : 0;
+				break;
+
+			case GTP_CLASSIFY_GRE_ERSPAN_III:
+				if (length < payload + GTP_CLASSIFY_ERSPAN_III_LENGTH) {
+					return offset;
+				}
+				payload += GTP_CLASSIFY_ERSPAN_III_LENGTH + ((data[payload + 11] & 0x01) ? GTP_CLASSIFY_ERSPAN_III_SUBHEADER_LENGTH : 0);
+				break;
+
+			case GTP_CLASSIFY_GRE_TEB:
+				break;
+
+			case ETHERTYPE_IP:
+				// The tunnelled IPv4 packet has no link layer header of its own
+				packet_class->mirrored = 1;
+				packet_class->l2_offset = 0;
+				type_offset = gre + 2;
+				offset = payload;
+				continue;
+
+			default:
+				return offset;
+			}
+
+			offset = payload;
+			type = gtp_classify_enter_ethernet(length, data, &offset, &type_offset, packet_class);
+			break;
+
+		default:
+			return 0;
+		}
+	}
+
+	return 0;
+}
+
+//
+// This function enters the Ethernet header of a packet mirrored by GRE, ERSPAN or an Ethernet pseudowire
+//
+// Parameters:
+//  u_int length: The amount of data present in the data buffer
+//  const u_char* data: A pointer to the packet data
+//  u_int* offset: The offset of the Ethernet header, the offset of its payload is returned here
+//  u_int* type_offset: The offset of the Ethernet type is returned here
+//  struct gtp_class* packet_class: The offset of the Ethernet header is returned here
+//
+// Return:
+//  u_int: The Ethernet type, 0 if the Ethernet header is truncated
+//
+static inline u_int gtp_classify_enter_ethernet(u_int length, const u_char* data, u_int* offset, u_int* type_offset, struct gtp_class* packet_class)
+{
+	if (length < *offset + sizeof(struct ether_header)) {
+		return 0;
+	}
+
+	packet_class->mirrored = 1;
+	packet_class->l2_offset = *offset;
+	*type_offset = *offset + ETHER_ADDR_LEN * 2;
+	*offset += sizeof(struct ether_header);
+
+	return data[*type_offset] << 8 | data[*type_offset + 1];
+}
@@ -0,0 +1,627 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: gtpv1_context.c
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This module handles correlation of GTP-C messages on a PDP context. The hash table uses linear probing with
+ * backward shift deletion so there are no tombstones, it holds indexes into an array of contexts so that contexts
+ * do not move when the table is resized and the timing wheel can link them on their indexes. Tables are saved to
+ * snapshot files as arrays of records so that a snapshot can be checked and loaded straight from a mapping of the file
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <crc32.h>
+#include <gtpv1_context.h>
+
+// Forward definition of private functions
+static int gtpv1_context_table_resize(struct gtpv1_context_table* table, u_int slot_count);
+static u_int gtpv1_context_find_slot(struct gtpv1_context_table* table, u_int teid, u_int peer);
+static void gtpv1_context_wheel_insert(struct gtpv1_context_table* table, u_int index);
+static void gtpv1_context_wheel_unlink(struct gtpv1_context_table* table, u_int index);
+
+//
+// This function opens a context table
+//
+// Parameters:
+//  time_t timeout: The number of seconds after which contexts expire, must be less than GTPV1_CONTEXT_WHEEL_SIZE
+//
+// Return:
+//  struct gtpv1_context_table*: The table, NULL if it could not be allocated
+//
+struct gtpv1_context_table* gtpv1_context_table_open(time_t timeout)
+{
+	if (timeout <= 0 || timeout >= GTPV1_CONTEXT_WHEEL_SIZE) {
+		return NULL;
+	}
+
+	struct gtpv1_context_table* table = (struct gtpv1_context_table*) calloc(1, sizeof(struct gtpv1_context_table));
+	if (table == NULL) {
+		return NULL;
+	}
+
+	table->timeout = timeout;
+	table->free_list = GTPV1_CONTEXT_NONE;
+	for (int i = 0; i < GTPV1_CONTEXT_WHEEL_SIZE; i++) {
+		table->wheel[i] = GTPV1_CONTEXT_NONE;
+	}
+
+	// Keep the table at most half full
+	if (!gtpv1_context_table_resize(table, GTPV1_CONTEXT_INITIAL_SIZE * 2)) {
+		free(table);
+		return NULL;
+	}
+
+	return table;
+}
+
+//
+// This function closes a context table and frees its memory
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//
+void gtpv1_context_table_close(struct gtpv1_context_table* table)
+{
+	if (table == NULL) {
+		return;
+	}
+
+	free(table->slots);
+	free(table->contexts);
+	free(table);
+}
+
+//
+// This function adds a context to a table, it expires after the table timeout. If the context is already in the table
+// it is returned as it is
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//  u_int teid: The TEID, in host byte order
+//  u_int peer: The IPv4 address of the peer that allocated the TEID
+//  time_t now: The current time
+//
+// Return:
+//  struct gtpv1_context*: The context, NULL if memory could not be allocated
+//
+struct gtpv1_context* gtpv1_context_add(struct gtpv1_context_table* table, u_int teid, u_int peer, time_t now)
+{
+	// Check if the context exists already, a retransmitted request for instance
+	u_int slot = gtpv1_context_find_slot(table, teid, peer);
+	if (table->slots[slot].context != GTPV1_CONTEXT_NONE) {
+		return &table->contexts[table->slots[slot].context];
+	}
+
+	// Grow the hash table if it would be more than half full
+	if ((table->count + 1) * 2 > table->slot_mask + 1) {
+		if (!gtpv1_context_table_resize(table, (table->slot_mask + 1) * 2)) {
+			return NULL;
+		}
+		slot = gtpv1_context_find_slot(table, teid, peer);
+	}
+
+	// Get a free context, growing the context array if there are none
+	if (table->free_list == GTPV1_CONTEXT_NONE) {
+		u_int context_size = table->context_size == 0 ? GTPV1_CONTEXT_INITIAL_SIZE : table->context_size * 2;
+		struct gtpv1_context* contexts = (struct gtpv1_context*) realloc(table->contexts, context_size * sizeof(struct gtpv1_context));
+		if (contexts == NULL) {
+			return NULL;
+		}
+
+		// Put the new contexts on the free list, lowest index first
+		for (u_int i = context_size; i > table->context_size; i--) {
+			contexts[i - 1].wheel_next = table->free_list;
+			table->free_list = i - 1;
+		}
+
+		table->contexts = contexts;
+		table->context_size = context_size;
+	}
+
+	u_int index = table->free_list;
+	struct gtpv1_context* context = &table->contexts[index];
+	table->free_list = context->wheel_next;
+
+	memset(context, 0, sizeof(struct gtpv1_context));
+	context->teid = teid;
+	context->peer = peer;
+	context->expiry = now + table->timeout;
+	gtpv1_context_wheel_insert(table, index);
+
+	table->slots[slot].teid = teid;
+	table->slots[slot].peer = peer;
+	table->slots[slot].context = index;
+	table->count++;
+
+	return context;
+}
+
+//
+// This function finds a context in a table
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//  u_int teid: The TEID, in host byte order
+//  u_int peer: The IPv4 address of the peer that allocated the TEID
+//
+// Return:
+//  struct gtpv1_context*: The context, NULL if it is not in the table
+//
+struct gtpv1_context* gtpv1_context_find(struct gtpv1_context_table* table, u_int teid, u_int peer)
+{
+	u_int index = table->slots[gtpv1_context_find_slot(table, teid, peer)].context;
+	if (index == GTPV1_CONTEXT_NONE) {
+		return NULL;
+	}
+
+	return &table->contexts[index];
+}
+
+//
+// This function removes a context from a table
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//  struct gtpv1_context* context: The context
+//
+void gtpv1_context_remove(struct gtpv1_context_table* table, struct gtpv1_context* context)
+{
+	u_int hole = gtpv1_context_find_slot(table, context->teid, context->peer);
+	u_int index = table->slots[hole].context;
+	if (index == GTPV1_CONTEXT_NONE) {
+		return;
+	}
+
+	// Shift back the entries after the hole that are not in their home slot, so that no probe sequence is broken
+	u_int next = (hole + 1) & table->slot_mask;
+	while (table->slots[next].context != GTPV1_CONTEXT_NONE) {
+		u_int home = gtpv1_context_hash(table->slots[next].teid, table->slots[next].peer) & table->slot_mask;
+
+		// Move the entry if its home slot is not cyclically between the hole and the entry
+		if (((next - home) & table->slot_mask) >= ((next - hole) & table->slot_mask)) {
+			table->slots[hole] = table->slots[next];
+			hole = next;
+		}
+		next = (next + 1) & table->slot_mask;
+	}
+	table->slots[hole].context = GTPV1_CONTEXT_NONE;
+
+	if (table->remove_handler != NULL) {
+		table->remove_handler(table, &table->contexts[index], table->remove_handler_data);
+	}
+
+	// Return the context to the free list
+	gtpv1_context_wheel_unlink(table, index);
+	table->contexts[index].wheel_next = table->free_list;
+	table->free_list = index;
+	table->count--;
+}
+
+//
+// This function sets the function that is called when a context is removed from a table
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//  gtpv1_context_handler handler: The handler, NULL to clear it
+//  void* data: The data passed to the handler
+//
+void gtpv1_context_set_remove_handler(struct gtpv1_context_table* table, gtpv1_context_handler handler, void* data)
+{
+	table->remove_handler = handler;
+	table->remove_handler_data = data;
+}
+
+//
+// This function sets the expiry time of a context
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//  struct gtpv1_context* context: The context
+//  time_t expiry: The time at which the context expires, GTPV1_CONTEXT_NEVER if it should not expire
+//
+void gtpv1_context_set_expiry(struct gtpv1_context_table* table, struct gtpv1_context* context, time_t expiry)
+{
+	u_int index = context - table->contexts;
+
+	gtpv1_context_wheel_unlink(table, index);
+	context->expiry = expiry;
+	gtpv1_context_wheel_insert(table, index);
+}
+
+//
+// This function removes the contexts that have expired from a table, it visits each second of the timing wheel
+// from the last time it was called up to now
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//  time_t now: The current time
+//
+// Return:
+//  u_int: The number of contexts that expired
+//
+u_int gtpv1_context_expire(struct gtpv1_context_table* table, time_t now)
+{
+	// On the first call, start the wheel now
+	if (table->wheel_time == 0) {
+		table->wheel_time = now;
+		return 0;
+	}
+
+	// Time stamps in capture files may go backwards, wait for time to catch up
+	if (now <= table->wheel_time) {
+		return 0;
+	}
+
+	// After a long gap every slot is visited once
+	time_t seconds = now - table->wheel_time;
+	if (seconds > GTPV1_CONTEXT_WHEEL_SIZE) {
+		seconds = GTPV1_CONTEXT_WHEEL_SIZE;
+	}
+
+	u_int expired = 0;
+	for (time_t second = now - seconds + 1; second <= now; second++) {
+		u_int index = table->wheel[second & (GTPV1_CONTEXT_WHEEL_SIZE - 1)];
+		while (index != GTPV1_CONTEXT_NONE) {
+			struct gtpv1_context* context = &table->contexts[index];
+			index = context->wheel_next;
+
+			if (context->expiry != GTPV1_CONTEXT_NEVER && context->expiry <= now) {
+				gtpv1_context_remove(table, context);
+				expired++;
+			}
+		}
+	}
+
+	table->wheel_time = now;
+	return expired;
+}
+
+//
+// This function adds a context saved in a snapshot to a table. If the context is already in the table it is overwritten
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//  struct gtpv1_snapshot_record* record: The saved context
+//
+// Return:
+//  struct gtpv1_context*: The context, NULL if memory could not be allocated
+//
+struct gtpv1_context* gtpv1_context_restore(struct gtpv1_context_table* table, struct gtpv1_snapshot_record* record)
+{
+	struct gtpv1_context* context = gtpv1_context_add(table, record->teid, record->peer, GTPV1_CONTEXT_NEVER);
+	if (context == NULL) {
+		return NULL;
+	}
+
+	gtpv1_context_set_expiry(table, context, (time_t)record->expiry);
+	context->link_teid = record->link_teid;
+	context->link_peer = record->link_peer;
+	context->eua = record->eua;
+	context->state = record->state;
+	context->nsapi = record->nsapi;
+	context->delete_pending = record->delete_pending;
+	memcpy(context->imsi, record->imsi, sizeof(context->imsi));
+	context->imsi[sizeof(context->imsi) - 1] = '\0';
+
+	return context;
+}
+
+//
+// This function saves the contexts of a table to snapshot records
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//  struct gtpv1_snapshot_record* records: The records, there must be room for the number of contexts in the table
+//
+// Return:
+//  u_int: The number of records saved
+//
+u_int gtpv1_context_save(struct gtpv1_context_table* table, struct gtpv1_snapshot_record* records)
+{
+	u_int count = 0;
+
+	for (u_int slot = 0; slot <= table->slot_mask; slot++) {
+		if (table->slots[slot].context == GTPV1_CONTEXT_NONE) {
+			continue;
+		}
+
+		struct gtpv1_context* context = &table->contexts[table->slots[slot].context];
+		struct gtpv1_snapshot_record* record = &records[count++];
+
+		memset(record, 0, sizeof(struct gtpv1_snapshot_record));
+		record->teid = context->teid;
+		record->peer = context->peer;
+		record->link_teid = context->link_teid;
+		record->link_peer = context->link_peer;
+		record->eua = context->eua;
+		record->expiry = context->expiry;
+		record->state = context->state;
+		record->nsapi = context->nsapi;
+		record->delete_pending = context->delete_pending;
+		memcpy(record->imsi, context->imsi, sizeof(record->imsi));
+	}
+
+	return count;
+}
+
+//
+// This function writes a snapshot file from sets of records, the records of each correlation shard for instance. The
+// file is written under a temporary name and renamed so that readers never see a partial snapshot
+//
+// Parameters:
+//  const char* path: The path of the snapshot file
+//  struct gtpv1_snapshot_record** record_sets: The sets of records
+//  u_int* record_counts: The number of records in each set
+//  u_int set_count: The number of sets
+//  time_t time: The time the snapshot was taken
+//  char* errbuf: The reason for an error is returned here, it must be GTPV1_SNAPSHOT_ERRBUF_SIZE long
+//
+// Return:
+//  int: 1 if the snapshot was written, 0 on errors
+//
+int gtpv1_snapshot_write(const char* path, struct gtpv1_snapshot_record** record_sets, u_int* record_counts, u_int set_count,
+		time_t time, char* errbuf)
+{
+	struct gtpv1_snapshot_header header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, GTPV1_SNAPSHOT_MAGIC, sizeof(header.magic));
+	header.version = GTPV1_SNAPSHOT_VERSION;
+	header.header_size = sizeof(struct gtpv1_snapshot_header);
+	header.record_size = sizeof(struct gtpv1_snapshot_record);
+	header.time = time;
+
+	for (u_int i = 0; i < set_count; i++) {
+		header.record_count += record_counts[i];
+		header.records_crc = crc32_update(header.records_crc, record_sets[i], record_counts[i] * sizeof(struct gtpv1_snapshot_record));
+	}
+	header.header_crc = crc32_update(0, &header, offsetof(struct gtpv1_snapshot_header, header_crc));
+
+	char temporary_path[FILENAME_MAX];
+	snprintf(temporary_path, FILENAME_MAX, "%s.tmp", path);
+
+	int fd = open(temporary_path, O_WRONLY|O_CREAT|O_TRUNC, 0644);
+	if (fd < 0) {
+		snprintf(errbuf, GTPV1_SNAPSHOT_ERRBUF_SIZE, "could not open the temporary file: %s", strerror(errno));
+		return 0;
+	}
+
+	int written = write(fd, &header, sizeof(header)) == sizeof(header);
+	for (u_int i = 0; written && i < set_count; i++) {
+		size_t length = record_counts[i] * sizeof(struct gtpv1_snapshot_record);
+		char* data = (char*)record_sets[i];
+		while (length > 0) {
+			ssize_t result = write(fd, data, length);
+			if (result <= 0) {
+				written = 0;
+				break;
+			}
+			data += result;
+			length -= result;
+		}
+	}
+
+	// The data must be on disk before the rename makes it the snapshot
+	if (!written || fsync(fd) != 0) {
+		snprintf(errbuf, GTPV1_SNAPSHOT_ERRBUF_SIZE, "could not write the temporary file: %s", strerror(errno));
+		close(fd);
+		unlink(temporary_path);
+		return 0;
+	}
+	close(fd);
+
+	if (rename(temporary_path, path) != 0) {
+		snprintf(errbuf, GTPV1_SNAPSHOT_ERRBUF_SIZE, "could not rename the temporary file: %s", strerror(errno));
+		unlink(temporary_path);
+		return 0;
+	}
+
+	return 1;
+}
+
+//
+// This function maps a snapshot file read only and checks its header and CRCs
+//
+// Parameters:
+//  const char* path: The path of the snapshot file
+//  size_t* size: The size of the mapping is returned here
+//  char* errbuf: The reason for an error is returned here, it must be GTPV1_SNAPSHOT_ERRBUF_SIZE long
+//
+// Return:
+//  struct gtpv1_snapshot_header*: The header of the mapped snapshot, its records follow it. NULL on errors
+//
+struct gtpv1_snapshot_header* gtpv1_snapshot_map(const char* path, size_t* size, char* errbuf)
+{
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		snprintf(errbuf, GTPV1_SNAPSHOT_ERRBUF_SIZE, "could not open: %s", strerror(errno));
+		return NULL;
+	}
+
+	struct stat snapshot_stat;
+	if (fstat(fd, &snapshot_stat) != 0 || (size_t)snapshot_stat.st_size < sizeof(struct gtpv1_snapshot_header)) {
+		snprintf(errbuf, GTPV1_SNAPSHOT_ERRBUF_SIZE, "not a snapshot");
+		close(fd);
+		return NULL;
+	}
+	*size = snapshot_stat.st_size;
+
+	void* snapshot = mmap(NULL, *size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (snapshot == MAP_FAILED) {
+		snprintf(errbuf, GTPV1_SNAPSHOT_ERRBUF_SIZE, "could not map: %s", strerror(errno));
+		return NULL;
+	}
+
+	struct gtpv1_snapshot_header* header = (struct gtpv1_snapshot_header*)snapshot;
+	if (memcmp(header->magic, GTPV1_SNAPSHOT_MAGIC, sizeof(header->magic))
+			|| header->header_crc != crc32_update(0, header, offsetof(struct gtpv1_snapshot_header, header_crc))) {
+		snprintf(errbuf, GTPV1_SNAPSHOT_ERRBUF_SIZE, "not a snapshot or the header is corrupt");
+		munmap(snapshot, *size);
+		return NULL;
+	}
+
+	if (header->version != GTPV1_SNAPSHOT_VERSION
+			|| header->header_size != sizeof(struct gtpv1_snapshot_header)
+			|| header->record_size != sizeof(struct gtpv1_snapshot_record)) {
+		snprintf(errbuf, GTPV1_SNAPSHOT_ERRBUF_SIZE, "version %u, this program reads version %d", header->version, GTPV1_SNAPSHOT_VERSION);
+		munmap(snapshot, *size);
+		return NULL;
+	}
+
+	size_t records_size = (size_t)header->record_count * header->record_size;
+	if (*size < header->header_size + records_size) {
+		snprintf(errbuf, GTPV1_SNAPSHOT_ERRBUF_SIZE, "truncated");
+		munmap(snapshot, *size);
+		return NULL;
+	}
+
+	if (header->records_crc != crc32_update(0, (char*)header + header->header_size, records_size)) {
+		snprintf(errbuf, GTPV1_SNAPSHOT_ERRBUF_SIZE, "CRC error in the records");
+		munmap(snapshot, *size);
+		return NULL;
+	}
+
+	return header;
+}
+
+//
+// This function unmaps a snapshot file
+//
+// Parameters:
+//  struct gtpv1_snapshot_header* header: The header of the mapped snapshot
+//  size_t size: The size of the mapping
+//
+void gtpv1_snapshot_unmap(struct gtpv1_snapshot_header* header, size_t size)
+{
+	munmap(header, size);
+}
+
+//
+// This function finds the slot of a key in the hash table, or the empty slot where the key would be added
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//  u_int teid: The TEID
+//  u_int peer: The peer address
+//
+// Return:
+//  u_int: The slot
+//
+static u_int gtpv1_context_find_slot(struct gtpv1_context_table* table, u_int teid, u_int peer)
+{
+	u_int slot = gtpv1_context_hash(teid, peer) & table->slot_mask;
+
+	while (table->slots[slot].context != GTPV1_CONTEXT_NONE) {
+		if (table->slots[slot].teid == teid && table->slots[slot].peer == peer) {
+			break;
+		}
+		slot = (slot + 1) & table->slot_mask;
+	}
+
+	return slot;
+}
+
+//
+// This function resizes the hash table and rehashes the contexts into it
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//  u_int slot_count: The new number of slots, a power of two
+//
+// Return:
+//  int: 1 if the table was resized, 0 if memory could not be allocated
+//
+static int gtpv1_context_table_resize(struct gtpv1_context_table* table, u_int slot_count)
+{
+	struct gtpv1_context_slot* slots = (struct gtpv1_context_slot*) malloc(slot_count * sizeof(struct gtpv1_context_slot));
+	if (slots == NULL) {
+		return 0;
+	}
+	for (u_int i = 0; i < slot_count; i++) {
+		slots[i].context = GTPV1_CONTEXT_NONE;
+	}
+
+	struct gtpv1_context_slot* old_slots = table->slots;
+	u_int old_slot_count = old_slots == NULL ? 0 : table->slot_mask + 1;
+
+	table->slots = slots;
+	table->slot_mask = slot_count - 1;
+
+	for (u_int i = 0; i < old_slot_count; i++) {
+		if (old_slots[i].context != GTPV1_CONTEXT_NONE) {
+			table->slots[gtpv1_context_find_slot(table, old_slots[i].teid, old_slots[i].peer)] = old_slots[i];
+		}
+	}
+
+	free(old_slots);
+	return 1;
+}
+
+//
+// This function links a context into the timing wheel slot for its expiry time, contexts that do not expire are not linked
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//  u_int index: The index of the context
+//
+static void gtpv1_context_wheel_insert(struct gtpv1_context_table* table, u_int index)
+{
+	struct gtpv1_context* context = &table->contexts[index];
+	if (context->expiry == GTPV1_CONTEXT_NEVER) {
+		return;
+	}
+	u_int* head = &table->wheel[context->expiry & (GTPV1_CONTEXT_WHEEL_SIZE - 1)];
+
+	context->wheel_prev = GTPV1_CONTEXT_NONE;
+	context->wheel_next = *head;
+	if (*head != GTPV1_CONTEXT_NONE) {
+		table->contexts[*head].wheel_prev = index;
+	}
+	*head = index;
+}
+
+//
+// This function unlinks a context from its timing wheel slot
+//
+// Parameters:
+//  struct gtpv1_context_table* table: The table
+//  u_int index: The index of the context
+//
+static void gtpv1_context_wheel_unlink(struct gtpv1_context_table* table, u_int index)
+{
+	struct gtpv1_context* context = &table->contexts[index];
+	if (context->expiry == GTPV1_CONTEXT_NEVER) {
+		return;
+	}
+
+	if (context->wheel_prev != GTPV1_CONTEXT_NONE) {
+		table->contexts[context->wheel_prev].wheel_next = context->wheel_next;
+	}
+	else {
+		table->wheel[context->expiry & (GTPV1_CONTEXT_WHEEL_SIZE - 1)] = context->wheel_next;
+	}
+
+	if (context->wheel_next != GTPV1_CONTEXT_NONE) {
+		table->contexts[context->wheel_next].wheel_prev = context->wheel_prev;
+	}
+}
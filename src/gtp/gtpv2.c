@@ -0,0 +1,106 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: gtpv2.c
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This module handles the GTP-C V2 protocol used on the S11 and S5/S8 interfaces of LTE cores
+ */
+
+#include <stdio.h>
+#include <arpa/inet.h>
+#include <netinet/ip.h>
+#include <netinet/udp.h>
+
+#include <gtpv1.h>
+#include <gtpv2.h>
+
+//
+// This function returns a pointer to a GTPv2-C header in a packet in a data buffer
+//
+// Parameters:
+//  int linktype: The link layer type of the capture, DLT_EN10MB or DLT_LINUX_SLL
+//  const unsigned int length: The amount of data present in the data buffer
+//  const unsigned char* data: A pointer to the packet data
+//
+// Return:
+//  gtpv2hdr*: A pointer to a GTP V2 header if a GTP V2 control packet is present, NULL otherwise
+//
+struct gtpv2hdr* gtpv2_get_header(int linktype, const unsigned int length, const unsigned char* data)
+{
+	// Find the outer IP header, the link layer is handled the same way as for GTP V1
+	struct ip* ip_header = gtpv1_get_ip_header(linktype, length, data);
+	if (ip_header == NULL) {
+		return NULL;
+	}
+
+	// Keep track of the current position to avoid complex casts
+	unsigned int offset = (const unsigned char*)ip_header - data;
+
+	// Check if the enclosing protocol is UDP, GTP is carried in UDP, and that the IP header length is valid
+	if (ip_header->ip_p != IPPROTO_UDP || ip_header->ip_hl < 5) {
+		return NULL;
+	}
+
+	// Set the UDP header pointer to the end of the IP header, The IP header length is in units of 4 octets
+	offset +=  ip_header->ip_hl * 4;
+
+	// Check if there is enough data for the UDP header
+	if (offset + sizeof(struct udphdr) > length) {
+		return NULL;
+	}
+
+	// Set the UDP header pointer
+	struct udphdr* udp_header = (struct udphdr*)(data + offset);
+
+	// GTP V2 is only used on the control plane
+	if (ntohs(udp_header->uh_sport) != GTP_C_UDP_PORT && ntohs(udp_header->uh_dport) != GTP_C_UDP_PORT) {
+		return NULL;
+	}
+
+	// Set the GTP V2 header pointer to the end of the UDP header
+	offset +=  sizeof(struct udphdr);
+
+	// Check if there is enough data for the mandatory part of the header
+	if (offset + GTPV2_MANDATORY_HEADER_LENGTH > length) {
+		return NULL;
+	}
+
+	struct gtpv2hdr* gtpv2_header = (struct gtpv2hdr*)(data + offset);
+
+	// Check for GTP Version 2 and that the rest of the header is present
+	if (gtpv2_header->version != GTP_V2_VERSION || offset + GTPV2_HEADER_LENGTH(gtpv2_header) > length) {
+		return NULL;
+	}
+
+	return gtpv2_header;
+}
+
+//
+// This function returns the TEID of a GTPv2-C message
+//
+// Parameters:
+//  const struct gtpv2hdr* gtpv2hdr: The header of the message
+//
+// Return:
+//  u_int: The TEID in host byte order, 0 if the message has no TEID
+//
+u_int gtpv2_get_teid(const struct gtpv2hdr* gtpv2hdr)
+{
+	if (!gtpv2hdr->flag_teid) {
+		return 0;
+	}
+
+	const u_char* teid = ((const u_char*)gtpv2hdr) + GTPV2_MANDATORY_HEADER_LENGTH;
+	return (teid[0] << 24) + (teid[1] << 16) + (teid[2] << 8) + teid[3];
+}
@@ -0,0 +1,145 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: gtpv2_information_elements.c
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This module manages GTP V2 information elements
+ */
+
+#include <gtpv2_information_elements.h>
+
+// The flags of all GTP V2 information elements, indexed by type, unknown types are all zero
+const struct gtpv2_information_element gtpv2_information_elements[MAX_GTPV2_INFORMATION_ELEMENTS] = {
+	[GTPV2_IE_BEARER_CONTEXT] = { .grouped = 1 },
+	[GTPV2_IE_PDN_CONNECTION] = { .grouped = 1 },
+	[GTPV2_IE_OVERLOAD_CONTROL_INFORMATION] = { .grouped = 1 },
+	[GTPV2_IE_LOAD_CONTROL_INFORMATION] = { .grouped = 1 },
+};
+
+// The names of all GTP V2 information elements, indexed by type, NULL for unknown types
+const char* const gtpv2_information_element_names[MAX_GTPV2_INFORMATION_ELEMENTS] = {
+	[GTPV2_IE_IMSI] = "International Mobile Subscriber Identity (IMSI)",
+	[GTPV2_IE_CAUSE] = "Cause",
+	[GTPV2_IE_RECOVERY] = "Recovery (Restart Counter)",
+	[GTPV2_IE_APN] = "Access Point Name (APN)",
+	[GTPV2_IE_AMBR] = "Aggregate Maximum Bit Rate (AMBR)",
+	[GTPV2_IE_EBI] = "EPS Bearer ID (EBI)",
+	[GTPV2_IE_IP_ADDRESS] = "IP Address",
+	[GTPV2_IE_MEI] = "Mobile Equipment Identity (MEI)",
+	[GTPV2_IE_MSISDN] = "MSISDN",
+	[GTPV2_IE_INDICATION] = "Indication",
+	[GTPV2_IE_PCO] = "Protocol Configuration Options (PCO)",
+	[GTPV2_IE_PAA] = "PDN Address Allocation (PAA)",
+	[GTPV2_IE_BEARER_QOS] = "Bearer Level Quality of Service (Bearer QoS)",
+	[GTPV2_IE_FLOW_QOS] = "Flow Quality of Service (Flow QoS)",
+	[GTPV2_IE_RAT_TYPE] = "RAT Type",
+	[GTPV2_IE_SERVING_NETWORK] = "Serving Network",
+	[GTPV2_IE_BEARER_TFT] = "EPS Bearer Level Traffic Flow Template (Bearer TFT)",
+	[GTPV2_IE_TAD] = "Traffic Aggregation Description (TAD)",
+	[GTPV2_IE_ULI] = "User Location Information (ULI)",
+	[GTPV2_IE_F_TEID] = "Fully Qualified Tunnel Endpoint Identifier (F-TEID)",
+	[GTPV2_IE_TMSI] = "TMSI",
+	[GTPV2_IE_GLOBAL_CN_ID] = "Global CN-Id",
+	[GTPV2_IE_S103PDF] = "S103 PDN Data Forwarding Info (S103PDF)",
+	[GTPV2_IE_S1UDF] = "S1-U Data Forwarding Info (S1UDF)",
+	[GTPV2_IE_DELAY_VALUE] = "Delay Value",
+	[GTPV2_IE_BEARER_CONTEXT] = "Bearer Context",
+	[GTPV2_IE_CHARGING_ID] = "Charging ID",
+	[GTPV2_IE_CHARGING_CHARACTERISTICS] = "Charging Characteristics",
+	[GTPV2_IE_TRACE_INFORMATION] = "Trace Information",
+	[GTPV2_IE_BEARER_FLAGS] = "Bearer Flags",
+	[GTPV2_IE_PDN_TYPE] = "PDN Type",
+	[GTPV2_IE_PTI] = "Procedure Transaction ID",
+	[GTPV2_IE_MM_CONTEXT_GSM_KEY_TRIPLETS] = "MM Context (GSM Key and Triplets)",
+	[GTPV2_IE_MM_CONTEXT_UMTS_KEY_CIPHER_QUINTUPLETS] = "MM Context (UMTS Key, Used Cipher and Quintuplets)",
+	[GTPV2_IE_MM_CONTEXT_GSM_KEY_CIPHER_QUINTUPLETS] = "MM Context (GSM Key, Used Cipher and Quintuplets)",
+	[GTPV2_IE_MM_CONTEXT_UMTS_KEY_QUINTUPLETS] = "MM Context (UMTS Key and Quintuplets)",
+	[GTPV2_IE_MM_CONTEXT_EPS_SECURITY_CONTEXT] = "MM Context (EPS Security Context, Quadruplets and Quintuplets)",
+	[GTPV2_IE_MM_CONTEXT_UMTS_KEY_QUADRUPLETS_QUINTUPLETS] = "MM Context (UMTS Key, Quadruplets and Quintuplets)",
+	[GTPV2_IE_PDN_CONNECTION] = "PDN Connection",
+	[GTPV2_IE_PDU_NUMBERS] = "PDU Numbers",
+	[GTPV2_IE_P_TMSI] = "P-TMSI",
+	[GTPV2_IE_P_TMSI_SIGNATURE] = "P-TMSI Signature",
+	[GTPV2_IE_HOP_COUNTER] = "Hop Counter",
+	[GTPV2_IE_UE_TIME_ZONE] = "UE Time Zone",
+	[GTPV2_IE_TRACE_REFERENCE] = "Trace Reference",
+	[GTPV2_IE_COMPLETE_REQUEST_MESSAGE] = "Complete Request Message",
+	[GTPV2_IE_GUTI] = "GUTI",
+	[GTPV2_IE_F_CONTAINER] = "F-Container",
+	[GTPV2_IE_F_CAUSE] = "F-Cause",
+	[GTPV2_IE_PLMN_ID] = "PLMN ID",
+	[GTPV2_IE_TARGET_IDENTIFICATION] = "Target Identification",
+	[GTPV2_IE_PACKET_FLOW_ID] = "Packet Flow ID",
+	[GTPV2_IE_RAB_CONTEXT] = "RAB Context",
+	[GTPV2_IE_SOURCE_RNC_PDCP_CONTEXT_INFO] = "Source RNC PDCP Context Info",
+	[GTPV2_IE_UDP_SOURCE_PORT_NUMBER] = "UDP Source Port Number",
+	[GTPV2_IE_APN_RESTRICTION] = "APN Restriction",
+	[GTPV2_IE_SELECTION_MODE] = "Selection Mode",
+	[GTPV2_IE_SOURCE_IDENTIFICATION] = "Source Identification",
+	[GTPV2_IE_CHANGE_REPORTING_ACTION] = "Change Reporting Action",
+	[GTPV2_IE_FQ_CSID] = "Fully Qualified PDN Connection Set Identifier (FQ-CSID)",
+	[GTPV2_IE_CHANNEL_NEEDED] = "Channel Needed",
+	[GTPV2_IE_EMLPP_PRIORITY] = "eMLPP Priority",
+	[GTPV2_IE_NODE_TYPE] = "Node Type",
+	[GTPV2_IE_FQDN] = "Fully Qualified Domain Name (FQDN)",
+	[GTPV2_IE_TI] = "Transaction Identifier (TI)",
+	[GTPV2_IE_MBMS_SESSION_DURATION] = "MBMS Session Duration",
+	[GTPV2_IE_MBMS_SERVICE_AREA] = "MBMS Service Area",
+	[GTPV2_IE_MBMS_SESSION_IDENTIFIER] = "MBMS Session Identifier",
+	[GTPV2_IE_MBMS_FLOW_IDENTIFIER] = "MBMS Flow Identifier",
+	[GTPV2_IE_MBMS_IP_MULTICAST_DISTRIBUTION] = "MBMS IP Multicast Distribution",
+	[GTPV2_IE_MBMS_DISTRIBUTION_ACKNOWLEDGE] = "MBMS Distribution Acknowledge",
+	[GTPV2_IE_RFSP_INDEX] = "RFSP Index",
+	[GTPV2_IE_UCI] = "User CSG Information (UCI)",
+	[GTPV2_IE_CSG_INFORMATION_REPORTING_ACTION] = "CSG Information Reporting Action",
+	[GTPV2_IE_CSG_ID] = "CSG ID",
+	[GTPV2_IE_CMI] = "CSG Membership Indication (CMI)",
+	[GTPV2_IE_SERVICE_INDICATOR] = "Service Indicator",
+	[GTPV2_IE_DETACH_TYPE] = "Detach Type",
+	[GTPV2_IE_LDN] = "Local Distinguished Name (LDN)",
+	[GTPV2_IE_NODE_FEATURES] = "Node Features",
+	[GTPV2_IE_MBMS_TIME_TO_DATA_TRANSFER] = "MBMS Time to Data Transfer",
+	[GTPV2_IE_THROTTLING] = "Throttling",
+	[GTPV2_IE_ARP] = "Allocation/Retention Priority (ARP)",
+	[GTPV2_IE_EPC_TIMER] = "EPC Timer",
+	[GTPV2_IE_SIGNALLING_PRIORITY_INDICATION] = "Signalling Priority Indication",
+	[GTPV2_IE_TMGI] = "Temporary Mobile Group Identity (TMGI)",
+	[GTPV2_IE_ADDITIONAL_MM_CONTEXT_FOR_SRVCC] = "Additional MM Context for SRVCC",
+	[GTPV2_IE_ADDITIONAL_FLAGS_FOR_SRVCC] = "Additional Flags for SRVCC",
+	[GTPV2_IE_MDT_CONFIGURATION] = "MDT Configuration",
+	[GTPV2_IE_APCO] = "Additional Protocol Configuration Options (APCO)",
+	[GTPV2_IE_ABSOLUTE_TIME_OF_MBMS_DATA_TRANSFER] = "Absolute Time of MBMS Data Transfer",
+	[GTPV2_IE_HENB_INFORMATION_REPORTING] = "H(e)NB Information Reporting",
+	[GTPV2_IE_IPV4_CONFIGURATION_PARAMETERS] = "IPv4 Configuration Parameters (IP4CP)",
+	[GTPV2_IE_CHANGE_TO_REPORT_FLAGS] = "Change to Report Flags",
+	[GTPV2_IE_ACTION_INDICATION] = "Action Indication",
+	[GTPV2_IE_TWAN_IDENTIFIER] = "TWAN Identifier",
+	[GTPV2_IE_ULI_TIMESTAMP] = "ULI Timestamp",
+	[GTPV2_IE_MBMS_FLAGS] = "MBMS Flags",
+	[GTPV2_IE_RAN_NAS_CAUSE] = "RAN/NAS Cause",
+	[GTPV2_IE_CN_OPERATOR_SELECTION_ENTITY] = "CN Operator Selection Entity",
+	[GTPV2_IE_TWMI] = "Trusted WLAN Mode Indication",
+	[GTPV2_IE_NODE_NUMBER] = "Node Number",
+	[GTPV2_IE_NODE_IDENTIFIER] = "Node Identifier",
+	[GTPV2_IE_PRESENCE_REPORTING_AREA_ACTION] = "Presence Reporting Area Action",
+	[GTPV2_IE_PRESENCE_REPORTING_AREA_INFORMATION] = "Presence Reporting Area Information",
+	[GTPV2_IE_TWAN_IDENTIFIER_TIMESTAMP] = "TWAN Identifier Timestamp",
+	[GTPV2_IE_OVERLOAD_CONTROL_INFORMATION] = "Overload Control Information",
+	[GTPV2_IE_LOAD_CONTROL_INFORMATION] = "Load Control Information",
+	[GTPV2_IE_METRIC] = "Metric",
+	[GTPV2_IE_SEQUENCE_NUMBER] = "Sequence Number",
+	[GTPV2_IE_APN_AND_RELATIVE_CAPACITY] = "APN and Relative Capacity",
+	[GTPV2_IE_WLAN_OFFLOADABILITY_INDICATION] = "WLAN Offloadability Indication",
+	[GTPV2_IE_PRIVATE_EXTENSION] = "Private Extension",
+};
@@ -0,0 +1,95 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: gtpv2_message_types.c
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This module manages GTP V2 message types
+ */
+
+#include <gtpv2_message_types.h>
+
+// The names of all GTP V2 message types, indexed by type, NULL for unknown types
+const char* const gtpv2_message_type_names[MAX_GTPV2_MESSAGE_TYPES] = {
+	[GTPV2_MT_ECHO_REQUEST] = "ECHO_REQUEST",
+	[GTPV2_MT_ECHO_RESPONSE] = "ECHO_RESPONSE",
+	[GTPV2_MT_VERSION_NOT_SUPPORTED] = "VERSION_NOT_SUPPORTED",
+	[GTPV2_MT_CREATE_SESSION_REQUEST] = "CREATE_SESSION_REQUEST",
+	[GTPV2_MT_CREATE_SESSION_RESPONSE] = "CREATE_SESSION_RESPONSE",
+	[GTPV2_MT_MODIFY_BEARER_REQUEST] = "MODIFY_BEARER_REQUEST",
+	[GTPV2_MT_MODIFY_BEARER_RESPONSE] = "MODIFY_BEARER_RESPONSE",
+	[GTPV2_MT_DELETE_SESSION_REQUEST] = "DELETE_SESSION_REQUEST",
+	[GTPV2_MT_DELETE_SESSION_RESPONSE] = "DELETE_SESSION_RESPONSE",
+	[GTPV2_MT_CHANGE_NOTIFICATION_REQUEST] = "CHANGE_NOTIFICATION_REQUEST",
+	[GTPV2_MT_CHANGE_NOTIFICATION_RESPONSE] = "CHANGE_NOTIFICATION_RESPONSE",
+	[GTPV2_MT_MODIFY_BEARER_COMMAND] = "MODIFY_BEARER_COMMAND",
+	[GTPV2_MT_MODIFY_BEARER_FAILURE_INDICATION] = "MODIFY_BEARER_FAILURE_INDICATION",
+	[GTPV2_MT_DELETE_BEARER_COMMAND] = "DELETE_BEARER_COMMAND",
+	[GTPV2_MT_DELETE_BEARER_FAILURE_INDICATION] = "DELETE_BEARER_FAILURE_INDICATION",
+	[GTPV2_MT_BEARER_RESOURCE_COMMAND] = "BEARER_RESOURCE_COMMAND",
+	[GTPV2_MT_BEARER_RESOURCE_FAILURE_INDICATION] = "BEARER_RESOURCE_FAILURE_INDICATION",
+	[GTPV2_MT_DOWNLINK_DATA_NOTIFICATION_FAILURE_INDICATION] = "DOWNLINK_DATA_NOTIFICATION_FAILURE_INDICATION",
+	[GTPV2_MT_TRACE_SESSION_ACTIVATION] = "TRACE_SESSION_ACTIVATION",
+	[GTPV2_MT_TRACE_SESSION_DEACTIVATION] = "TRACE_SESSION_DEACTIVATION",
+	[GTPV2_MT_STOP_PAGING_INDICATION] = "STOP_PAGING_INDICATION",
+	[GTPV2_MT_CREATE_BEARER_REQUEST] = "CREATE_BEARER_REQUEST",
+	[GTPV2_MT_CREATE_BEARER_RESPONSE] = "CREATE_BEARER_RESPONSE",
+	[GTPV2_MT_UPDATE_BEARER_REQUEST] = "UPDATE_BEARER_REQUEST",
+	[GTPV2_MT_UPDATE_BEARER_RESPONSE] = "UPDATE_BEARER_RESPONSE",
+	[GTPV2_MT_DELETE_BEARER_REQUEST] = "DELETE_BEARER_REQUEST",
+	[GTPV2_MT_DELETE_BEARER_RESPONSE] = "DELETE_BEARER_RESPONSE",
+	[GTPV2_MT_DELETE_PDN_CONNECTION_SET_REQUEST] = "DELETE_PDN_CONNECTION_SET_REQUEST",
+	[GTPV2_MT_DELETE_PDN_CONNECTION_SET_RESPONSE] = "DELETE_PDN_CONNECTION_SET_RESPONSE",
+	[GTPV2_MT_IDENTIFICATION_REQUEST] = "IDENTIFICATION_REQUEST",
+	[GTPV2_MT_IDENTIFICATION_RESPONSE] = "IDENTIFICATION_RESPONSE",
+	[GTPV2_MT_CONTEXT_REQUEST] = "CONTEXT_REQUEST",
+	[GTPV2_MT_CONTEXT_RESPONSE] = "CONTEXT_RESPONSE",
+	[GTPV2_MT_CONTEXT_ACKNOWLEDGE] = "CONTEXT_ACKNOWLEDGE",
+	[GTPV2_MT_FORWARD_RELOCATION_REQUEST] = "FORWARD_RELOCATION_REQUEST",
+	[GTPV2_MT_FORWARD_RELOCATION_RESPONSE] = "FORWARD_RELOCATION_RESPONSE",
+	[GTPV2_MT_FORWARD_RELOCATION_COMPLETE_NOTIFICATION] = "FORWARD_RELOCATION_COMPLETE_NOTIFICATION",
+	[GTPV2_MT_FORWARD_RELOCATION_COMPLETE_ACKNOWLEDGE] = "FORWARD_RELOCATION_COMPLETE_ACKNOWLEDGE",
+	[GTPV2_MT_FORWARD_ACCESS_CONTEXT_NOTIFICATION] = "FORWARD_ACCESS_CONTEXT_NOTIFICATION",
+	[GTPV2_MT_FORWARD_ACCESS_CONTEXT_ACKNOWLEDGE] = "FORWARD_ACCESS_CONTEXT_ACKNOWLEDGE",
+	[GTPV2_MT_RELOCATION_CANCEL_REQUEST] = "RELOCATION_CANCEL_REQUEST",
+	[GTPV2_MT_RELOCATION_CANCEL_RESPONSE] = "RELOCATION_CANCEL_RESPONSE",
+	[GTPV2_MT_CONFIGURATION_TRANSFER_TUNNEL] = "CONFIGURATION_TRANSFER_TUNNEL",
+	[GTPV2_MT_DETACH_NOTIFICATION] = "DETACH_NOTIFICATION",
+	[GTPV2_MT_DETACH_ACKNOWLEDGE] = "DETACH_ACKNOWLEDGE",
+	[GTPV2_MT_CS_PAGING_INDICATION] = "CS_PAGING_INDICATION",
+	[GTPV2_MT_RAN_INFORMATION_RELAY] = "RAN_INFORMATION_RELAY",
+	[GTPV2_MT_ALERT_MME_NOTIFICATION] = "ALERT_MME_NOTIFICATION",
+	[GTPV2_MT_ALERT_MME_ACKNOWLEDGE] = "ALERT_MME_ACKNOWLEDGE",
+	[GTPV2_MT_UE_ACTIVITY_NOTIFICATION] = "UE_ACTIVITY_NOTIFICATION",
+	[GTPV2_MT_UE_ACTIVITY_ACKNOWLEDGE] = "UE_ACTIVITY_ACKNOWLEDGE",
+	[GTPV2_MT_CREATE_FORWARDING_TUNNEL_REQUEST] = "CREATE_FORWARDING_TUNNEL_REQUEST",
+	[GTPV2_MT_CREATE_FORWARDING_TUNNEL_RESPONSE] = "CREATE_FORWARDING_TUNNEL_RESPONSE",
+	[GTPV2_MT_SUSPEND_NOTIFICATION] = "SUSPEND_NOTIFICATION",
+	[GTPV2_MT_SUSPEND_ACKNOWLEDGE] = "SUSPEND_ACKNOWLEDGE",
+	[GTPV2_MT_RESUME_NOTIFICATION] = "RESUME_NOTIFICATION",
+	[GTPV2_MT_RESUME_ACKNOWLEDGE] = "RESUME_ACKNOWLEDGE",
+	[GTPV2_MT_CREATE_INDIRECT_DATA_FORWARDING_TUNNEL_REQUEST] = "CREATE_INDIRECT_DATA_FORWARDING_TUNNEL_REQUEST",
+	[GTPV2_MT_CREATE_INDIRECT_DATA_FORWARDING_TUNNEL_RESPONSE] = "CREATE_INDIRECT_DATA_FORWARDING_TUNNEL_RESPONSE",
+	[GTPV2_MT_DELETE_INDIRECT_DATA_FORWARDING_TUNNEL_REQUEST] = "DELETE_INDIRECT_DATA_FORWARDING_TUNNEL_REQUEST",
+	[GTPV2_MT_DELETE_INDIRECT_DATA_FORWARDING_TUNNEL_RESPONSE] = "DELETE_INDIRECT_DATA_FORWARDING_TUNNEL_RESPONSE",
+	[GTPV2_MT_RELEASE_ACCESS_BEARERS_REQUEST] = "RELEASE_ACCESS_BEARERS_REQUEST",
+	[GTPV2_MT_RELEASE_ACCESS_BEARERS_RESPONSE] = "RELEASE_ACCESS_BEARERS_RESPONSE",
+	[GTPV2_MT_DOWNLINK_DATA_NOTIFICATION] = "DOWNLINK_DATA_NOTIFICATION",
+	[GTPV2_MT_DOWNLINK_DATA_NOTIFICATION_ACKNOWLEDGE] = "DOWNLINK_DATA_NOTIFICATION_ACKNOWLEDGE",
+	[GTPV2_MT_PGW_RESTART_NOTIFICATION] = "PGW_RESTART_NOTIFICATION",
+	[GTPV2_MT_PGW_RESTART_NOTIFICATION_ACKNOWLEDGE] = "PGW_RESTART_NOTIFICATION_ACKNOWLEDGE",
+	[GTPV2_MT_UPDATE_PDN_CONNECTION_SET_REQUEST] = "UPDATE_PDN_CONNECTION_SET_REQUEST",
+	[GTPV2_MT_UPDATE_PDN_CONNECTION_SET_RESPONSE] = "UPDATE_PDN_CONNECTION_SET_RESPONSE",
+	[GTPV2_MT_MODIFY_ACCESS_BEARERS_REQUEST] = "MODIFY_ACCESS_BEARERS_REQUEST",
+	[GTPV2_MT_MODIFY_ACCESS_BEARERS_RESPONSE] = "MODIFY_ACCESS_BEARERS_RESPONSE",
+};
@@ -0,0 +1,179 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: tbcd.c
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This module decodes TBCD digit strings. Nibbles are looked up in a table. Runs of four octets that hold only decimal
+ * digits, which is all but the last octet of an ordinary IMSI, are handled as one 64 bit word: the nibbles are spread
+ * to one per octet, checked for decimal digits in one step and then either turned into characters or combined into a
+ * number with three multiplications
+ */
+
+#include <stdint.h>
+
+#include <tbcd.h>
+
+// The character for each TBCD nibble, the filler maps to the terminator
+static const char tbcd_characters[16] = "0123456789*#abc";
+
+// Forward definition of private functions
+static inline int tbcd_spread(const u_char* tbcd, uint64_t* digits);
+
+//
+// This function converts a TBCD string to a string of digits, the digits stop at the first filler. The TBCD values
+// 0xa to 0xe are written as '*', '#', 'a', 'b' and 'c'
+//
+// Parameters:
+//  const u_char* tbcd: The TBCD octets
+//  u_int length: The number of TBCD octets
+//  char* string: The string into which to write the digits, it is always terminated
+//  u_int size: The size of the string, digits that do not fit are dropped
+//
+// Return:
+//  int: The number of digits written
+//
+int tbcd2str(const u_char* tbcd, u_int length, char* string, u_int size)
+{
+	if (size == 0) {
+		return 0;
+	}
+
+	u_int digit_count = 0;
+	u_int octet = 0;
+	uint64_t digits;
+
+	// Four octets of decimal digits at a time
+	while (octet + 4 <= length && digit_count + 8 < size && tbcd_spread(tbcd + octet, &digits)) {
+		digits += 0x3030303030303030ULL;
+		for (int i = 0; i < 8; i++) {
+			string[digit_count + i] = (char)(digits >> (i * 8));
+		}
+
+		digit_count += 8;
+		octet += 4;
+	}
+
+	for (; octet < length; octet++) {
+		if (digit_count + 1 >= size || (tbcd[octet] & 0x0f) == TBCD_FILLER) {
+			break;
+		}
+		string[digit_count++] = tbcd_characters[tbcd[octet] & 0x0f];
+
+		if (digit_count + 1 >= size || (tbcd[octet] >> 4) == TBCD_FILLER) {
+			break;
+		}
+		string[digit_count++] = tbcd_characters[tbcd[octet] >> 4];
+	}
+
+	string[digit_count] = '\0';
+	return digit_count;
+}
+
+//
+// This function converts a TBCD string of decimal digits to a number, the digits stop at the first filler
+//
+// Parameters:
+//  const u_char* tbcd: The TBCD octets
+//  u_int length: The number of TBCD octets
+//  unsigned long long* number: The number is returned here
+//
+// Return:
+//  int: The number of digits converted, -1 if there is a digit that is not decimal or more than 19 digits
+//
+int tbcd2longlong(const u_char* tbcd, u_int length, unsigned long long* number)
+{
+	unsigned long long value = 0;
+	int digit_count = 0;
+	u_int octet = 0;
+	uint64_t digits;
+
+	// Four octets of decimal digits at a time, the first digit is in the lowest octet of the word
+	while (octet + 4 <= length && digit_count + 8 <= 19 && tbcd_spread(tbcd + octet, &digits)) {
+		digits = (digits * 10 + (digits >> 8)) & 0x00ff00ff00ff00ffULL;
+		digits = (digits * 100 + (digits >> 16)) & 0x0000ffff0000ffffULL;
+		digits = (digits * 10000 + (digits >> 32)) & 0xffffffffULL;
+
+		value = value * 100000000ULL + digits;
+		digit_count += 8;
+		octet += 4;
+	}
+
+	for (; octet < length; octet++) {
+		for (int shift = 0; shift <= 4; shift += 4) {
+			u_int nibble = (tbcd[octet] >> shift) & 0x0f;
+			if (nibble == TBCD_FILLER) {
+				*number = value;
+				return digit_count;
+			}
+			if (nibble > 9 || digit_count == 19) {
+				return -1;
+			}
+
+			value = value * 10 + nibble;
+			digit_count++;
+		}
+	}
+
+	*number = value;
+	return digit_count;
+}
+
+//
+// This function converts the body of a GTP V1 MSISDN information element to a string of digits, skipping the
+// address octet. A GTP V2 MSISDN has no address octet and is converted with tbcd2str()
+//
+// Parameters:
+//  const u_char* body: The body of the information element
+//  u_int length: The length of the body
+//  char* string: The string into which to write the digits, it is always terminated
+//  u_int size: The size of the string, digits that do not fit are dropped
+//
+// Return:
+//  int: The number of digits written
+//
+int msisdn2str(const u_char* body, u_int length, char* string, u_int size)
+{
+	if (length < TBCD_MSISDN_ADDRESS_LENGTH) {
+		return tbcd2str(body, 0, string, size);
+	}
+
+	return tbcd2str(body + TBCD_MSISDN_ADDRESS_LENGTH, length - TBCD_MSISDN_ADDRESS_LENGTH, string, size);
+}
+
+//
+// This function spreads the eight nibbles of four TBCD octets to one digit per octet of a word, in the order of the
+// digits starting at the lowest octet
+//
+// Parameters:
+//  const u_char* tbcd: The four TBCD octets
+//  uint64_t* digits: The digits are returned here
+//
+// Return:
+//  int: 1 if all eight nibbles are decimal digits, 0 otherwise
+//
+static inline int tbcd_spread(const u_char* tbcd, uint64_t* digits)
+{
+	uint64_t word = (uint64_t)tbcd[0] | (uint64_t)tbcd[1] << 16 | (uint64_t)tbcd[2] << 32 | (uint64_t)tbcd[3] << 48;
+
+	// The low nibble stays in its octet and the high nibble moves up to the next one
+	word = (word & 0x000f000f000f000fULL) | (word & 0x00f000f000f000f0ULL) << 4;
+
+	// Adding 0x76 sets the top bit of any octet above 9
+	if ((word + 0x7676767676767676ULL) & 0x8080808080808080ULL) {
+		return 0;
+	}
+
+	*digits = word;
+	return 1;
+}
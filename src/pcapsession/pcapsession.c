@@ -32,6 +32,7 @@ static int session_handling_state = PCAP_SESSION_STOPPED;
 
 // Forward references of internal functions
 void* pcapsession_supervision_run(void* notused_param);
+void* pcapsession_thread_run(void* pcapsession_param);
 void pcapsession_transition_session(int session_no);
 
 // Mutex associated with changing state
@@ -173,7 +174,7 @@ int pcapsession_start(int session_id)
 	write_to_syslog( "spawning new thread for PCAP session: %d-%s\n", session_id, session_list[session_id].description);
 
 	// The socket server thread accepts and administers connections from clients
-	if (pthread_create(&session_list[session_id].thread, NULL, session_list[session_id].runner, &session_list[session_id]) != 0) {
+	if (pthread_create(&session_list[session_id].thread, NULL, pcapsession_thread_run, &session_list[session_id]) != 0) {
 		write_to_syslog( "failed to spawn new thread for PCAP session: %d-%s\n", session_id, session_list[session_id].description);
 		return 0;
 	}
@@ -182,6 +183,24 @@ int pcapsession_start(int session_id)
 	return 1;
 }
 
+//
+// This function is the entry point of a PCAP session thread, it registers the thread for monitoring and
+// calls the pcapsession_run() function in the PCAP session
+//
+// Parameters:
+//  void* pcapsession_param: A transparent parameter on thread initiation, set to a pcapsession_t* here
+//
+void* pcapsession_thread_run(void* pcapsession_param)
+{
+	// Dereference the pcapsession pointer
+	pcapsession_t* pcapsession = pcapsession_param;
+
+	// Session IDs are unique among running sessions so the ID is used as the monitor counter shard of this thread
+	monitor_register_thread(pcapsession->id);
+
+	return pcapsession->runner(pcapsession);
+}
+
 //
 // This function closes the distribution server
 //
@@ -270,9 +289,11 @@ void* pcapsession_supervision_run(void* notused_param)
 			// esirich DEFTFTS-1634 if the output is idle, flush it
 			if (session_list[i].monitor != NULL
 			&& session_list[i].pcap_dumper 
-			&& session_list[i].monitor->bytes == 0) {
+			&& monitor_bytes_since_output(session_list[i].monitor) == 0) {
 				pthread_mutex_lock(&(session_list[i].pcap_mutex));
-				pcap_dump_flush(session_list[i].pcap_dumper);
+				if (pcap_dump_flush(session_list[i].pcap_dumper) == 0) {
+					pcapsession_clientconn_sent(&session_list[i]);
+				}
 				pthread_mutex_unlock(&(session_list[i].pcap_mutex));
 			}
 
@@ -0,0 +1,291 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: pcapsession_addressmap.c
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This module holds maps of IPv4 addresses and prefixes to new addresses and prefixes. A map is an open addressed hash
+ * table keyed on a prefix and its length, so an exact address is found with one probe and a prefix is found by trying
+ * each prefix length used in the map from the longest down
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <arpa/inet.h>
+
+#include <gtpv1_context.h>
+#include <pcapsession.h>
+
+// The number of entries of the hash table of a new map, a power of 2
+#define ADDRESS_MAP_INITIAL_SIZE 64
+
+// The characters that separate the addresses of a mapping
+#define ADDRESS_MAP_SEPARATORS " \t\r\n,"
+
+// The longest line of a map file
+#define ADDRESS_MAP_LINE_SIZE 256
+
+// Forward definition of private functions
+static inline uint32_t pcapsession_address_map_mask(uint8_t length);
+static struct pcapsession_address_map_entry* pcapsession_address_map_slot(struct pcapsession_address_map_entry* entries, uint32_t size, uint32_t prefix, uint8_t length);
+static int pcapsession_address_map_grow(pcapsession_address_map_t* map);
+
+//
+// This function initializes an empty address map
+//
+// Parameters:
+//  pcapsession_address_map_t* map: The address map
+//
+// Return:
+//  int: 1 if the address map was initialized, 0 if it could not be allocated
+//
+int pcapsession_address_map_init(pcapsession_address_map_t* map)
+{
+	memset(map, 0, sizeof(pcapsession_address_map_t));
+
+	map->entries = calloc(ADDRESS_MAP_INITIAL_SIZE, sizeof(struct pcapsession_address_map_entry));
+	if (map->entries == NULL) {
+		return 0;
+	}
+	map->size = ADDRESS_MAP_INITIAL_SIZE;
+
+	return 1;
+}
+
+//
+// This function adds a mapping to an address map, the mapping is given as old_ip[/length] new_ip with the two
+// separated by white space or a comma. The host part of an address in a prefix is kept when it is mapped, a mapping of
+// a prefix that is already in the map replaces it
+//
+// Parameters:
+//  pcapsession_address_map_t* map: The address map
+//  const char* mapping: The mapping
+//  char* errbuf: The reason for an error is returned here, it must be PCAP_SESSION_ADDRESS_MAP_ERRBUF_SIZE long
+//
+// Return:
+//  int: 1 if the mapping was added, 0 otherwise
+//
+int pcapsession_address_map_add(pcapsession_address_map_t* map, const char* mapping, char* errbuf)
+{
+	char text[ADDRESS_MAP_LINE_SIZE];
+	if (snprintf(text, ADDRESS_MAP_LINE_SIZE, "%s", mapping) >= ADDRESS_MAP_LINE_SIZE) {
+		snprintf(errbuf, PCAP_SESSION_ADDRESS_MAP_ERRBUF_SIZE, "mapping is longer than %d characters", ADDRESS_MAP_LINE_SIZE - 1);
+		return 0;
+	}
+
+	char* save = NULL;
+	char* old_text = strtok_r(text, ADDRESS_MAP_SEPARATORS, &save);
+	char* new_text = strtok_r(NULL, ADDRESS_MAP_SEPARATORS, &save);
+	if (old_text == NULL || new_text == NULL || strtok_r(NULL, ADDRESS_MAP_SEPARATORS, &save) != NULL) {
+		snprintf(errbuf, PCAP_SESSION_ADDRESS_MAP_ERRBUF_SIZE, "mapping %s is not of the form old_ip[/length] new_ip", mapping);
+		return 0;
+	}
+
+	// The prefix length is 32 for an exact address
+	long length = 32;
+	char* slash = strchr(old_text, '/');
+	if (slash != NULL) {
+		char* end = NULL;
+		*slash = '\0';
+		length = strtol(slash + 1, &end, 10);
+		if (end == slash + 1 || *end != '\0' || length < 0 || length > 32) {
+			snprintf(errbuf, PCAP_SESSION_ADDRESS_MAP_ERRBUF_SIZE, "prefix length %s is not between 0 and 32", slash + 1);
+			return 0;
+		}
+	}
+
+	struct in_addr old_ip;
+	struct in_addr new_ip;
+	if (!inet_aton(old_text, &old_ip) || !inet_aton(new_text, &new_ip)) {
+		snprintf(errbuf, PCAP_SESSION_ADDRESS_MAP_ERRBUF_SIZE, "mapping %s does not have valid Internet addresses", mapping);
+		return 0;
+	}
+
+	// Keep the table at most half full
+	if ((map->count + 1) * 2 > map->size && !pcapsession_address_map_grow(map)) {
+		snprintf(errbuf, PCAP_SESSION_ADDRESS_MAP_ERRBUF_SIZE, "could not allocate an address map of %u entries", map->size * 2);
+		return 0;
+	}
+
+	uint32_t mask = pcapsession_address_map_mask(length);
+	uint32_t prefix = ntohl(old_ip.s_addr) & mask;
+	struct pcapsession_address_map_entry* entry = pcapsession_address_map_slot(map->entries, map->size, prefix, length);
+	if (!entry->used) {
+		entry->used = 1;
+		entry->prefix = prefix;
+		entry->length = length;
+		map->count++;
+	}
+	entry->new_prefix = ntohl(new_ip.s_addr) & mask;
+
+	// Keep the prefix lengths in the map in order, longest first
+	int position = 0;
+	while (position < map->length_count && map->lengths[position] > length) {
+		position++;
+	}
+	if (position == map->length_count || map->lengths[position] != length) {
+		memmove(&map->lengths[position + 1], &map->lengths[position], map->length_count - position);
+		map->lengths[position] = length;
+		map->length_count++;
+	}
+
+	return 1;
+}
+
+//
+// This function adds the mappings in a file to an address map, the file has a mapping on each line. Empty lines and
+// text from a # on are ignored
+//
+// Parameters:
+//  pcapsession_address_map_t* map: The address map
+//  const char* file_name: The name of the file
+//  char* errbuf: The reason for an error is returned here, it must be PCAP_SESSION_ADDRESS_MAP_ERRBUF_SIZE long
+//
+// Return:
+//  int: 1 if all mappings in the file were added, 0 otherwise
+//
+int pcapsession_address_map_load(pcapsession_address_map_t* map, const char* file_name, char* errbuf)
+{
+	FILE* map_file = fopen(file_name, "r");
+	if (map_file == NULL) {
+		snprintf(errbuf, PCAP_SESSION_ADDRESS_MAP_ERRBUF_SIZE, "could not open address map file %s", file_name);
+		return 0;
+	}
+
+	char line[ADDRESS_MAP_LINE_SIZE];
+	unsigned long line_no = 0;
+	while (fgets(line, ADDRESS_MAP_LINE_SIZE, map_file) != NULL) {
+		line_no++;
+
+		// Drop the end of line and any comment
+		line[strcspn(line, "#\r\n")] = '\0';
+		if (strspn(line, ADDRESS_MAP_SEPARATORS) == strlen(line)) {
+			continue;
+		}
+
+		char line_errbuf[PCAP_SESSION_ADDRESS_MAP_ERRBUF_SIZE];
+		if (!pcapsession_address_map_add(map, line, line_errbuf)) {
+			snprintf(errbuf, PCAP_SESSION_ADDRESS_MAP_ERRBUF_SIZE, "line %lu of %.64s: %.160s", line_no, file_name, line_errbuf);
+			fclose(map_file);
+			return 0;
+		}
+	}
+
+	fclose(map_file);
+	return 1;
+}
+
+//
+// This function looks an address up in an address map, the longest prefix that holds the address is used
+//
+// Parameters:
+//  const pcapsession_address_map_t* map: The address map
+//  uint32_t address: The address in host byte order
+//  uint32_t* new_address: The mapped address is returned here in host byte order
+//
+// Return:
+//  int: 1 if the address is mapped, 0 otherwise
+//
+int pcapsession_address_map_lookup(const pcapsession_address_map_t* map, uint32_t address, uint32_t* new_address)
+{
+	for (int i = 0; i < map->length_count; i++) {
+		uint32_t mask = pcapsession_address_map_mask(map->lengths[i]);
+		struct pcapsession_address_map_entry* entry = pcapsession_address_map_slot(map->entries, map->size, address & mask, map->lengths[i]);
+		if (entry->used) {
+			*new_address = entry->new_prefix | (address & ~mask);
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+//
+// This function frees the memory of an address map
+//
+// Parameters:
+//  pcapsession_address_map_t* map: The address map
+//
+void pcapsession_address_map_close(pcapsession_address_map_t* map)
+{
+	free(map->entries);
+	memset(map, 0, sizeof(pcapsession_address_map_t));
+}
+
+//
+// This function gives the network mask of a prefix length
+//
+// Parameters:
+//  uint8_t length: The prefix length, from 0 to 32
+//
+// Return:
+//  uint32_t: The mask in host byte order
+//
+static inline uint32_t pcapsession_address_map_mask(uint8_t length)
+{
+	return length == 0 ? 0 : 0xffffffff << (32 - length);
+}
+
+//
+// This function finds the entry of a prefix in a hash table or the free entry where it would be added
+//
+// Parameters:
+//  struct pcapsession_address_map_entry* entries: The hash table
+//  uint32_t size: The number of entries in the hash table, a power of 2
+//  uint32_t prefix: The prefix with its host part cleared
+//  uint8_t length: The length of the prefix
+//
+// Return:
+//  struct pcapsession_address_map_entry*: The entry of the prefix if it is in the table, otherwise a free entry
+//
+static struct pcapsession_address_map_entry* pcapsession_address_map_slot(struct pcapsession_address_map_entry* entries, uint32_t size, uint32_t prefix, uint8_t length)
+{
+	uint32_t index = gtpv1_context_hash(prefix, length) & (size - 1);
+
+	while (entries[index].used && (entries[index].prefix != prefix || entries[index].length != length)) {
+		index = (index + 1) & (size - 1);
+	}
+
+	return &entries[index];
+}
+
+//
+// This function doubles the size of the hash table of an address map
+//
+// Parameters:
+//  pcapsession_address_map_t* map: The address map
+//
+// Return:
+//  int: 1 if the hash table was grown, 0 if it could not be allocated
+//
+static int pcapsession_address_map_grow(pcapsession_address_map_t* map)
+{
+	uint32_t size = map->size * 2;
+	struct pcapsession_address_map_entry* entries = calloc(size, sizeof(struct pcapsession_address_map_entry));
+	if (entries == NULL) {
+		return 0;
+	}
+
+	for (uint32_t i = 0; i < map->size; i++) {
+		if (map->entries[i].used) {
+			*pcapsession_address_map_slot(entries, size, map->entries[i].prefix, map->entries[i].length) = map->entries[i];
+		}
+	}
+
+	free(map->entries);
+	map->entries = entries;
+	map->size = size;
+
+	return 1;
+}
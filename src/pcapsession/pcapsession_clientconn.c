@@ -19,6 +19,7 @@
  */
 #include <stdlib.h>
 #include <string.h>
+#include <stdio_ext.h>
 #include <unistd.h>
 #include <arpa/inet.h>
 
@@ -37,7 +38,8 @@ int clientconnlist_initialized = 0;
 // Forward definition of private functions
 void* pcapsession_clientconn_run(void* pcapsession_param);
 void* pcapsession_clientconn_stop(void* pcapsession_param);
-void pcapsession_clientconn_client_handle_packet(pcapsession_t* client, const struct pcap_pkthdr* header, const unsigned char* data);
+int pcapsession_clientconn_client_handle_packet(pcapsession_t* client, const struct pcap_pkthdr* header, const unsigned char* data, int live_timestamps);
+static void pcapsession_clientconn_track_send(pcapsession_t* client, const struct pcap_pkthdr* header, size_t pending_before, size_t pending_after);
 
 //
 // This function handles a new client connection accepted on the server socket
@@ -118,6 +120,7 @@ void* pcapsession_clientconn_run(void* pcapsession_param)
 
 	// Set the monitor for this client
 	pcapsession->monitor = monitor_open(pcapsession->id, pcapsession->description);
+	monitor_enable_latency(pcapsession->monitor, "capture-to-send");
 
 	// We have to give pcap_dump_open an input file handle so we use a dead open with an Ethernet PCAP type
 	pcap_t* pcap_dead_handle = pcap_open_dead(DLT_EN10MB, PCAP_MAX_SNAPLEN);
@@ -228,13 +231,19 @@ void pcapsession_clientconn_packet_handler(unsigned char* pcapsession_param, con
 	// Add a packet and the number of bytes to the monitor for the server
 	monitor_increment(pcapsession->monitor, 1, header->len);
 
-	// Iterate over each client and send the packet to each one
+	// Iterate over each client and send the packet to each one, counting the clients the packet could not be sent to
+	int drops = 0;
 	for (int i = 0; i < PCAP_SESSION_MAX_SESSIONS; i++) {
 		// Check if the client is used
 		if (clientconnlist[i] != NULL) {
-			pcapsession_clientconn_client_handle_packet(clientconnlist[i], header, data);
+			drops += !pcapsession_clientconn_client_handle_packet(clientconnlist[i], header, data, pcapsession->live_timestamps);
 		}
 	}
+
+	// Drops introduced by distribution are counted on the capture session so that they can be set against capture drops
+	if (drops > 0) {
+		monitor_increment_drops(pcapsession->monitor, drops);
+	}
 }
 
 //
@@ -244,12 +253,16 @@ void pcapsession_clientconn_packet_handler(unsigned char* pcapsession_param, con
 //  distserverclient_t* client: The client for which data is being handled
 //  const struct pcap_pkthdr* header: A pointer to the header of the packet
 //  const unsigned char* data: A pointer to the packet data
+//  int live_timestamps: Set if the packet time stamp was taken at capture, the latency to send is then monitored
 //
-void pcapsession_clientconn_client_handle_packet(pcapsession_t* client, const struct pcap_pkthdr* header, const unsigned char* data)
+// Return:
+//  int: 1 if the packet was sent to the client, 0 if it was dropped
+//
+int pcapsession_clientconn_client_handle_packet(pcapsession_t* client, const struct pcap_pkthdr* header, const unsigned char* data, int live_timestamps)
 {
-	// Check if the client handle is set
+	// Check if the client handle is set, packets for clients that are not running are dropped
 	if (client == NULL || client->state != PCAP_SESSION_RUNNING) {
-		return;
+		return 0;
 	}
 
 	// Dump the packet to the client in question
@@ -257,16 +270,86 @@ void pcapsession_clientconn_client_handle_packet(pcapsession_t* client, const st
 		
 		// esirich DEFTFTS-1634 lock the pcap_dump so the monitor can flush
 		pthread_mutex_lock(&(client->pcap_mutex));
+		FILE* dump_file = pcap_dump_file(client->pcap_dumper);
+		size_t pending_before = __fpending(dump_file);
 		pcap_dump((unsigned char*)client->pcap_dumper, header, data);
+		int dump_failed = ferror_unlocked(dump_file);
+		if (dump_failed) {
+			clearerr_unlocked(dump_file);
+			client->send_latency.count = 0;
+		}
+		else if (live_timestamps) {
+			// The latency from capture to send is recorded when the packet is written to the client socket
+			pcapsession_clientconn_track_send(client, header, pending_before, __fpending(dump_file));
+		}
 		pthread_mutex_unlock(&(client->pcap_mutex));
 
+		// The packet did not get out to the client, the file descriptor check evicts the client if it is gone
+		if (dump_failed) {
+			return 0;
+		}
+
         // Add a packet and the number of bytes to the monitor for the client
         monitor_increment(client->monitor, 1, header->len);
+
+		return 1;
 	}
-	else {
-		// Get client off list for packet dumping ASAP
-		clientconnlist[client->id] = NULL;
-		// Client disconnect detected, terminate
-		// write_to_syslog( "client connection session file descriptor is lost: %d-%s\n", client->id, client->description);
+
+	// Get client off list for packet dumping ASAP, the packet is dropped for the evicted client
+	clientconnlist[client->id] = NULL;
+	// Client disconnect detected, terminate
+	// write_to_syslog( "client connection session file descriptor is lost: %d-%s\n", client->id, client->description);
+	return 0;
+}
+
+//
+// This function records the capture to send latency of the packets buffered for a client once the buffer has been
+// flushed to the client socket, the pcap_mutex of the session must be held
+//
+// Parameters:
+//  pcapsession_t* client: The client connection session
+//
+void pcapsession_clientconn_sent(pcapsession_t* client)
+{
+	pcapsession_send_latency_t* send_latency = &client->send_latency;
+	if (send_latency->count == 0) {
+		return;
+	}
+
+	struct timeval now;
+	gettimeofday(&now, NULL);
+	for (unsigned int i = 0; i < send_latency->count; i++) {
+		monitor_record_latency(client->monitor, monitor_usec_between(&send_latency->pending[i], &now));
+	}
+	send_latency->count = 0;
+}
+
+//
+// This function keeps track of a packet just dumped to a client until it is written to the client socket. The dump
+// writes the buffer out when the packet does not fit in it, the packets buffered before are then sent and so is this
+// packet unless part of it is left in the buffer
+//
+// Parameters:
+//  pcapsession_t* client: The client connection session
+//  const struct pcap_pkthdr* header: A pointer to the header of the packet
+//  size_t pending_before: The number of bytes buffered for the client before the packet was dumped
+//  size_t pending_after: The number of bytes buffered for the client after the packet was dumped
+//
+static void pcapsession_clientconn_track_send(pcapsession_t* client, const struct pcap_pkthdr* header, size_t pending_before, size_t pending_after)
+{
+	pcapsession_send_latency_t* send_latency = &client->send_latency;
+
+	if (pending_after < pending_before + PCAP_RECORD_HEADER_SIZE + header->caplen) {
+		pcapsession_clientconn_sent(client);
+		if (pending_after == 0) {
+			struct timeval now;
+			gettimeofday(&now, NULL);
+			monitor_record_latency(client->monitor, monitor_usec_between(&header->ts, &now));
+			return;
+		}
+	}
+
+	if (send_latency->count < PCAP_SESSION_SEND_PENDING) {
+		send_latency->pending[send_latency->count++] = header->ts;
 	}
 }
@@ -14,22 +14,64 @@
  ************************************************************************/
 
 /**
- * This module loops over a set of files in a directory and streams them into the server
+ * This module loops over a set of files in a directory and streams them into the server. When iterating, the packets of
+ * the first iteration can be cached in memory so that later iterations are replayed from memory, with the time stamps
+ * of each iteration shifted on from those of the iteration before. Packets can be paced to their original timing or
+ * to a fixed rate rather than sent as fast as they are read. In tail mode the directory is watched with inotify after
+ * the files in it are streamed, and each new file is streamed as soon as it is complete
  */
 
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <string.h>
 #include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
 
 #include <logger.h>
 #include <monitor.h>
 #include <pcapdefines.h>
 #include <pcapsession.h>
 
+// The size of the first allocation of the packet arena of a replay cache
+#define REPLAY_CACHE_INITIAL_SIZE (1024 * 1024)
+
+// The number of packets replayed from memory between checks for cancellation of the session thread
+#define REPLAY_CACHE_CANCEL_CHECK_MASK 0xfff
+
+// The size of the buffer inotify events are read into
+#define TAIL_EVENT_BUFFER_SIZE (64 * (sizeof(struct inotify_event) + NAME_MAX + 1))
+
+// The inotify events on which a file in a tailed directory is complete
+#define TAIL_EVENT_MASK (IN_CLOSE_WRITE | IN_MOVED_TO)
+
+// A scanned file modified within this many seconds may still be open for writing, it waits for its close event or a later scan
+#define TAIL_SETTLE_SECONDS 2
+
 // Forward definition of private functions
 void* pcapsession_filecapture_run(void* pcapsession_param);
+void* pcapsession_filecapture_tail_run(void* pcapsession_param);
 void* pcapsession_filecapture_stop(void* pcapsession_param);
+static void pcapsession_filecapture_start_pacing(pcapsession_t* pcapsession);
+static int pcapsession_filecapture_is_pcap_file(const char* file_name);
+static int pcapsession_filecapture_stream_file(pcapsession_t* pcapsession, const char* file_name);
+static int pcapsession_filecapture_tail_scan(pcapsession_t* pcapsession, time_t* rescan_time);
+static int pcapsession_filecapture_tail_file(pcapsession_t* pcapsession, const char* file_name, int scanned);
+static int pcapsession_filecapture_tail_settled(pcapsession_t* pcapsession, const char* file_name);
+static int pcapsession_filecapture_journal_open(pcapsession_file_journal_t* journal);
+static int pcapsession_filecapture_journal_find(const pcapsession_file_journal_t* journal, const char* name, size_t* position);
+static int pcapsession_filecapture_journal_add(pcapsession_file_journal_t* journal, const char* name, int record);
+static void pcapsession_filecapture_journal_close(pcapsession_file_journal_t* journal);
+void pcapsession_filecapture_packet_handler(unsigned char* pcapsession_param, const struct pcap_pkthdr* header, const unsigned char* data);
+static int pcapsession_filecapture_cache_packet(pcapsession_replay_cache_t* cache, int64_t usec, const struct pcap_pkthdr* header, const unsigned char* data);
+static void pcapsession_filecapture_replay(pcapsession_t* pcapsession);
+static void pcapsession_filecapture_end_iteration(pcapsession_t* pcapsession);
+static inline void pcapsession_filecapture_set_timestamp(struct timeval* timestamp, int64_t usec);
+static inline void pcapsession_filecapture_send(pcapsession_t* pcapsession, const struct pcap_pkthdr* header, const unsigned char* data);
 
 //
 // This function opens a PCAP file capture session
@@ -37,11 +79,14 @@ void* pcapsession_filecapture_stop(void* pcapsession_param);
 // Parameters:
 //  char* directory_name: The directory containing PCAP files to be streamed in
 //  int iterations: The number of iterations to use over the files
+//  unsigned long cache_mb: The megabytes of memory the packets may be cached in for iterations after the first, 0 to
+//                          read every iteration from the files with the time stamps recorded in them
+//  const pcapsession_pacing_t* pacing: How the packets are paced, NULL to send them as fast as they are read
 //
 // Returns:
 //  int: Returns a value of 1 if the file capture session is created and added to session handling
 //
-int pcapsession_filecapture_open(char* directory_name, int iterations)
+int pcapsession_filecapture_open(char* directory_name, int iterations, unsigned long cache_mb, const pcapsession_pacing_t* pacing)
 {
 	write_to_syslog( "opening file capture session on directory %s\n", directory_name);
 
@@ -70,6 +115,78 @@ int pcapsession_filecapture_open(char* directory_name, int iterations)
 	pcapsession->untunnel = PCAP_SESSION_UNTUNNEL_OFF;
 	pcapsession->iterations = iterations;
 
+	// Packet time stamps are those recorded in the files
+	pcapsession->live_timestamps = 0;
+
+	// The replay cache is loaded when the session runs
+	memset(&pcapsession->replay_cache, 0, sizeof(pcapsession_replay_cache_t));
+	pcapsession->replay_cache.max_size = (size_t)cache_mb * 1024 * 1024;
+
+	// Pacing starts from the first packet sent
+	pcapsession_pacer_init(&pcapsession->pacer, pacing);
+
+	// The directory is not watched
+	pcapsession->watch_fd = -1;
+
+	// Return the result of adding the new pcapsession
+	return pcapsession_handling_add(pcapsession->id);
+}
+
+//
+// This function opens a PCAP file capture session that tails a directory. The PCAP files in the directory are streamed
+// in name order, then each PCAP file closed after writing in or moved into the directory is streamed once it is complete
+//
+// Parameters:
+//  char* directory_name: The directory containing PCAP files to be streamed in
+//  const char* journal_file_name: The file in which the names of the files streamed are recorded, so that they are not
+//                                 streamed again when the session restarts, NULL if no journal is kept
+//  const pcapsession_pacing_t* pacing: How the packets are paced, NULL to send them as fast as they are read
+//
+// Returns:
+//  int: Returns a value of 1 if the file capture session is created and added to session handling
+//
+int pcapsession_filecapture_open_tail(char* directory_name, const char* journal_file_name, const pcapsession_pacing_t* pacing)
+{
+	write_to_syslog( "opening file capture session tailing directory %s\n", directory_name);
+
+	// Get and check if a new PCAP session is available
+	pcapsession_t* pcapsession = pcapsession_handling_get_new();
+	if (pcapsession == NULL) {
+		return 0;
+	}
+
+	// Set the run and stop methods for the session
+	pcapsession->runner  = pcapsession_filecapture_tail_run;
+	pcapsession->stopper = pcapsession_filecapture_stop;
+
+	// Save the directory name for capture as the description
+	strcpy(pcapsession->description, directory_name);
+
+	write_to_syslog( "packet capture starting on file capture session: %d-%s\n", pcapsession->id, pcapsession->description);
+
+	// Clear other fields on this session for now, a tailing session restarts until it is aborted
+	pcapsession->fd = 0;
+	pcapsession->supervise_fd = PCAP_SESSION_UNSUPERVISED_FD;
+	pcapsession->monitor = NULL;
+	pcapsession->pcap_handle = NULL;
+	pcapsession->pcap_dumper = NULL;
+	pcapsession->handler = NULL;
+	pcapsession->untunnel = PCAP_SESSION_UNTUNNEL_OFF;
+	pcapsession->iterations = PCAP_SESSION_ITERATE_INFINITY;
+	pcapsession->live_timestamps = 0;
+	pcapsession->watch_fd = -1;
+
+	// Files are streamed once so no packets are cached, the journal is loaded when the session runs
+	memset(&pcapsession->replay_cache, 0, sizeof(pcapsession_replay_cache_t));
+	memset(&pcapsession->journal, 0, sizeof(pcapsession_file_journal_t));
+	if (journal_file_name != NULL && snprintf(pcapsession->journal.file_name, FILENAME_MAX, "%s", journal_file_name) >= FILENAME_MAX) {
+		write_to_syslog( "file capture session: %d-%s: journal file name %s is too long\n", pcapsession->id, pcapsession->description, journal_file_name);
+		pcapsession_change_state(pcapsession->id, PCAP_SESSION_UNUSED);
+		return 0;
+	}
+
+	pcapsession_pacer_init(&pcapsession->pacer, pacing);
+
 	// Return the result of adding the new pcapsession
 	return pcapsession_handling_add(pcapsession->id);
 }
@@ -98,14 +215,29 @@ void* pcapsession_filecapture_run(void* pcapsession_param)
 	// Set the monitor for this client
 	pcapsession->monitor = monitor_open(pcapsession->id, pcapsession->description);
 
+	pcapsession_filecapture_start_pacing(pcapsession);
+
+	// Cache the packets of the first iteration if there are more iterations to replay them on
+	pcapsession_replay_cache_t* cache = &pcapsession->replay_cache;
+	if (cache->max_size != 0 && pcapsession->iterations != 1) {
+		cache->state = PCAP_SESSION_REPLAY_LOADING;
+	}
+
 	// Loop continuously over the PCAP files in the directory
-	int pcap_file_count;
+	int pcap_file_count = 0;
 	do {
 		// Decrement the iterations if we're not looping infinitely
 		if (pcapsession->iterations != PCAP_SESSION_ITERATE_INFINITY && pcapsession->iterations != 0) {
 			pcapsession->iterations--;
 		}
 
+		// Once the first iteration is cached, the files are not read again
+		if (cache->state == PCAP_SESSION_REPLAY_LOADED) {
+			pcapsession_filecapture_replay(pcapsession);
+			pcapsession_filecapture_end_iteration(pcapsession);
+			continue;
+		}
+
 		// Clear the file count
 		pcap_file_count = 0;
 
@@ -123,47 +255,30 @@ void* pcapsession_filecapture_run(void* pcapsession_param)
 		// Loop over every file in the directory
 		while ((pcap_dir_entry = readdir(pcap_directory)) != NULL) {
 			// Check if this is a PCAP file
-			char* pcap_extension = strstr(pcap_dir_entry->d_name, PCAP_FILE_TYPE);
-			if (pcap_extension == NULL || strcmp(pcap_extension, PCAP_FILE_TYPE)) {
+			if (!pcapsession_filecapture_is_pcap_file(pcap_dir_entry->d_name)) {
 				continue;
 			}
 
 			// We found a PCAP file, count it
 			pcap_file_count++;
 
-			// Set the full path to the file
-			char file_path[FILENAME_MAX];
-			sprintf(file_path, "%s/%s", pcapsession->description, pcap_dir_entry->d_name);
-
-			// Open the PCAP file
-			char pcap_errbuf[PCAP_ERRBUF_SIZE];
-			pcapsession->pcap_handle = pcap_open_offline(file_path, pcap_errbuf);
-			if (pcapsession->pcap_handle == NULL) {
-				write_to_syslog( "file capture session: %d-%s: capture start failed on file %s, %s\n",
-						pcapsession->id, pcapsession->description, file_path, pcap_errbuf);
+			// Stream the PCAP file
+			if (!pcapsession_filecapture_stream_file(pcapsession, pcap_dir_entry->d_name)) {
 				pcapsession_change_state(pcapsession->id, PCAP_SESSION_TERMINATE);
-                closedir(pcap_directory);
+				closedir(pcap_directory);
 				return NULL;
 			}
-
-			// Set the file descriptor fields for this file
-			pcapsession->fd = pcap_get_selectable_fd(pcapsession->pcap_handle);
-			pcapsession->supervise_fd = PCAP_SESSION_SUPERVISED_FD;
-
-			// Stream the PCAP file
-			pcap_loop(pcapsession->pcap_handle, PCAP_INFINITE, pcapsession_clientconn_packet_handler, (void*)pcapsession);
-
-			// Clear the file descriptor fields for this file
-			pcapsession->supervise_fd = PCAP_SESSION_UNSUPERVISED_FD;
-			pcapsession->fd = 0;
-
-			// Close packet capture
-			pcap_close(pcapsession->pcap_handle);
-			pcapsession->pcap_handle = NULL;
 		}
 
 		// Close the directory again
 		closedir(pcap_directory);
+
+		pcapsession_filecapture_end_iteration(pcapsession);
+
+		// The time stamps start again on the next iteration unless they are shifted on
+		if (cache->state == PCAP_SESSION_REPLAY_OFF) {
+			pcapsession_pacer_resync(&pcapsession->pacer);
+		}
 	}
 	// Only loop while there are PCAP files in the directory
 	while (pcapsession->iterations != 0 && pcap_file_count > 0);
@@ -183,6 +298,117 @@ void* pcapsession_filecapture_run(void* pcapsession_param)
 	return NULL;
 }
 
+//
+// This function kicks off the PCAP file capture thread of a session tailing a directory, it sets the session to state
+// PCAP_SESSION_RUNNING. The directory is watched before the files in it are streamed so that no file completed in
+// the meantime is missed, files already streamed are skipped
+//
+// Parameters:
+//  void* pcapsession_param: A transparent parameter on thread initiation, set to a pcapsession_t* here, points at capture session
+//
+void* pcapsession_filecapture_tail_run(void* pcapsession_param)
+{
+	// Dereference the pcapsession pointer
+	pcapsession_t* pcapsession = pcapsession_param;
+
+	if (pcapsession == NULL) {
+		write_to_syslog( "could not run packet capture, session not set\n");
+		return NULL;
+	}
+
+	write_to_syslog( "packet capture session started: %d-%s\n", pcapsession->id, pcapsession->description);
+
+	// Set the session state to run, run has been ordered
+	pcapsession_change_state(pcapsession->id, PCAP_SESSION_RUNNING);
+
+	// Set the monitor for this client
+	pcapsession->monitor = monitor_open(pcapsession->id, pcapsession->description);
+
+	pcapsession_filecapture_start_pacing(pcapsession);
+
+	// Load the names of the files streamed before the session last stopped
+	if (!pcapsession_filecapture_journal_open(&pcapsession->journal)) {
+		write_to_syslog( "file capture session: %d-%s: could not load journal %s: %s\n",
+				pcapsession->id, pcapsession->description, pcapsession->journal.file_name, strerror(errno));
+		pcapsession_change_state(pcapsession->id, PCAP_SESSION_TERMINATE);
+		return NULL;
+	}
+
+	pcapsession->watch_fd = inotify_init1(IN_CLOEXEC);
+	if (pcapsession->watch_fd < 0 || inotify_add_watch(pcapsession->watch_fd, pcapsession->description, TAIL_EVENT_MASK) < 0) {
+		write_to_syslog( "file capture session: %d-%s: could not watch directory: %s\n", pcapsession->id, pcapsession->description, strerror(errno));
+		pcapsession_change_state(pcapsession->id, PCAP_SESSION_TERMINATE);
+		return NULL;
+	}
+
+	// Stream the files already in the directory, files still being written are scanned again when they settle
+	time_t rescan_time = 0;
+	if (!pcapsession_filecapture_tail_scan(pcapsession, &rescan_time)) {
+		pcapsession_change_state(pcapsession->id, PCAP_SESSION_TERMINATE);
+		return NULL;
+	}
+
+	char events[TAIL_EVENT_BUFFER_SIZE] __attribute__((aligned(__alignof__(struct inotify_event))));
+	int watching = 1;
+	while (watching) {
+		// The inotify descriptor is supervised while waiting for files
+		pcapsession->fd = pcapsession->watch_fd;
+		pcapsession->supervise_fd = PCAP_SESSION_SUPERVISED_FD;
+
+		// Wait no longer than the next scan for files that were still being written
+		int ready = 1;
+		if (rescan_time != 0) {
+			time_t now = time(NULL);
+			struct pollfd watch_poll = { .fd = pcapsession->watch_fd, .events = POLLIN, .revents = 0 };
+			ready = poll(&watch_poll, 1, rescan_time > now ? (int)(rescan_time - now) * 1000 : 0);
+		}
+		ssize_t length = ready > 0 ? read(pcapsession->watch_fd, events, TAIL_EVENT_BUFFER_SIZE) : ready;
+
+		pcapsession->supervise_fd = PCAP_SESSION_UNSUPERVISED_FD;
+		pcapsession->fd = 0;
+
+		if (ready == 0) {
+			watching = pcapsession_filecapture_tail_scan(pcapsession, &rescan_time);
+			continue;
+		}
+		if (length < 0 && errno == EINTR) {
+			continue;
+		}
+		if (length <= 0) {
+			write_to_syslog( "file capture session: %d-%s: could not read directory events: %s\n", pcapsession->id, pcapsession->description, strerror(errno));
+			break;
+		}
+
+		// Events are lost if the queue overflows, the directory is then scanned again after this batch of events
+		int rescan = 0;
+		for (char* event_data = events; event_data < events + length; ) {
+			const struct inotify_event* event = (const struct inotify_event*)event_data;
+			event_data += sizeof(struct inotify_event) + event->len;
+
+			if (event->mask & IN_Q_OVERFLOW) {
+				rescan = 1;
+			}
+			else if (event->mask & IN_IGNORED) {
+				write_to_syslog( "file capture session: %d-%s: directory is no longer watched\n", pcapsession->id, pcapsession->description);
+				watching = 0;
+			}
+			else if (event->len > 0 && (event->mask & TAIL_EVENT_MASK)) {
+				pcapsession_filecapture_tail_file(pcapsession, event->name, 0);
+			}
+		}
+
+		if (watching && rescan) {
+			write_to_syslog( "file capture session: %d-%s: directory events overflowed, scanning directory\n", pcapsession->id, pcapsession->description);
+			watching = pcapsession_filecapture_tail_scan(pcapsession, &rescan_time);
+		}
+	}
+
+	// Set the state to terminating
+	pcapsession_change_state(pcapsession->id, PCAP_SESSION_TERMINATE);
+
+	return NULL;
+}
+
 //
 // This function stops the file capture session, the state is reset back to PCAP_SESSION_START so that session handling will attempt to
 // restart the server.
@@ -215,6 +441,19 @@ void* pcapsession_filecapture_stop(void* pcapsession_param)
 		pcapsession->monitor = NULL;
 	}
 
+	// Free the replay cache, it is loaded again if the session restarts
+	free(pcapsession->replay_cache.arena);
+	size_t cache_max_size = pcapsession->replay_cache.max_size;
+	memset(&pcapsession->replay_cache, 0, sizeof(pcapsession_replay_cache_t));
+	pcapsession->replay_cache.max_size = cache_max_size;
+
+	// Stop watching the directory and free the names of the files streamed, the journal is loaded again on restart
+	if (pcapsession->watch_fd >= 0) {
+		close(pcapsession->watch_fd);
+		pcapsession->watch_fd = -1;
+	}
+	pcapsession_filecapture_journal_close(&pcapsession->journal);
+
 	// Set the session state as appropriate
 	if (pcapsession->state == PCAP_SESSION_ABORTING || pcapsession->iterations == 0) {
 		// On abort, always stop
@@ -228,3 +467,570 @@ void* pcapsession_filecapture_stop(void* pcapsession_param)
 	write_to_syslog( "packet capture session stopped: %d-%s\n", pcapsession->id, pcapsession->description);
 	return NULL;
 }
+
+//
+// This function is a PCAP packet handler for file capture sessions whose packets are cached, time shifted or paced. On
+// the first iteration packets are measured and cached, on iterations read from the files their time stamps are shifted
+//
+// Parameters:
+//  unsigned char* pcapsession_param: A pointer to user data set in the pcap_loop call, in this case the session
+//  const struct pcap_pkthdr* header: A pointer to the header of the packet
+//  const unsigned char* data: A pointer to the packet data
+//
+void pcapsession_filecapture_packet_handler(unsigned char* pcapsession_param, const struct pcap_pkthdr* header, const unsigned char* data)
+{
+	pcapsession_t* pcapsession = (pcapsession_t*)pcapsession_param;
+	pcapsession_replay_cache_t* cache = &pcapsession->replay_cache;
+	if (cache->state == PCAP_SESSION_REPLAY_OFF) {
+		pcapsession_filecapture_send(pcapsession, header, data);
+		return;
+	}
+
+	int64_t usec = (int64_t)header->ts.tv_sec * 1000000 + header->ts.tv_usec;
+	if (cache->state == PCAP_SESSION_REPLAY_SHIFTING) {
+		struct pcap_pkthdr shifted_header = *header;
+		pcapsession_filecapture_set_timestamp(&shifted_header.ts, usec + cache->shift_usec);
+		pcapsession_filecapture_send(pcapsession, &shifted_header, data);
+		return;
+	}
+
+	// The time span of the first iteration gives the shift of the iterations after it
+	if (cache->packets == 0 || usec < cache->first_usec) {
+		cache->first_usec = usec;
+	}
+	if (cache->packets == 0 || usec > cache->last_usec) {
+		cache->last_usec = usec;
+	}
+	cache->packets++;
+
+	// Stop caching once the cache is full, the files are read again on later iterations
+	if (cache->state == PCAP_SESSION_REPLAY_LOADING && !pcapsession_filecapture_cache_packet(cache, usec, header, data)) {
+		write_to_syslog( "file capture session: %d-%s: packets do not fit in a replay cache of %lu bytes, files will be read on each iteration\n",
+				pcapsession->id, pcapsession->description, cache->max_size);
+		free(cache->arena);
+		cache->arena = NULL;
+		cache->used = 0;
+		cache->size = 0;
+		cache->state = PCAP_SESSION_REPLAY_MEASURING;
+	}
+
+	pcapsession_filecapture_send(pcapsession, header, data);
+}
+
+//
+// This function adds a packet to the arena of a replay cache, the arena is doubled in size as it fills up to the
+// maximum size of the cache
+//
+// Parameters:
+//  pcapsession_replay_cache_t* cache: The replay cache
+//  int64_t usec: The time stamp of the packet in microseconds
+//  const struct pcap_pkthdr* header: A pointer to the header of the packet
+//  const unsigned char* data: A pointer to the packet data
+//
+// Return:
+//  int: 1 if the packet was cached, 0 if the cache is full
+//
+static int pcapsession_filecapture_cache_packet(pcapsession_replay_cache_t* cache, int64_t usec, const struct pcap_pkthdr* header, const unsigned char* data)
+{
+	// Records are padded to keep the record headers aligned
+	size_t length = sizeof(struct pcapsession_replay_record) + ((header->caplen + 7) & ~(size_t)7);
+
+	if (cache->used + length > cache->size) {
+		size_t size = cache->size != 0 ? cache->size : REPLAY_CACHE_INITIAL_SIZE;
+		while (size < cache->used + length) {
+			size *= 2;
+		}
+		if (size > cache->max_size) {
+			size = cache->max_size;
+		}
+		if (cache->used + length > size) {
+			return 0;
+		}
+
+		unsigned char* arena = realloc(cache->arena, size);
+		if (arena == NULL) {
+			return 0;
+		}
+		cache->arena = arena;
+		cache->size = size;
+	}
+
+	struct pcapsession_replay_record* record = (struct pcapsession_replay_record*)(cache->arena + cache->used);
+	record->usec = usec;
+	record->caplen = header->caplen;
+	record->len = header->len;
+	memcpy(record + 1, data, header->caplen);
+	cache->used += length;
+
+	return 1;
+}
+
+//
+// This function replays the packets in the replay cache of a session to its clients, with their time stamps shifted
+// for the current iteration
+//
+// Parameters:
+//  pcapsession_t* pcapsession: The file capture session
+//
+static void pcapsession_filecapture_replay(pcapsession_t* pcapsession)
+{
+	pcapsession_replay_cache_t* cache = &pcapsession->replay_cache;
+	uint64_t replayed = 0;
+
+	for (size_t offset = 0; offset < cache->used; ) {
+		const struct pcapsession_replay_record* record = (const struct pcapsession_replay_record*)(cache->arena + offset);
+
+		struct pcap_pkthdr header;
+		pcapsession_filecapture_set_timestamp(&header.ts, record->usec + cache->shift_usec);
+		header.caplen = record->caplen;
+		header.len = record->len;
+
+		pcapsession_filecapture_send(pcapsession, &header, (const unsigned char*)(record + 1));
+		offset += sizeof(struct pcapsession_replay_record) + ((record->caplen + 7) & ~(size_t)7);
+
+		// Nothing here blocks when no clients are connected, so check now and then if the session is being stopped
+		if ((++replayed & REPLAY_CACHE_CANCEL_CHECK_MASK) == 0) {
+			pthread_testcancel();
+		}
+	}
+
+	pthread_testcancel();
+}
+
+//
+// This function ends an iteration of a file capture session whose packets are cached or time shifted, after the first
+// iteration the replay cache is complete and the time stamps of each iteration are shifted on by the time span of the
+// first iteration and the mean time between its packets
+//
+// Parameters:
+//  pcapsession_t* pcapsession: The file capture session
+//
+static void pcapsession_filecapture_end_iteration(pcapsession_t* pcapsession)
+{
+	pcapsession_replay_cache_t* cache = &pcapsession->replay_cache;
+
+	switch (cache->state) {
+	case PCAP_SESSION_REPLAY_OFF:
+		return;
+
+	case PCAP_SESSION_REPLAY_LOADING:
+	case PCAP_SESSION_REPLAY_MEASURING:
+		if (cache->packets == 0) {
+			// There are no packets to replay
+			cache->state = PCAP_SESSION_REPLAY_OFF;
+			return;
+		}
+
+		if (cache->state == PCAP_SESSION_REPLAY_LOADING) {
+			// Give back the part of the arena that is not used
+			unsigned char* arena = realloc(cache->arena, cache->used);
+			if (arena != NULL) {
+				cache->arena = arena;
+				cache->size = cache->used;
+			}
+			cache->state = PCAP_SESSION_REPLAY_LOADED;
+			write_to_syslog( "file capture session: %d-%s: cached %llu packets in %lu bytes for replay\n",
+					pcapsession->id, pcapsession->description, (unsigned long long)cache->packets, cache->used);
+		}
+		else {
+			cache->state = PCAP_SESSION_REPLAY_SHIFTING;
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	// The next iteration starts one mean packet gap after this one ends, at least a microsecond later
+	int64_t span_usec = cache->last_usec - cache->first_usec;
+	int64_t gap_usec = cache->packets > 1 ? span_usec / (int64_t)(cache->packets - 1) : 0;
+	cache->shift_usec += span_usec + (gap_usec > 0 ? gap_usec : 1);
+}
+
+//
+// This function sets a time stamp from a time in microseconds
+//
+// Parameters:
+//  struct timeval* timestamp: The time stamp to set
+//  int64_t usec: The time in microseconds
+//
+static inline void pcapsession_filecapture_set_timestamp(struct timeval* timestamp, int64_t usec)
+{
+	timestamp->tv_sec  = usec / 1000000;
+	timestamp->tv_usec = usec % 1000000;
+
+	// Times before the epoch have a negative seconds part and a positive microseconds part
+	if (timestamp->tv_usec < 0) {
+		timestamp->tv_sec--;
+		timestamp->tv_usec += 1000000;
+	}
+}
+
+//
+// This function sends a packet to the clients of a file capture session once it is due to be sent
+//
+// Parameters:
+//  pcapsession_t* pcapsession: The file capture session
+//  const struct pcap_pkthdr* header: A pointer to the header of the packet
+//  const unsigned char* data: A pointer to the packet data
+//
+static inline void pcapsession_filecapture_send(pcapsession_t* pcapsession, const struct pcap_pkthdr* header, const unsigned char* data)
+{
+	if (pcapsession->pacer.pacing.mode != PCAP_SESSION_PACING_OFF) {
+		monitor_record_latency(pcapsession->monitor, pcapsession_pacer_wait(&pcapsession->pacer, header));
+	}
+
+	pcapsession_clientconn_packet_handler((unsigned char*)pcapsession, header, data);
+}
+
+//
+// This function starts pacing the packets of a file capture session if it is paced. The rate achieved is monitored
+// against the rate paced at and the lateness of paced packets is monitored as latency
+//
+// Parameters:
+//  pcapsession_t* pcapsession: The file capture session
+//
+static void pcapsession_filecapture_start_pacing(pcapsession_t* pcapsession)
+{
+	pcapsession_pacer_t* pacer = &pcapsession->pacer;
+	if (pacer->pacing.mode == PCAP_SESSION_PACING_OFF) {
+		return;
+	}
+
+	pcapsession_pacing_t pacing = pacer->pacing;
+	pcapsession_pacer_init(pacer, &pacing);
+	monitor_set_target_rate(pcapsession->monitor,
+			pacing.mode == PCAP_SESSION_PACING_PACKET_RATE ? pacing.rate : 0,
+			pacing.mode == PCAP_SESSION_PACING_BIT_RATE ? pacing.rate : 0);
+	monitor_enable_latency(pcapsession->monitor, "pacing lateness");
+}
+
+//
+// This function checks if a file is a PCAP file from the type at the end of its name
+//
+// Parameters:
+//  const char* file_name: The name of the file
+//
+// Return:
+//  int: 1 if the file is a PCAP file, 0 otherwise
+//
+static int pcapsession_filecapture_is_pcap_file(const char* file_name)
+{
+	size_t length = strlen(file_name);
+	size_t type_length = strlen(PCAP_FILE_TYPE);
+
+	return length > type_length && !strcmp(file_name + length - type_length, PCAP_FILE_TYPE);
+}
+
+//
+// This function streams a PCAP file in the directory of a file capture session to its clients
+//
+// Parameters:
+//  pcapsession_t* pcapsession: The file capture session
+//  const char* file_name: The name of the file in the directory
+//
+// Return:
+//  int: 1 if the file was streamed, 0 if it could not be opened
+//
+static int pcapsession_filecapture_stream_file(pcapsession_t* pcapsession, const char* file_name)
+{
+	// Set the full path to the file
+	char file_path[FILENAME_MAX];
+	if (snprintf(file_path, FILENAME_MAX, "%s/%s", pcapsession->description, file_name) >= FILENAME_MAX) {
+		write_to_syslog( "file capture session: %d-%s: path of file %s is too long\n", pcapsession->id, pcapsession->description, file_name);
+		return 0;
+	}
+
+	// Open the PCAP file
+	char pcap_errbuf[PCAP_ERRBUF_SIZE];
+	pcapsession->pcap_handle = pcap_open_offline(file_path, pcap_errbuf);
+	if (pcapsession->pcap_handle == NULL) {
+		write_to_syslog( "file capture session: %d-%s: capture start failed on file %s, %s\n",
+				pcapsession->id, pcapsession->description, file_path, pcap_errbuf);
+		return 0;
+	}
+
+	// Set the file descriptor fields for this file
+	pcapsession->fd = pcap_get_selectable_fd(pcapsession->pcap_handle);
+	pcapsession->supervise_fd = PCAP_SESSION_SUPERVISED_FD;
+
+	// Stream the PCAP file, packets need only be handled here if they are cached, time shifted or paced
+	pcap_handler handler = pcapsession_filecapture_packet_handler;
+	if (pcapsession->replay_cache.state == PCAP_SESSION_REPLAY_OFF && pcapsession->pacer.pacing.mode == PCAP_SESSION_PACING_OFF) {
+		handler = pcapsession_clientconn_packet_handler;
+	}
+	pcap_loop(pcapsession->pcap_handle, PCAP_INFINITE, handler, (void*)pcapsession);
+
+	// Clear the file descriptor fields for this file
+	pcapsession->supervise_fd = PCAP_SESSION_UNSUPERVISED_FD;
+	pcapsession->fd = 0;
+
+	// Close packet capture
+	pcap_close(pcapsession->pcap_handle);
+	pcapsession->pcap_handle = NULL;
+
+	return 1;
+}
+
+//
+// This function streams the PCAP files in the directory of a tailing file capture session that it has not streamed
+// yet, in name order. Files that may still be being written are left for their close event or the next scan
+//
+// Parameters:
+//  pcapsession_t* pcapsession: The file capture session
+//  time_t* rescan_time: Set to the time to scan the directory again if files were left, 0 if none were
+//
+// Return:
+//  int: 1 if the directory was scanned, 0 if it could not be read
+//
+static int pcapsession_filecapture_tail_scan(pcapsession_t* pcapsession, time_t* rescan_time)
+{
+	struct dirent** entries;
+	int entry_count = scandir(pcapsession->description, &entries, NULL, alphasort);
+	if (entry_count < 0) {
+		write_to_syslog( "packet capture session %d-%s: %s\n", pcapsession->id, pcapsession->description, strerror(errno));
+		return 0;
+	}
+
+	int unsettled = 0;
+	for (int i = 0; i < entry_count; i++) {
+		if (!pcapsession_filecapture_tail_file(pcapsession, entries[i]->d_name, 1)) {
+			unsettled = 1;
+		}
+		free(entries[i]);
+	}
+	free(entries);
+
+	*rescan_time = unsettled ? time(NULL) + TAIL_SETTLE_SECONDS : 0;
+
+	return 1;
+}
+
+//
+// This function streams a file in the directory of a tailing file capture session if it is a PCAP file that has not
+// been streamed yet and records that it is streamed. A file that cannot be opened is not recorded, so that it is tried
+// again on its next event, as when a file moved in while it was still being written is closed. A file found by a
+// directory scan rather than an event is left alone while it may still be open for writing, as its close event may
+// not have arrived yet
+//
+// Parameters:
+//  pcapsession_t* pcapsession: The file capture session
+//  const char* file_name: The name of the file in the directory
+//  int scanned: 1 if the file was found by a directory scan, 0 if it was named by a directory event
+//
+// Return:
+//  int: 0 if a scanned file was modified too recently to stream, 1 otherwise
+//
+static int pcapsession_filecapture_tail_file(pcapsession_t* pcapsession, const char* file_name, int scanned)
+{
+	if (!pcapsession_filecapture_is_pcap_file(file_name) || pcapsession_filecapture_journal_find(&pcapsession->journal, file_name, NULL)) {
+		return 1;
+	}
+
+	if (scanned && !pcapsession_filecapture_tail_settled(pcapsession, file_name)) {
+		return 0;
+	}
+
+	if (!pcapsession_filecapture_stream_file(pcapsession, file_name)) {
+		write_to_syslog( "file capture session: %d-%s: file %s not streamed, it is tried again when it is next written\n",
+				pcapsession->id, pcapsession->description, file_name);
+		return 1;
+	}
+
+	if (!pcapsession_filecapture_journal_add(&pcapsession->journal, file_name, 1)) {
+		write_to_syslog( "file capture session: %d-%s: could not record file %s as streamed\n", pcapsession->id, pcapsession->description, file_name);
+	}
+
+	return 1;
+}
+
+//
+// This function checks if a file found by a directory scan of a tailing file capture session is complete. A file is
+// not complete while it is open for writing, which Linux reports by refusing a read lease on it, or if it was modified
+// within the settle time, which covers file systems without leases
+//
+// Parameters:
+//  pcapsession_t* pcapsession: The file capture session
+//  const char* file_name: The name of the file in the directory
+//
+// Return:
+//  int: 1 if the file may be streamed, 0 if it may still be being written
+//
+static int pcapsession_filecapture_tail_settled(pcapsession_t* pcapsession, const char* file_name)
+{
+	char file_path[FILENAME_MAX];
+	if (snprintf(file_path, FILENAME_MAX, "%s/%s", pcapsession->description, file_name) >= FILENAME_MAX) {
+		// Let streaming report the path
+		return 1;
+	}
+
+	int fd = open(file_path, O_RDONLY | O_CLOEXEC | O_NONBLOCK);
+	if (fd < 0) {
+		// Let streaming report the file
+		return 1;
+	}
+
+	int settled = 1;
+	struct stat file_stat;
+	if (fcntl(fd, F_SETLEASE, F_RDLCK) == 0) {
+		fcntl(fd, F_SETLEASE, F_UNLCK);
+	}
+	else if (errno == EAGAIN) {
+		settled = 0;
+	}
+	if (settled && fstat(fd, &file_stat) == 0 && file_stat.st_mtime > time(NULL) - TAIL_SETTLE_SECONDS) {
+		settled = 0;
+	}
+
+	close(fd);
+	return settled;
+}
+
+//
+// This function loads the names in the journal file of a file journal and opens the journal file for appending, nothing
+// is loaded if the journal has no file
+//
+// Parameters:
+//  pcapsession_file_journal_t* journal: The file journal
+//
+// Return:
+//  int: 1 if the journal was loaded, 0 otherwise
+//
+static int pcapsession_filecapture_journal_open(pcapsession_file_journal_t* journal)
+{
+	if (journal->file_name[0] == '\0') {
+		return 1;
+	}
+
+	// A journal file that does not exist yet is empty
+	FILE* journal_file = fopen(journal->file_name, "r");
+	if (journal_file != NULL) {
+		char* line = NULL;
+		size_t line_size = 0;
+		ssize_t length;
+		while ((length = getline(&line, &line_size, journal_file)) >= 0) {
+			line[strcspn(line, "\r\n")] = '\0';
+			if (line[0] != '\0' && !pcapsession_filecapture_journal_add(journal, line, 0)) {
+				free(line);
+				fclose(journal_file);
+				return 0;
+			}
+		}
+		free(line);
+		fclose(journal_file);
+	}
+	else if (errno != ENOENT) {
+		return 0;
+	}
+
+	journal->file = fopen(journal->file_name, "a");
+	return journal->file != NULL;
+}
+
+//
+// This function finds a name in a file journal by binary search
+//
+// Parameters:
+//  const pcapsession_file_journal_t* journal: The file journal
+//  const char* name: The name to find
+//  size_t* position: The position of the name, or the position it would be added at, is returned here if it is not NULL
+//
+// Return:
+//  int: 1 if the name is in the journal, 0 otherwise
+//
+static int pcapsession_filecapture_journal_find(const pcapsession_file_journal_t* journal, const char* name, size_t* position)
+{
+	size_t low = 0;
+	size_t high = journal->count;
+	int found = 0;
+
+	while (low < high && !found) {
+		size_t middle = low + (high - low) / 2;
+		int compare = strcmp(journal->names[middle], name);
+		if (compare == 0) {
+			low = middle;
+			found = 1;
+		}
+		else if (compare < 0) {
+			low = middle + 1;
+		}
+		else {
+			high = middle;
+		}
+	}
+
+	if (position != NULL) {
+		*position = low;
+	}
+
+	return found;
+}
+
+//
+// This function adds a name to a file journal, names are usually added in order so they are mostly added at the end
+//
+// Parameters:
+//  pcapsession_file_journal_t* journal: The file journal
+//  const char* name: The name to add
+//  int record: 1 if the name is also to be appended to the journal file if it is open, 0 if it was loaded from it
+//
+// Return:
+//  int: 1 if the name was added, 0 if it could not be allocated or recorded
+//
+static int pcapsession_filecapture_journal_add(pcapsession_file_journal_t* journal, const char* name, int record)
+{
+	size_t position;
+	if (pcapsession_filecapture_journal_find(journal, name, &position)) {
+		return 1;
+	}
+
+	if (journal->count == journal->size) {
+		size_t size = journal->size != 0 ? journal->size * 2 : 256;
+		char** names = realloc(journal->names, size * sizeof(char*));
+		if (names == NULL) {
+			return 0;
+		}
+		journal->names = names;
+		journal->size = size;
+	}
+
+	char* name_copy = strdup(name);
+	if (name_copy == NULL) {
+		return 0;
+	}
+
+	memmove(&journal->names[position + 1], &journal->names[position], (journal->count - position) * sizeof(char*));
+	journal->names[position] = name_copy;
+	journal->count++;
+
+	// The journal file is flushed for each file so that a restart after a crash does not stream the file again
+	if (record && journal->file != NULL) {
+		if (fprintf(journal->file, "%s\n", name) < 0 || fflush(journal->file) != 0) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+//
+// This function closes the journal file of a file journal and frees its names, the name of the journal file is kept
+//
+// Parameters:
+//  pcapsession_file_journal_t* journal: The file journal
+//
+static void pcapsession_filecapture_journal_close(pcapsession_file_journal_t* journal)
+{
+	if (journal->file != NULL) {
+		fclose(journal->file);
+		journal->file = NULL;
+	}
+
+	for (size_t i = 0; i < journal->count; i++) {
+		free(journal->names[i]);
+	}
+	free(journal->names);
+	journal->names = NULL;
+	journal->count = 0;
+	journal->size = 0;
+}
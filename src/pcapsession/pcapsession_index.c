@@ -0,0 +1,176 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: pcapsession_index.c
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This module writes sparse time index files for PCAP files as they are dumped. An index file is a header followed by
+ * one entry per segment of consecutive records, giving the offset and length of the segment and the range of its time
+ * stamps, so that the records of a time range can be found without reading the PCAP file from the start
+ */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <pcapdefines.h>
+#include <pcapsession.h>
+
+// Forward definition of private functions
+static void pcapsession_indexer_write_entry(pcapsession_indexer_t* indexer);
+
+//
+// This function opens the time index file of a PCAP file that is about to be dumped, the index file is named
+// <pcap_file_name>.idx. The index is a list of segments of consecutive records, a segment is ended when it holds
+// index_records records or when a record is index_msec or more after the first record of the segment
+//
+// Parameters:
+//  pcapsession_indexer_t* indexer: The indexer
+//  const char* pcap_file_name: The name of the PCAP file
+//  unsigned long index_records: The largest number of records in a segment, 0 if not limited
+//  unsigned long index_msec: The longest time span of a segment in milliseconds, 0 if not limited
+//
+// Return:
+//  int: 1 if the index file was opened, 0 otherwise
+//
+int pcapsession_indexer_open(pcapsession_indexer_t* indexer, const char* pcap_file_name, unsigned long index_records, unsigned long index_msec)
+{
+	memset(indexer, 0, sizeof(pcapsession_indexer_t));
+	indexer->interval_records = index_records;
+	indexer->interval_usec = (uint64_t)index_msec * 1000;
+	indexer->offset = sizeof(struct pcap_file_header);
+	indexer->sorted = 1;
+
+	char index_file_name[FILENAME_MAX];
+	if (snprintf(index_file_name, FILENAME_MAX, "%s%s", pcap_file_name, PCAP_INDEX_FILE_TYPE) >= FILENAME_MAX) {
+		return 0;
+	}
+
+	indexer->index_file = fopen(index_file_name, "w");
+	if (indexer->index_file == NULL) {
+		return 0;
+	}
+
+	struct pcapsession_index_header index_header;
+	memset(&index_header, 0, sizeof(struct pcapsession_index_header));
+	memcpy(index_header.magic, PCAP_INDEX_MAGIC, sizeof(PCAP_INDEX_MAGIC));
+	index_header.version = PCAP_INDEX_VERSION;
+	index_header.interval_records = indexer->interval_records;
+	index_header.interval_usec = indexer->interval_usec;
+
+	if (fwrite(&index_header, sizeof(struct pcapsession_index_header), 1, indexer->index_file) != 1) {
+		fclose(indexer->index_file);
+		indexer->index_file = NULL;
+		return 0;
+	}
+
+	return 1;
+}
+
+//
+// This function adds a record just dumped to the PCAP file to its time index, nothing is done if no index file is open
+//
+// Parameters:
+//  pcapsession_indexer_t* indexer: The indexer
+//  const struct pcap_pkthdr* header: A pointer to the header of the record as it was dumped
+//
+void pcapsession_indexer_add(pcapsession_indexer_t* indexer, const struct pcap_pkthdr* header)
+{
+	if (indexer->index_file == NULL) {
+		return;
+	}
+
+	struct pcapsession_index_entry* entry = &indexer->entry;
+	int64_t usec = (int64_t)header->ts.tv_sec * 1000000 + header->ts.tv_usec;
+
+	// End the segment if it is full or if this record is too long after its first record
+	if (entry->records != 0 &&
+			((indexer->interval_records != 0 && entry->records >= indexer->interval_records) ||
+			(indexer->interval_usec != 0 && usec - entry->first_usec >= (int64_t)indexer->interval_usec))) {
+		pcapsession_indexer_write_entry(indexer);
+	}
+
+	// The first record of the file starts the running maximum time stamp
+	if (indexer->offset == sizeof(struct pcap_file_header)) {
+		entry->running_max_usec = usec;
+	}
+	else if (usec < indexer->last_usec) {
+		indexer->sorted = 0;
+	}
+	indexer->last_usec = usec;
+
+	// Start a new segment at this record, the running maximum carries over from the segment before
+	if (entry->records == 0) {
+		entry->offset = indexer->offset;
+		entry->length = 0;
+		entry->first_usec = usec;
+		entry->min_usec = usec;
+		entry->max_usec = usec;
+	}
+
+	entry->records++;
+	entry->length += PCAP_RECORD_HEADER_SIZE + header->caplen;
+	if (usec < entry->min_usec) {
+		entry->min_usec = usec;
+	}
+	if (usec > entry->max_usec) {
+		entry->max_usec = usec;
+	}
+	if (usec > entry->running_max_usec) {
+		entry->running_max_usec = usec;
+	}
+
+	indexer->offset += PCAP_RECORD_HEADER_SIZE + header->caplen;
+}
+
+//
+// This function writes the last segment of a time index, records in the header whether the PCAP file is in time
+// stamp order and closes the index file
+//
+// Parameters:
+//  pcapsession_indexer_t* indexer: The indexer
+//
+void pcapsession_indexer_close(pcapsession_indexer_t* indexer)
+{
+	if (indexer->index_file == NULL) {
+		return;
+	}
+
+	if (indexer->entry.records != 0) {
+		pcapsession_indexer_write_entry(indexer);
+	}
+
+	// The order of the records is only known once all of them are indexed
+	uint32_t sorted = indexer->sorted;
+	if (fseek(indexer->index_file, offsetof(struct pcapsession_index_header, sorted), SEEK_SET) == 0) {
+		fwrite(&sorted, sizeof(sorted), 1, indexer->index_file);
+	}
+
+	fclose(indexer->index_file);
+	indexer->index_file = NULL;
+}
+
+//
+// This function writes the entry of the segment being indexed and starts a new segment, the index file is flushed so
+// that readers of a file that is still being dumped see whole entries
+//
+// Parameters:
+//  pcapsession_indexer_t* indexer: The indexer
+//
+static void pcapsession_indexer_write_entry(pcapsession_indexer_t* indexer)
+{
+	fwrite(&indexer->entry, sizeof(struct pcapsession_index_entry), 1, indexer->index_file);
+	fflush(indexer->index_file);
+
+	indexer->entry.records = 0;
+}
@@ -28,6 +28,7 @@
 // Forward definition of private functions
 void* pcapsession_livecapture_run(void* pcapsession_param);
 void* pcapsession_livecapture_stop(void* pcapsession_param);
+void pcapsession_livecapture_sample_drops(pcapsession_t* pcapsession);
 
 //
 // This function opens a PCAP live capture session
@@ -77,6 +78,9 @@ int pcapsession_livecapture_open(char* interface_name)
 	pcapsession->untunnel = PCAP_SESSION_UNTUNNEL_OFF;
 	pcapsession->iterations = 0;
 
+	// Packets are time stamped as they are captured
+	pcapsession->live_timestamps = 1;
+
 	// Return the result of adding the new pcapsession
 	return pcapsession_handling_add(pcapsession->id);
 }
@@ -105,7 +109,16 @@ void* pcapsession_livecapture_run(void* pcapsession_param)
 	// Set the monitor for this client
 	pcapsession->monitor = monitor_open(pcapsession->id, pcapsession->description);
 
-	pcap_loop(pcapsession->pcap_handle, PCAP_INFINITE, pcapsession_clientconn_packet_handler, (void*)pcapsession);
+	// Capture in batches rather than with pcap_loop() so that the drop counters on the handle can be sampled by this thread,
+	// pcap_dispatch() returns 0 when the capture times out so idle interfaces are sampled as well
+	time_t last_sample_time = 0;
+	while (pcap_dispatch(pcapsession->pcap_handle, PCAP_INFINITE, pcapsession_clientconn_packet_handler, (void*)pcapsession) >= 0) {
+		time_t current_time = time(NULL);
+		if (current_time != last_sample_time) {
+			pcapsession_livecapture_sample_drops(pcapsession);
+			last_sample_time = current_time;
+		}
+	}
 
 	// Packet capture has been interrupted
 	write_to_syslog( "packet capture interrupted on session: %d-%s\n", pcapsession->id, pcapsession->description);
@@ -120,6 +133,22 @@ void* pcapsession_livecapture_run(void* pcapsession_param)
 	return NULL;
 }
 
+//
+// This function samples the kernel and interface drop counters of a live capture session into its monitor
+//
+// Parameters:
+//  pcapsession_t* pcapsession: The live capture session
+//
+void pcapsession_livecapture_sample_drops(pcapsession_t* pcapsession)
+{
+	struct pcap_stat pcap_stat;
+	if (pcap_stats(pcapsession->pcap_handle, &pcap_stat) != 0) {
+		return;
+	}
+
+	monitor_set_capture_drops(pcapsession->monitor, pcap_stat.ps_drop, pcap_stat.ps_ifdrop);
+}
+
 //
 // This function stops the live capture session, the state is reset back to PCAP_SESSION_START so that session handling will attempt to
 // restart the server.
@@ -39,15 +39,18 @@ pthread_mutex_t merge_mutex = PTHREAD_MUTEX_INITIALIZER;
 //
 // Parameters:
 //  char* filename: The name of the file to dump to "-" for stdout
-//  addresslist_t* addresslist: The list of addresses of servers to connect to
 //  int untunnel: If true, GTP-U packets should be untunnelled
+//  unsigned long index_records: The largest number of records between time index entries, 0 if not limited
+//  unsigned long index_msec: The longest time in milliseconds between time index entries, 0 if not limited, no time
+//                            index is written if both are 0
 //
 // Returns:
 //  pcapsession_t*: Returns a pointer to the merger or NULL if opening failed
 //
-pcapsession_t* pcapsession_merger_open(char* filename, int untunnel)
+pcapsession_t* pcapsession_merger_open(char* filename, int untunnel, unsigned long index_records, unsigned long index_msec)
 {
-	write_to_syslog( "starting merging session to file %s, untunnel=%d\n", filename, untunnel);
+	write_to_syslog( "starting merging session to file %s, untunnel=%d, index_records=%lu, index_interval_ms=%lu\n",
+			filename, untunnel, index_records, index_msec);
 
 	// Get and check if a new PCAP session is available
 	pcapsession_t* pcapsession = pcapsession_handling_get_new();
@@ -62,6 +65,11 @@ pcapsession_t* pcapsession_merger_open(char* filename, int untunnel)
 	// Set whether untunnelling is turned on for this session
 	pcapsession->untunnel = untunnel;
 
+	// Set the intervals of the time index of the merged file
+	pcapsession->index_records = index_records;
+	pcapsession->index_msec = index_msec;
+	pcapsession->indexer.index_file = NULL;
+
 	// Clear other fields on this session for now
 	pcapsession->monitor = NULL;
 	pcapsession->pcap_handle = NULL;
@@ -106,6 +114,7 @@ void* pcapsession_merger_run(void* pcapsession_param)
 
 	// Set the monitor for this client
 	pcapsession->monitor = monitor_open(pcapsession->id, pcapsession->description);
+	monitor_enable_latency(pcapsession->monitor, "receive-to-write");
 
 	// Start PCAP dumping on the specified file
 	write_to_syslog( "merger session %d-%s: packet dumping to file starting\n", pcapsession->id, pcapsession->description);
@@ -128,6 +137,13 @@ void* pcapsession_merger_run(void* pcapsession_param)
 	// Get the file descriptor from the PCAP dumper
 	pcapsession->fd = fileno(pcap_dump_file(pcapsession->pcap_dumper));
 
+	// Start the time index of the merged file, merging continues without it if it cannot be opened
+	if ((pcapsession->index_records != 0 || pcapsession->index_msec != 0) && strcmp(pcapsession->description, "-") != 0) {
+		if (!pcapsession_indexer_open(&pcapsession->indexer, pcapsession->description, pcapsession->index_records, pcapsession->index_msec)) {
+			write_to_syslog( "merger session %d-%s: time index open failed\n", pcapsession->id, pcapsession->description);
+		}
+	}
+
 	write_to_syslog( "merger session %d-%s: packet dumping to file started\n", pcapsession->id, pcapsession->description);
 
 	// Happy days, merger is open
@@ -163,6 +179,9 @@ void* pcapsession_merger_stop(void* pcapsession_param)
 	}
 	pcapsession->pcap_dumper = NULL;
 
+	// Write the last entry of the time index and close it
+	pcapsession_indexer_close(&pcapsession->indexer);
+
 	// Close the PCAP handle
 	if (pcapsession->pcap_handle != NULL) {
 		pcap_close(pcapsession->pcap_handle);
@@ -220,6 +239,10 @@ void pcapsession_merger_packet_handler(unsigned char* pcapsession_param, const s
 	// Dereference the pcapsession_t pointer
 	pcapsession_t* pcapsession = (pcapsession_t*)pcapsession_param;
 
+	// Note when the packet was received, the time waiting for the merge lock counts towards latency
+	struct timeval received;
+	gettimeofday(&received, NULL);
+
 	// Get and check the merger from the session handler
 	pcapsession_t* pcapsession_merger = pcapsession->handler;
 	if (pcapsession_merger == NULL) {
@@ -238,13 +261,14 @@ void pcapsession_merger_packet_handler(unsigned char* pcapsession_param, const s
 	// Check if this packet should be untunnelled
 	if (pcapsession_merger->untunnel == PCAP_SESSION_UNTUNNEL_ON) {
 		// Untunnel the packet
-		pcapsession_untunnel_packet(pcapsession_merger, &new_header, data);
+		pcapsession_untunnel_packet(pcapsession_merger, DLT_EN10MB, &new_header, data);
 	}
 
 	// Dump the packet
 	// esirich DEFTFTS-1634 lock the pcap_dump so the monitor can flush
 	pthread_mutex_lock(&(pcapsession_merger->pcap_mutex));
 	pcap_dump((unsigned char*)pcapsession_merger->pcap_dumper, &new_header, data);
+	pcapsession_indexer_add(&pcapsession_merger->indexer, &new_header);
 	pthread_mutex_unlock(&(pcapsession_merger->pcap_mutex));
 
 	// Add a packet and the number of bytes to the monitor for the server connection
@@ -253,6 +277,11 @@ void pcapsession_merger_packet_handler(unsigned char* pcapsession_param, const s
 	// Add a packet and the number of bytes to the monitor for the merger
 	monitor_increment(pcapsession_merger->monitor, 1, header->len);
 
+	// Record the latency from reception to write on the merger, only one client writes at a time
+	struct timeval written;
+	gettimeofday(&written, NULL);
+	monitor_record_latency(pcapsession_merger->monitor, monitor_usec_between(&received, &written));
+
 	// CRITICAL SECTION OVER, packet written to merged PCAP file
 	pthread_mutex_unlock(&merge_mutex);
 }
@@ -0,0 +1,175 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: pcapsession_pacer.c
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This module paces the packets sent by a file capture session, either with the gaps between their time stamps scaled
+ * by a speed or at a fixed packet or bit rate. Rate pacing is a token bucket kept as the time the next packet is due,
+ * each packet moves the due time on by its cost and the due time may fall at most a burst behind the clock
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+#include <pcapsession.h>
+
+// The length of the burst a rate paced session may send to catch up after falling behind
+#define PACER_BURST_NSEC 1000000
+
+// Time stamps that go back by more than this restart timed pacing, as when one file is older than the one before it
+#define PACER_RESYNC_USEC 1000000
+
+// Waits longer than this sleep until this long before the packet is due and poll the clock from then on
+#define PACER_SPIN_NSEC 100000
+
+// Forward definition of private functions
+static inline int64_t pcapsession_pacer_now(void);
+static int64_t pcapsession_pacer_wait_until(int64_t due_nsec);
+
+//
+// This function initializes a pacer, packets are paced from the first packet waited for
+//
+// Parameters:
+//  pcapsession_pacer_t* pacer: The pacer
+//  const pcapsession_pacing_t* pacing: The pacing settings, NULL to send packets as fast as they are read
+//
+void pcapsession_pacer_init(pcapsession_pacer_t* pacer, const pcapsession_pacing_t* pacing)
+{
+	memset(pacer, 0, sizeof(pcapsession_pacer_t));
+
+	if (pacing != NULL) {
+		pacer->pacing = *pacing;
+	}
+	else {
+		pacer->pacing.mode = PCAP_SESSION_PACING_OFF;
+	}
+
+	pacer->burst_nsec = PACER_BURST_NSEC;
+}
+
+//
+// This function restarts timed pacing from the next packet waited for, as when the time stamps start again on a new
+// iteration over the files. Rate pacing is not affected, its next packet stays due when it was
+//
+// Parameters:
+//  pcapsession_pacer_t* pacer: The pacer
+//
+void pcapsession_pacer_resync(pcapsession_pacer_t* pacer)
+{
+	if (pacer->pacing.mode == PCAP_SESSION_PACING_TIMED) {
+		pacer->started = 0;
+	}
+}
+
+//
+// This function waits until a packet is due to be sent, the wait sleeps until shortly before the packet is due and
+// then polls the clock so that packets are sent at the time they are due to within a few microseconds
+//
+// Parameters:
+//  pcapsession_pacer_t* pacer: The pacer
+//  const struct pcap_pkthdr* header: A pointer to the header of the packet
+//
+// Return:
+//  long long: The number of microseconds after the time it was due that the packet is sent
+//
+long long pcapsession_pacer_wait(pcapsession_pacer_t* pacer, const struct pcap_pkthdr* header)
+{
+	if (pacer->pacing.mode == PCAP_SESSION_PACING_OFF) {
+		return 0;
+	}
+
+	int64_t usec = (int64_t)header->ts.tv_sec * 1000000 + header->ts.tv_usec;
+	int64_t now_nsec = pcapsession_pacer_now();
+	if (!pacer->started) {
+		pacer->started = 1;
+		pacer->start_nsec = now_nsec;
+		pacer->start_usec = usec;
+		pacer->last_usec = usec;
+		pacer->next_nsec = 0;
+	}
+
+	int64_t due_nsec;
+	if (pacer->pacing.mode == PCAP_SESSION_PACING_TIMED) {
+		// Packets a little out of order are sent at once, a big step back starts the timing again from this packet
+		if (usec < pacer->last_usec - PACER_RESYNC_USEC) {
+			pacer->start_nsec = now_nsec;
+			pacer->start_usec = usec;
+		}
+		pacer->last_usec = usec;
+
+		due_nsec = pacer->start_nsec + (int64_t)((usec - pacer->start_usec) * 1000 / pacer->pacing.speed);
+	}
+	else {
+		// Credit for the time the session was not sending is limited to one burst
+		double elapsed_nsec = now_nsec - pacer->start_nsec;
+		if (pacer->next_nsec < elapsed_nsec - pacer->burst_nsec) {
+			pacer->next_nsec = elapsed_nsec - pacer->burst_nsec;
+		}
+
+		due_nsec = pacer->start_nsec + (int64_t)pacer->next_nsec;
+
+		double cost = pacer->pacing.mode == PCAP_SESSION_PACING_BIT_RATE ? header->len * 8.0 : 1.0;
+		pacer->next_nsec += cost * 1000000000.0 / pacer->pacing.rate;
+	}
+
+	if (due_nsec <= now_nsec) {
+		return (now_nsec - due_nsec) / 1000;
+	}
+
+	return (pcapsession_pacer_wait_until(due_nsec) - due_nsec) / 1000;
+}
+
+//
+// This function returns the time on the monotonic clock
+//
+// Return:
+//  int64_t: The time in nanoseconds
+//
+static inline int64_t pcapsession_pacer_now(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+//
+// This function waits until a time on the monotonic clock, it sleeps for all but the last PACER_SPIN_NSEC of the wait
+// and polls the clock for the rest, as a sleep may end tens of microseconds late
+//
+// Parameters:
+//  int64_t due_nsec: The time to wait until in nanoseconds
+//
+// Return:
+//  int64_t: The time the wait ended in nanoseconds
+//
+static int64_t pcapsession_pacer_wait_until(int64_t due_nsec)
+{
+	int64_t now_nsec = pcapsession_pacer_now();
+
+	if (due_nsec - now_nsec > PACER_SPIN_NSEC) {
+		struct timespec wake;
+		wake.tv_sec = (due_nsec - PACER_SPIN_NSEC) / 1000000000;
+		wake.tv_nsec = (due_nsec - PACER_SPIN_NSEC) % 1000000000;
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL) == EINTR);
+		now_nsec = pcapsession_pacer_now();
+	}
+
+	while (now_nsec < due_nsec) {
+		now_nsec = pcapsession_pacer_now();
+	}
+
+	return now_nsec;
+}
@@ -0,0 +1,316 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: pcapsession_rewrite.c
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This module handles the offline rewriting of packets: remapping the addresses of GTP-U tunnelled packets and of
+ * the packets carrying them with incremental checksum updates, rewriting time stamps and splitting the packets over
+ * chunk files of a maximum size, each optionally with a time index
+ */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <netinet/ip.h>
+#include <netinet/tcp.h>
+#include <netinet/udp.h>
+
+#include <gtpv1.h>
+#include <gtp_classify.h>
+#include <gtp_ie_iterator.h>
+#include <pcapsession.h>
+
+// Forward definition of private functions
+static int pcapsession_remap_ip(const pcapsession_address_map_t* map, u_int length, u_char* data, u_int ip, u_int payload_sum, u_int* parent_sum);
+static inline void pcapsession_rewrite_word(u_char* field, u_int value, u_int* sum);
+static inline u_int pcapsession_checksum_adjust(u_int checksum, u_int sum);
+
+//
+// This function changes the addresses of a packet that are in an address map. The addresses of the IPv4 packet tunnelled
+// in a G-PDU, of the IPv4 packet carrying GTP and of other IPv4 packets can be changed. The IPv4 header checksum and
+// any TCP or UDP checksum are updated incrementally, as is the UDP checksum of the packet carrying GTP when the
+// tunnelled packet is changed
+//
+// Parameters:
+//  int linktype: The link layer type of the capture, DLT_EN10MB or DLT_LINUX_SLL
+//  struct pcap_pkthdr* header: A pointer to the header of the packet
+//  const unsigned char* data: A pointer to the packet data
+//  const pcapsession_address_map_t* map: The address map
+//  int headers: The headers to remap, a combination of the PCAP_SESSION_REMAP_ flags
+//
+// Return:
+//  int: The number of addresses changed
+//
+int pcapsession_remap_packet(int linktype, struct pcap_pkthdr* header, const unsigned char* data, const pcapsession_address_map_t* map, int headers)
+{
+	struct gtp_class packet_class;
+	int type = gtp_classify_packet(linktype, header->caplen, data, &packet_class);
+	u_char* packet = (u_char*)data;
+	int changed = 0;
+
+	// The changes to the tunnelled packet are summed to update the UDP checksum of the packet carrying it
+	u_int payload_sum = 0;
+	u_int payload = packet_class.payload_offset;
+	if ((headers & PCAP_SESSION_REMAP_INNER) && type != GTP_CLASS_NONE && type != GTP_CLASS_C && payload != 0 &&
+			payload + sizeof(struct ip) <= header->caplen && (data[payload] >> 4) == IPVERSION) {
+		changed += pcapsession_remap_ip(map, header->caplen, packet, payload, 0, &payload_sum);
+	}
+
+	u_int ip = 0;
+	if (type != GTP_CLASS_NONE) {
+		ip = packet_class.ip_offset;
+	}
+	else if (headers & PCAP_SESSION_REMAP_OUTER) {
+		ip = gtp_classify_locate_ip(linktype, header->caplen, data, &packet_class);
+	}
+
+	// The packet carrying GTP has its checksum updated for the changes to the tunnelled packet even if its own
+	// addresses are not remapped
+	if (ip != 0 && ((headers & PCAP_SESSION_REMAP_OUTER) || changed != 0)) {
+		changed += pcapsession_remap_ip((headers & PCAP_SESSION_REMAP_OUTER) ? map : NULL, header->caplen, packet, ip, payload_sum, NULL);
+	}
+
+	return changed;
+}
+
+//
+// This function rewrites the time stamp of a packet, the first packet keeps its time stamp and each later packet is
+// stamped one microsecond after the one before it
+//
+// Parameters:
+//  struct pcap_pkthdr* header: A pointer to the header of the packet
+//  struct timeval* last_ts: The time stamp of the previous packet, zero before the first packet
+//
+void pcapsession_restamp_packet(struct pcap_pkthdr* header, struct timeval* last_ts)
+{
+	// Check if the time stamp has been set yet
+	if (last_ts->tv_sec == 0) {
+		// Initialize the time stamp
+		last_ts->tv_sec = header->ts.tv_sec;
+		last_ts->tv_usec = header->ts.tv_usec;
+	}
+	else {
+		// Increment microsecond count
+		last_ts->tv_usec++;
+
+		// Check if microseconds have looped
+		if (last_ts->tv_usec >= 1000000) {
+			last_ts->tv_sec++;
+			last_ts->tv_usec = 0;
+		}
+	}
+
+	header->ts = *last_ts;
+}
+
+//
+// This function initializes splitting dumped packets over chunk files, the files are named
+// <file_name>_<chunk number>.pcap
+//
+// Parameters:
+//  pcapsession_chunker_t* chunker: The chunker to initialize
+//  pcap_t* pcap_handle: The PCAP handle whose link type and snap length the chunk files take
+//  const char* file_name: The prefix of the chunk file names
+//  unsigned long max_size: The maximum size of a chunk file
+//
+void pcapsession_chunker_init(pcapsession_chunker_t* chunker, pcap_t* pcap_handle, const char* file_name, unsigned long max_size)
+{
+	memset(chunker, 0, sizeof(pcapsession_chunker_t));
+	chunker->pcap_handle = pcap_handle;
+	chunker->file_name = file_name;
+	chunker->max_size = max_size;
+}
+
+//
+// This function dumps a packet to the current chunk file, closing it and starting the next one if the packet does
+// not fit
+//
+// Parameters:
+//  pcapsession_chunker_t* chunker: The chunker
+//  const struct pcap_pkthdr* header: A pointer to the header of the packet
+//  const unsigned char* data: A pointer to the packet data
+//
+// Return:
+//  int: 1 if a new chunk file was started, 0 if the packet was dumped to the current one, -1 if the new chunk file
+//       could not be opened
+//
+int pcapsession_chunker_dump(pcapsession_chunker_t* chunker, const struct pcap_pkthdr* header, const unsigned char* data)
+{
+	int started = 0;
+
+	// Check if we need to close the current dumper
+	if ((chunker->used + sizeof(struct pcap_pkthdr) + header->caplen) > chunker->max_size && chunker->pcap_dumper != NULL) {
+		pcap_dump_close(chunker->pcap_dumper);
+		pcapsession_indexer_close(&chunker->indexer);
+		chunker->pcap_dumper = NULL;
+		chunker->used = 0;
+	}
+
+	// Check if we need to open the dumper
+	if (chunker->pcap_dumper == NULL) {
+		snprintf(chunker->chunk_file_name, FILENAME_MAX, "%s_%06lu.pcap", chunker->file_name, chunker->chunk_no++);
+
+		chunker->pcap_dumper = pcap_dump_open(chunker->pcap_handle, chunker->chunk_file_name);
+		if (chunker->pcap_dumper == NULL) {
+			return -1;
+		}
+		started = 1;
+
+		// A chunk file without its index can still be read from the start, so a failure to open the index is not fatal
+		if (chunker->index_records != 0 || chunker->index_msec != 0) {
+			pcapsession_indexer_open(&chunker->indexer, chunker->chunk_file_name, chunker->index_records, chunker->index_msec);
+		}
+	}
+
+	// Dump the packet and index it
+	pcap_dump((unsigned char*)chunker->pcap_dumper, header, data);
+	pcapsession_indexer_add(&chunker->indexer, header);
+
+	// Increment chunks used
+	chunker->used += sizeof(struct pcap_pkthdr) + header->caplen;
+
+	return started;
+}
+
+//
+// This function turns on writing a time index file for each chunk file
+//
+// Parameters:
+//  pcapsession_chunker_t* chunker: The chunker
+//  unsigned long index_records: The largest number of records between time index entries, 0 if not limited
+//  unsigned long index_msec: The longest time in milliseconds between time index entries, 0 if not limited
+//
+void pcapsession_chunker_index(pcapsession_chunker_t* chunker, unsigned long index_records, unsigned long index_msec)
+{
+	chunker->index_records = index_records;
+	chunker->index_msec = index_msec;
+}
+
+//
+// This function closes the current chunk file
+//
+// Parameters:
+//  pcapsession_chunker_t* chunker: The chunker
+//
+void pcapsession_chunker_close(pcapsession_chunker_t* chunker)
+{
+	if (chunker->pcap_dumper != NULL) {
+		pcap_dump_close(chunker->pcap_dumper);
+		chunker->pcap_dumper = NULL;
+	}
+	pcapsession_indexer_close(&chunker->indexer);
+}
+
+//
+// This function changes the addresses of an IPv4 packet that are in an address map and updates its header checksum and
+// any TCP or UDP checksum as in RFC 1624. The ones' complement sum of the changes is kept for each checksum, the
+// transport checksum also covers the addresses in its pseudo header and any changes to its payload
+//
+// Parameters:
+//  const pcapsession_address_map_t* map: The address map, NULL to only apply the changes to the payload
+//  u_int length: The amount of data present in the data buffer
+//  u_char* data: A pointer to the packet data, the whole IPv4 header must be present
+//  u_int ip: The offset of the IPv4 header
+//  u_int payload_sum: The sum of the changes already made to the payload of the transport header
+//  u_int* parent_sum: The sum of all changes made here is added to this for the checksum of an enclosing packet, NULL if
+//                     there is none
+//
+// Return:
+//  int: The number of addresses changed
+//
+static int pcapsession_remap_ip(const pcapsession_address_map_t* map, u_int length, u_char* data, u_int ip, u_int payload_sum, u_int* parent_sum)
+{
+	int changed = 0;
+	u_int address_sum = 0;
+	u_int checksum_sum = 0;
+
+	for (u_int field = ip + offsetof(struct ip, ip_src); map != NULL && field <= ip + offsetof(struct ip, ip_dst); field += sizeof(struct in_addr)) {
+		uint32_t new_address;
+		if (pcapsession_address_map_lookup(map, gtp_ie_read32(data + field), &new_address)) {
+			pcapsession_rewrite_word(data + field, new_address >> 16, &address_sum);
+			pcapsession_rewrite_word(data + field + 2, new_address & 0xffff, &address_sum);
+			changed++;
+		}
+	}
+
+	if (changed != 0) {
+		u_char* ip_checksum = data + ip + offsetof(struct ip, ip_sum);
+		pcapsession_rewrite_word(ip_checksum, pcapsession_checksum_adjust(gtp_ie_read16(ip_checksum), address_sum), &checksum_sum);
+	}
+
+	// Only the first fragment of a TCP or UDP packet has the transport header, a UDP checksum of 0 means none was sent
+	u_int header_length = (data[ip] & 0x0f) * 4;
+	u_int protocol = data[ip + offsetof(struct ip, ip_p)];
+	u_int fragment = gtp_ie_read16(data + ip + offsetof(struct ip, ip_off)) & IP_OFFMASK;
+	u_int transport_checksum = 0;
+	if (protocol == IPPROTO_TCP) {
+		transport_checksum = ip + header_length + offsetof(struct tcphdr, th_sum);
+	}
+	else if (protocol == IPPROTO_UDP) {
+		transport_checksum = ip + header_length + offsetof(struct udphdr, uh_sum);
+	}
+
+	if ((changed != 0 || payload_sum != 0) && transport_checksum != 0 && header_length >= sizeof(struct ip) && fragment == 0 &&
+			transport_checksum + 2 <= length) {
+		u_int checksum = gtp_ie_read16(data + transport_checksum);
+		if (protocol == IPPROTO_TCP || checksum != 0) {
+			checksum = pcapsession_checksum_adjust(checksum, address_sum + payload_sum);
+			if (protocol == IPPROTO_UDP && checksum == 0) {
+				checksum = 0xffff;
+			}
+			pcapsession_rewrite_word(data + transport_checksum, checksum, &checksum_sum);
+		}
+	}
+
+	if (parent_sum != NULL) {
+		*parent_sum += address_sum + checksum_sum;
+	}
+
+	return changed;
+}
+
+//
+// This function writes a 16 bit word of a packet in network byte order and adds the change to a ones' complement sum
+//
+// Parameters:
+//  u_char* field: A pointer to the word
+//  u_int value: The new value of the word
+//  u_int* sum: The sum the change is added to
+//
+static inline void pcapsession_rewrite_word(u_char* field, u_int value, u_int* sum)
+{
+	*sum += (~gtp_ie_read16(field) & 0xffff) + value;
+	field[0] = value >> 8;
+	field[1] = value & 0xff;
+}
+
+//
+// This function updates a checksum for a ones' complement sum of changes, HC' = ~(~HC + ~m + m') from RFC 1624
+//
+// Parameters:
+//  u_int checksum: The checksum
+//  u_int sum: The sum of the changes, each the complement of the old word plus the new word
+//
+// Return:
+//  u_int: The updated checksum
+//
+static inline u_int pcapsession_checksum_adjust(u_int checksum, u_int sum)
+{
+	sum += ~checksum & 0xffff;
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return ~sum & 0xffff;
+}
@@ -22,64 +22,84 @@
 #include <net/ethernet.h>
 
 #include <gtpv1.h>
+#include <gtp_classify.h>
 #include <pcapsession.h>
 
 //
-// This function untunnels GTP-U packets by moving the enclosed IP header up to just under the Ethernet header
+// This function untunnels GTP-U packets by moving the enclosed IP header up to just under the link layer header
 //
 // Parameters:
 //  pcapsession_t*: Returns a pointer to the merger or NULL if opening failed
+//  int linktype: The link layer type of the capture, DLT_EN10MB or DLT_LINUX_SLL
+//  struct pcap_pkthdr* header: A pointer to the header of the packet
 //  const unsigned char* data: A pointer to the packet data
 //
-void pcapsession_untunnel_packet(pcapsession_t* pcapsession, struct pcap_pkthdr* header, const unsigned char* data)
+void pcapsession_untunnel_packet(pcapsession_t* pcapsession, int linktype, struct pcap_pkthdr* header, const unsigned char* data)
 {
-	// Search for a GTP v1 header in the packet
-	struct gtpv1hdr* gtpv1hdr = gtpv1_get_header(header->caplen, data);
+	struct gtp_class packet_class;
+	gtp_classify_packet(linktype, header->caplen, data, &packet_class);
 
-	// Check if the header was found
-	if (gtpv1hdr == NULL) {
+	pcapsession_untunnel_classified_packet(pcapsession, header, data, &packet_class);
+}
+
+//
+// This function untunnels a GTP-U packet that has already been classified
+//
+// Parameters:
+//  pcapsession_t*: Returns a pointer to the merger or NULL if opening failed
+//  struct pcap_pkthdr* header: A pointer to the header of the packet
+//  const unsigned char* data: A pointer to the packet data
+//  const struct gtp_class* packet_class: The class of the packet
+//
+void pcapsession_untunnel_classified_packet(pcapsession_t* pcapsession, struct pcap_pkthdr* header, const unsigned char* data, const struct gtp_class* packet_class)
+{
+	// Check if a GTP V1 header was found
+	if (packet_class->type == GTP_CLASS_NONE) {
 		return;
 	}
 
 	// Increment the GTP counters in the monitor, only use monitor if we're using a PCAP session
 	if (pcapsession != NULL) {
-		monitor_increment_gtp(pcapsession->monitor, 1, header->len, gtpv1hdr->flag_options);
+		monitor_increment_gtp(pcapsession->monitor, 1, header->len, packet_class->flag_options);
 	}
 
 	// Check if this packet has extension headers, if so do not untunnel it because there are very few
 	// of these packets and implementation is complex
 	// TODO: Implement extension header handling
-	if (GTP_EXT_FLAG(gtpv1hdr->flag_options)) {
+	if (GTP_EXT_FLAG(packet_class->flag_options)) {
 		return;
 	}
 
-	// Find the end of the GTP header
-	char* source_ptr = ((char*)gtpv1hdr) + sizeof(struct gtpv1hdr);
+	// Check that the optional fields are present
+	if (packet_class->payload_offset == 0) {
+		return;
+	}
 
-	// Find if there are optional fields
-	if (gtpv1hdr->flag_options) {
-		// There are optional fields
-		source_ptr += sizeof(struct gtpv1hdropt);
+	// A mirrored packet keeps the Ethernet header inside the mirroring encapsulation, which only fits an Ethernet
+	// capture and is absent when GRE carries the IP packet directly
+	if (packet_class->mirrored && (packet_class->l2_offset == 0 || packet_class->linktype != DLT_EN10MB)) {
+		return;
 	}
 
-	// Find the target pointer, it's just after the Ethernet header
-	char* target_ptr = (char*)data + sizeof(struct ether_header);
+	u_char* packet = (u_char*)data;
+	u_int link_length = packet_class->ip_offset - packet_class->l2_offset;
 
-	// Check if the Ethernet header includes an optional 802.1Q tag
-	struct ether_header* ether_header = (struct ether_header*)(data);
-	if (ntohs(ether_header->ether_type) == ETHERTYPE_VLAN) {
-		// In this case, we must add the length of the 802.1Q tag to the Ethernet header length
-		target_ptr += TAG_ETHER_802_1_Q_LENGTH;
+	// The link layer header, with any tags or labels, is copied to the start of the packet and the tunnelled packet
+	// is copied up to just under it
+	if (packet_class->l2_offset != 0) {
+		memmove(packet, packet + packet_class->l2_offset, link_length);
 	}
+	memmove(packet + link_length, packet + packet_class->payload_offset, header->caplen - packet_class->payload_offset);
 
-	// Find out how much data is being dropped
-	int dropped = source_ptr - target_ptr;
-
-	// Now copy up the packet to just under the Ethernet header
-	memmove(target_ptr, source_ptr, header->caplen - dropped);
+	// The protocol type announcing the IP header must match the IP version of the tunnelled packet
+	if (packet_class->type_offset != 0 && header->caplen > packet_class->payload_offset) {
+		u_short type = (packet[link_length] >> 4) == 6 ? ETHERTYPE_IPV6 : ETHERTYPE_IP;
+		packet[packet_class->type_offset - packet_class->l2_offset] = type >> 8;
+		packet[packet_class->type_offset - packet_class->l2_offset + 1] = type & 0xff;
+	}
 
 	// Adjust the packet header fields
+	u_int dropped = packet_class->payload_offset - link_length;
 	header->caplen -= dropped;
 	header->len -= dropped;
 }
-
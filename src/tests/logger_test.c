@@ -0,0 +1,301 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: logger_test.c
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This program tests the rate limiting, long message and exit handling of the logger. The syslog function is replaced
+ * here so that the messages the logger writes are captured on a pipe, each message ends with a zero byte
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include <logger.h>
+#include <monitor.h>
+
+// The number of monitors output in one pass, more than the rate limit
+#define TEST_MONITORS (LOGGER_RATE_LIMIT + 5)
+
+// The size of the buffer the captured messages are read into
+#define TEST_CAPTURE_SIZE (1024 * 1024)
+
+// The pipe the messages written to syslog are captured on
+static int capture_fd = -1;
+
+// The number of failed checks
+static int failures = 0;
+
+// Forward definition of private functions
+static int test_capture(void (*test)(void), char* capture);
+static int test_count(const char* capture, int length, const char* text);
+static void test_check(int passed, const char* description);
+static void test_monitors(void);
+static void test_texts(void);
+static void test_repeats(void);
+static void test_long_message(void);
+static void test_too_long_message(void);
+static void test_exit(void);
+
+//
+// This function replaces syslog, the message is written to the capture pipe
+//
+// Parameters:
+//  int priority: The priority of the message, not used here
+//  const char* format: The format of the message
+//  ...: The message arguments
+//
+void syslog(int priority, const char* format, ...)
+{
+	char* text = NULL;
+	va_list arguments;
+	va_start(arguments, format);
+	int length = vasprintf(&text, format, arguments);
+	va_end(arguments);
+
+	if (length >= 0 && capture_fd >= 0) {
+		if (write(capture_fd, text, length + 1) != length + 1) {
+			perror("capture write");
+		}
+	}
+	free(text);
+}
+
+int main(int argc, char* argv[])
+{
+	char* capture = malloc(TEST_CAPTURE_SIZE);
+	if (capture == NULL) {
+		fprintf(stderr, "could not allocate capture buffer\n");
+		exit(1);
+	}
+
+	int length = test_capture(test_monitors, capture);
+	test_check(test_count(capture, length, "monitor ") == TEST_MONITORS, "monitor lines of every monitor are logged");
+	test_check(test_count(capture, length, " kerneldrops=0, ifdrops=0, distdrops=0,") == TEST_MONITORS, "identical monitor lines are logged");
+
+	length = test_capture(test_texts, capture);
+	test_check(test_count(capture, length, "session ") == 4 * LOGGER_RATE_LIMIT, "messages with one format and different texts are logged");
+
+	length = test_capture(test_repeats, capture);
+	// The report of the suppressed messages holds the message too
+	test_check(test_count(capture, length, "repeated message") == LOGGER_RATE_LIMIT + 3, "repeated messages are limited");
+	test_check(test_count(capture, length, "suppressed 5 messages like: repeated message") == 1, "suppressed messages are reported");
+
+	length = test_capture(test_long_message, capture);
+	test_check(test_count(capture, length, "config line ") == 100, "lines of a long message are logged");
+	test_check(test_count(capture, length, "end of config") == 1, "the end of a long message is logged");
+
+	length = test_capture(test_too_long_message, capture);
+	test_check(test_count(capture, length, "x") == LOGGER_MESSAGE_SIZE - 1, "a message longer than the longest message is truncated");
+	test_check(test_count(capture, length, "truncated 1 messages") == 1, "truncated messages are reported");
+
+	length = test_capture(test_exit, capture);
+	test_check(test_count(capture, length, "message before exit") == 1, "the message before an exit is logged");
+
+	free(capture);
+
+	if (failures > 0) {
+		fprintf(stderr, "%d checks failed\n", failures);
+		exit(1);
+	}
+
+	fprintf(stderr, "all checks passed\n");
+	exit(0);
+}
+
+//
+// This function runs a test in a child process, so that each test starts with a new logger, and captures the messages
+// it writes to syslog
+//
+// Parameters:
+//  void (*test)(void): The test, it exits the child process
+//  char* capture: The captured messages are returned here, TEST_CAPTURE_SIZE long
+//
+// Return:
+//  int: The length of the captured messages
+//
+static int test_capture(void (*test)(void), char* capture)
+{
+	int pipe_fds[2];
+	if (pipe(pipe_fds) != 0) {
+		perror("pipe");
+		exit(1);
+	}
+
+	pid_t child = fork();
+	if (child < 0) {
+		perror("fork");
+		exit(1);
+	}
+	if (child == 0) {
+		close(pipe_fds[0]);
+		capture_fd = pipe_fds[1];
+		init_logger("logger_test:");
+		test();
+		exit(0);
+	}
+
+	close(pipe_fds[1]);
+	int length = 0;
+	ssize_t read_length;
+	while (length < TEST_CAPTURE_SIZE && (read_length = read(pipe_fds[0], capture + length, TEST_CAPTURE_SIZE - length)) > 0) {
+		length += read_length;
+	}
+	close(pipe_fds[0]);
+	waitpid(child, NULL, 0);
+
+	return length;
+}
+
+//
+// This function counts the occurrences of a text in the captured messages, the pieces of a message split over several
+// records are joined first
+//
+// Parameters:
+//  const char* capture: The captured messages
+//  int length: The length of the captured messages
+//  const char* text: The text to count
+//
+// Return:
+//  int: The number of occurrences
+//
+static int test_count(const char* capture, int length, const char* text)
+{
+	char* joined = malloc(length + 1);
+	int joined_length = 0;
+	for (int i = 0; i < length; i++) {
+		// The logger prefixes each record with a space
+		if ((i == 0 || capture[i - 1] == '\0') && capture[i] == ' ') {
+			continue;
+		}
+		if (capture[i] != '\0') {
+			joined[joined_length++] = capture[i];
+		}
+	}
+	joined[joined_length] = '\0';
+
+	int count = 0;
+	for (const char* found = strstr(joined, text); found != NULL; found = strstr(found + 1, text)) {
+		count++;
+	}
+
+	free(joined);
+	return count;
+}
+
+//
+// This function records the result of a check
+//
+// Parameters:
+//  int passed: 1 if the check passed, 0 otherwise
+//  const char* description: What was checked
+//
+static void test_check(int passed, const char* description)
+{
+	fprintf(stderr, "%s: %s\n", passed ? "passed" : "FAILED", description);
+	if (!passed) {
+		failures++;
+	}
+}
+
+//
+// This function outputs more monitors than the rate limit in one pass, as the supervision thread does
+//
+static void test_monitors(void)
+{
+	struct monitor* monitors[TEST_MONITORS];
+	char description[32];
+	for (int i = 0; i < TEST_MONITORS; i++) {
+		snprintf(description, sizeof(description), "session%d", i);
+		monitors[i] = monitor_open(i, description);
+	}
+
+	// Make the monitors due for output
+	monitor_last_output_time -= MONITOR_OUTPUT_INTERVAL + 1;
+	for (int i = 0; i < TEST_MONITORS; i++) {
+		monitors[i]->last_output_time = monitor_last_output_time;
+	}
+
+	for (int i = 0; i < TEST_MONITORS; i++) {
+		handle_monitor(monitors[i]);
+		monitor_close(monitors[i]);
+	}
+}
+
+//
+// This function logs messages with one format and different texts, more of them than the rate limit
+//
+static void test_texts(void)
+{
+	for (int i = 0; i < 4 * LOGGER_RATE_LIMIT; i++) {
+		write_to_syslog("session %d failed\n", i);
+	}
+}
+
+//
+// This function logs the same message more often than the rate limit, then again in the next second
+//
+static void test_repeats(void)
+{
+	time_t start = time(NULL);
+	for (int i = 0; i < LOGGER_RATE_LIMIT + 5; i++) {
+		write_to_syslog("repeated message\n");
+	}
+
+	while (time(NULL) < start + 2) {
+		usleep(100000);
+	}
+	write_to_syslog("repeated message\n");
+	write_to_syslog("repeated message\n");
+}
+
+//
+// This function logs a message many records long, like the dump of a configuration file
+//
+static void test_long_message(void)
+{
+	char* message = malloc(100 * 64 + 64);
+	int length = 0;
+	for (int i = 0; i < 100; i++) {
+		length += sprintf(message + length, "config line %03d: the value of the property is %-16d\n", i, i);
+	}
+	sprintf(message + length, "end of config\n");
+
+	write_to_syslog("config file contents: \n%s", message);
+	free(message);
+}
+
+//
+// This function logs a message longer than the longest message the logger formats
+//
+static void test_too_long_message(void)
+{
+	char* message = malloc(2 * LOGGER_MESSAGE_SIZE);
+	memset(message, 'x', 2 * LOGGER_MESSAGE_SIZE - 1);
+	message[2 * LOGGER_MESSAGE_SIZE - 1] = '\0';
+
+	write_to_syslog("%s", message);
+	free(message);
+}
+
+//
+// This function logs a message and exits at once, as the programs do on a bad configuration
+//
+static void test_exit(void)
+{
+	write_to_syslog("message before exit\n");
+	exit(1);
+}
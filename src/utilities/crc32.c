@@ -0,0 +1,94 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: crc32.c
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This module calculates the reflected CRC-32 with polynomial 0xedb88320. Eight octets are processed per step with
+ * eight lookup tables (slicing by eight), the tables are built on first use
+ */
+
+#include <pthread.h>
+#include <string.h>
+
+#include <crc32.h>
+
+// The reflected CRC-32 polynomial
+#define CRC32_POLYNOMIAL 0xedb88320
+
+// The lookup tables, table 0 is the classic byte at a time table, table n advances a byte by n further zero octets
+static uint32_t crc32_tables[8][256];
+static pthread_once_t crc32_once = PTHREAD_ONCE_INIT;
+
+// Forward definition of private functions
+static void crc32_init(void);
+
+//
+// This function adds data to a CRC-32, a CRC over several buffers is calculated by passing the result of each call
+// to the next
+//
+// Parameters:
+//  uint32_t crc: The CRC of the data so far, 0 to start a new CRC
+//  const void* data: The data
+//  size_t length: The length of the data in octets
+//
+// Return:
+//  uint32_t: The CRC including the data
+//
+uint32_t crc32_update(uint32_t crc, const void* data, size_t length)
+{
+	pthread_once(&crc32_once, crc32_init);
+
+	const unsigned char* octets = (const unsigned char*)data;
+	crc = ~crc;
+
+	// Eight octets at a time, the words are assembled little endian so that this works on any host
+	while (length >= 8) {
+		uint32_t low = crc ^ ((uint32_t)octets[0] | (uint32_t)octets[1] << 8 | (uint32_t)octets[2] << 16 | (uint32_t)octets[3] << 24);
+		uint32_t high = (uint32_t)octets[4] | (uint32_t)octets[5] << 8 | (uint32_t)octets[6] << 16 | (uint32_t)octets[7] << 24;
+
+		crc = crc32_tables[7][low & 0xff] ^ crc32_tables[6][(low >> 8) & 0xff] ^
+				crc32_tables[5][(low >> 16) & 0xff] ^ crc32_tables[4][low >> 24] ^
+				crc32_tables[3][high & 0xff] ^ crc32_tables[2][(high >> 8) & 0xff] ^
+				crc32_tables[1][(high >> 16) & 0xff] ^ crc32_tables[0][high >> 24];
+
+		octets += 8;
+		length -= 8;
+	}
+
+	while (length-- > 0) {
+		crc = crc32_tables[0][(crc ^ *octets++) & 0xff] ^ (crc >> 8);
+	}
+
+	return ~crc;
+}
+
+//
+// This function builds the lookup tables
+//
+static void crc32_init(void)
+{
+	for (uint32_t i = 0; i < 256; i++) {
+		uint32_t crc = i;
+		for (int bit = 0; bit < 8; bit++) {
+			crc = (crc & 1) ? (crc >> 1) ^ CRC32_POLYNOMIAL : crc >> 1;
+		}
+		crc32_tables[0][i] = crc;
+	}
+
+	for (uint32_t i = 0; i < 256; i++) {
+		for (int table = 1; table < 8; table++) {
+			crc32_tables[table][i] = crc32_tables[0][crc32_tables[table - 1][i] & 0xff] ^ (crc32_tables[table - 1][i] >> 8);
+		}
+	}
+}
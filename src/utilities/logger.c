@@ -0,0 +1,437 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: logger.c
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This module passes log messages to syslog. Messages are formatted by the calling thread into a fixed size
+ * record on a lock free ring, a drain thread takes the records off the ring and writes them to syslog. The ring
+ * is a bounded multiple producer, single consumer queue: each record has a sequence number that tells producers
+ * when the record is free and the consumer when it is filled. Messages longer than a record are split over several
+ * records. The ring is drained synchronously when the logger is closed or the process exits, so the messages logged
+ * just before an exit are not lost.
+ */
+
+#include <pthread.h>
+#include <signal.h>
+
+#include <logger.h>
+
+// A record on the log ring
+struct logger_record {
+	volatile unsigned long sequence;     // The ring position this record is free or filled for
+	char text[LOGGER_RECORD_SIZE];       // The formatted message
+} __attribute__((aligned(64)));
+
+// The rate limiting state for one message text
+struct logger_rate {
+	volatile unsigned long hash;         // The hash of the text being limited, 0 if the entry is free
+	volatile time_t window;              // The second being counted
+	volatile int count;                  // The number of messages with this text in the second
+	volatile int suppressed;             // The number of messages suppressed since the last report
+	char sample[LOGGER_RATE_SAMPLE_SIZE]; // The start of the text, for the report of suppressed messages
+};
+
+// The log ring, positions increase forever and are masked onto the records
+static struct logger_record logger_ring[LOGGER_RING_SIZE];
+static volatile unsigned long logger_ring_head = 0;
+static volatile unsigned long logger_ring_tail = 0;
+
+// The number of messages dropped because the ring was full
+static volatile int logger_ring_dropped = 0;
+
+// Messages longer than a record are formatted into the scratch buffer of their thread, the number of messages
+// truncated because they did not fit in it is counted
+static __thread char logger_scratch[LOGGER_MESSAGE_SIZE];
+static volatile int logger_truncated = 0;
+
+// Rate limiting state, indexed on a hash of the message text
+static struct logger_rate logger_rates[LOGGER_RATE_ENTRIES];
+
+// The drain thread, logger_running is set while it is draining the ring
+static pthread_t logger_thread;
+static volatile int logger_running = 0;
+static volatile int logger_stopping = 0;
+
+// Set while a thread is draining the ring, the ring has a single consumer at a time
+static volatile int logger_draining = 0;
+
+// Forward definition of private functions
+static void* logger_drain_run(void* notused_param);
+static int logger_drain(int wait);
+static void logger_exit(void);
+static void logger_write(int limited, const char* message, va_list arguments);
+static unsigned long logger_rate_hash(const char* text);
+static int logger_rate_check(const char* text);
+static void logger_put_text(const char* text);
+static void logger_put(const char* text, size_t length);
+
+//
+// This function connects to syslog and starts the drain thread
+//
+// Parameters:
+//  const char *prog_name: Identifier for the program in the log file
+//
+void init_logger(const char *prog_name)
+{
+	static int init_done = 0;
+	if (init_done) {
+		return;
+	}
+	init_done++;
+
+	openlog(prog_name, LOG_NDELAY|LOG_PID, LOG_LOCAL2);
+
+	// Set up the records so that record i is free for position i
+	for (unsigned long i = 0; i < LOGGER_RING_SIZE; i++) {
+		logger_ring[i].sequence = i;
+	}
+
+	logger_running = 1;
+	if (pthread_create(&logger_thread, NULL, logger_drain_run, NULL) != 0) {
+		// Log synchronously
+		logger_running = 0;
+	}
+
+	// Write out the ring when the process exits, whether or not the logger is closed first
+	atexit(logger_exit);
+}
+
+//
+// This function drains the log ring, stops the drain thread and closes the connection to syslog. The ring is drained
+// on the calling thread and the drain thread is not joined, so this function may be called from a signal handler
+//
+void close_logger(void)
+{
+	if (logger_running) {
+		// Messages are written synchronously from now on
+		logger_running = 0;
+		logger_stopping = 1;
+		logger_drain(1);
+	}
+
+	closelog();
+}
+
+//
+// This function formats a message and puts it on the log ring, or writes it to syslog if the drain thread is not
+// running. Messages are limited to LOGGER_RATE_LIMIT a second for each message text
+//
+// Parameters:
+//  const char * message: The format of the message
+//  ...: The message arguments
+//
+void write_to_syslog(const char * message,...)
+{
+	va_list arguments;
+	va_start(arguments, message);
+	logger_write(1, message, arguments);
+	va_end(arguments);
+}
+
+//
+// This function formats a message and puts it on the log ring, or writes it to syslog if the drain thread is not
+// running. The message is not rate limited
+//
+// Parameters:
+//  const char * message: The format of the message
+//  ...: The message arguments
+//
+void write_to_syslog_unlimited(const char * message,...)
+{
+	va_list arguments;
+	va_start(arguments, message);
+	logger_write(0, message, arguments);
+	va_end(arguments);
+}
+
+//
+// This function writes out the log ring at process exit
+//
+static void logger_exit(void)
+{
+	close_logger();
+}
+
+//
+// This function formats a message and puts it on the log ring, messages longer than a record are formatted again into
+// the scratch buffer of the calling thread and those longer than that are truncated, nothing is allocated
+//
+// Parameters:
+//  int limited: 1 if the message is rate limited, 0 otherwise
+//  const char* message: The format of the message
+//  va_list arguments: The message arguments
+//
+static void logger_write(int limited, const char* message, va_list arguments)
+{
+	char text[LOGGER_RECORD_SIZE];
+	const char* formatted = text;
+
+	va_list retry_arguments;
+	va_copy(retry_arguments, arguments);
+	int length = vsnprintf(text, LOGGER_RECORD_SIZE, message, arguments);
+	if (length >= LOGGER_RECORD_SIZE) {
+		vsnprintf(logger_scratch, LOGGER_MESSAGE_SIZE, message, retry_arguments);
+		formatted = logger_scratch;
+		if (length >= LOGGER_MESSAGE_SIZE) {
+			__sync_fetch_and_add(&logger_truncated, 1);
+		}
+	}
+	va_end(retry_arguments);
+
+	// Drop messages over the rate limit for their text
+	if (length >= 0 && (!limited || logger_rate_check(formatted))) {
+		logger_put_text(formatted);
+	}
+}
+
+//
+// This function puts a formatted message on the log ring, a message longer than a record is split over several
+// records, at the end of a line where it can be
+//
+// Parameters:
+//  const char* text: The formatted message
+//
+static void logger_put_text(const char* text)
+{
+	if (!logger_running) {
+		syslog(LOG_NOTICE|LOG_LOCAL2, " %s", text);
+		return;
+	}
+
+	size_t length = strlen(text);
+	while (length >= LOGGER_RECORD_SIZE) {
+		size_t part = LOGGER_RECORD_SIZE - 1;
+		const char* line_end = memrchr(text, '\n', part);
+		if (line_end != NULL) {
+			part = line_end - text + 1;
+		}
+
+		logger_put(text, part);
+		text += part;
+		length -= part;
+	}
+
+	if (length > 0) {
+		logger_put(text, length);
+	}
+}
+
+//
+// This function puts a formatted message that fits in a record on the log ring
+//
+// Parameters:
+//  const char* text: The formatted message
+//  size_t length: The length of the message, less than LOGGER_RECORD_SIZE
+//
+static void logger_put(const char* text, size_t length)
+{
+
+	// Claim a position on the ring, the record at the position is free when its sequence equals the position
+	unsigned long position = logger_ring_head;
+	struct logger_record* record;
+	while (1) {
+		record = &logger_ring[position & (LOGGER_RING_SIZE - 1)];
+		long difference = (long)(record->sequence - position);
+
+		if (difference == 0) {
+			unsigned long claimed = __sync_val_compare_and_swap(&logger_ring_head, position, position + 1);
+			if (claimed == position) {
+				break;
+			}
+			position = claimed;
+		}
+		else if (difference < 0) {
+			// The ring is full, never wait for the drain thread
+			__sync_fetch_and_add(&logger_ring_dropped, 1);
+			return;
+		}
+		else {
+			position = logger_ring_head;
+		}
+	}
+
+	memcpy(record->text, text, length);
+	record->text[length] = 0;
+
+	// Hand the record to the drain thread
+	__sync_synchronize();
+	record->sequence = position + 1;
+}
+
+//
+// This function hashes the text of a message for rate limiting with the FNV-1a hash
+//
+// Parameters:
+//  const char* text: The message text
+//
+// Return:
+//  unsigned long: The hash, never 0
+//
+static unsigned long logger_rate_hash(const char* text)
+{
+	unsigned long hash = 14695981039346656037UL;
+	for (const unsigned char* c = (const unsigned char*)text; *c != '\0'; c++) {
+		hash = (hash ^ *c) * 1099511628211UL;
+	}
+
+	return hash != 0 ? hash : 1;
+}
+
+//
+// This function checks if a message with a given text is within the rate limit. The entry of the text is looked for
+// among LOGGER_RATE_PROBES entries from its hash, an entry that is free or has not been used for a second is taken
+// over, so texts in use never reset each other's counts. When the first message with the text in a new second is seen,
+// or its entry is taken over, the number of messages suppressed is logged. Messages are not limited if all the entries
+// probed are in use
+//
+// Parameters:
+//  const char* text: The message text
+//
+// Return:
+//  int: 1 if the message should be logged, 0 if it is suppressed
+//
+static int logger_rate_check(const char* text)
+{
+	unsigned long hash = logger_rate_hash(text);
+	time_t now = time(NULL);
+
+	struct logger_rate* rate = NULL;
+	for (int i = 0; i < LOGGER_RATE_PROBES && rate == NULL; i++) {
+		struct logger_rate* probe = &logger_rates[(hash + i) & (LOGGER_RATE_ENTRIES - 1)];
+		if (probe->hash == hash) {
+			rate = probe;
+		}
+	}
+
+	for (int i = 0; i < LOGGER_RATE_PROBES && rate == NULL; i++) {
+		struct logger_rate* probe = &logger_rates[(hash + i) & (LOGGER_RATE_ENTRIES - 1)];
+		unsigned long old_hash = probe->hash;
+		if ((old_hash != 0 && probe->window >= now - 1) || !__sync_bool_compare_and_swap(&probe->hash, old_hash, hash)) {
+			continue;
+		}
+
+		// Report the messages suppressed for the text that used the entry before
+		int suppressed = __sync_lock_test_and_set(&probe->suppressed, 0);
+		if (suppressed > 0) {
+			char report[LOGGER_RECORD_SIZE];
+			snprintf(report, LOGGER_RECORD_SIZE, "suppressed %d messages like: %s", suppressed, probe->sample);
+			logger_put_text(report);
+		}
+
+		size_t sample_length = strnlen(text, LOGGER_RATE_SAMPLE_SIZE - 1);
+		memcpy(probe->sample, text, sample_length);
+		probe->sample[sample_length] = '\0';
+		probe->count = 0;
+		probe->window = now;
+		rate = probe;
+	}
+
+	if (rate == NULL) {
+		return 1;
+	}
+
+	time_t window = rate->window;
+	if (window != now && __sync_bool_compare_and_swap(&rate->window, window, now)) {
+		// This thread starts the new second, report the last one
+		rate->count = 0;
+		int suppressed = __sync_lock_test_and_set(&rate->suppressed, 0);
+		if (suppressed > 0) {
+			char report[LOGGER_RECORD_SIZE];
+			snprintf(report, LOGGER_RECORD_SIZE, "suppressed %d messages like: %s", suppressed, rate->sample);
+			logger_put_text(report);
+		}
+	}
+
+	if (__sync_fetch_and_add(&rate->count, 1) < LOGGER_RATE_LIMIT) {
+		return 1;
+	}
+
+	__sync_fetch_and_add(&rate->suppressed, 1);
+	return 0;
+}
+
+//
+// This function writes the filled records on the log ring to syslog, the ring is drained by one thread at a time
+//
+// Parameters:
+//  int wait: 1 to wait for a thread draining the ring to finish, for up to LOGGER_DRAIN_WAIT milliseconds, 0 to return
+//
+// Return:
+//  int: The number of records written
+//
+static int logger_drain(int wait)
+{
+	int drained = 0;
+
+	for (int waited = 0; __sync_lock_test_and_set(&logger_draining, 1); waited++) {
+		if (!wait || waited >= LOGGER_DRAIN_WAIT) {
+			return 0;
+		}
+		usleep(1000);
+	}
+
+	while (1) {
+		struct logger_record* record = &logger_ring[logger_ring_tail & (LOGGER_RING_SIZE - 1)];
+		if (record->sequence != logger_ring_tail + 1) {
+			break;
+		}
+		__sync_synchronize();
+
+		syslog(LOG_NOTICE|LOG_LOCAL2, " %s", record->text);
+
+		// Free the record for the position one time around the ring
+		__sync_synchronize();
+		record->sequence = logger_ring_tail + LOGGER_RING_SIZE;
+		logger_ring_tail++;
+		drained++;
+	}
+
+	int dropped = __sync_lock_test_and_set(&logger_ring_dropped, 0);
+	if (dropped > 0) {
+		syslog(LOG_NOTICE|LOG_LOCAL2, " log ring full, dropped %d messages\n", dropped);
+	}
+
+	int truncated = __sync_lock_test_and_set(&logger_truncated, 0);
+	if (truncated > 0) {
+		syslog(LOG_NOTICE|LOG_LOCAL2, " truncated %d messages to %d characters\n", truncated, LOGGER_MESSAGE_SIZE - 1);
+	}
+
+	__sync_lock_release(&logger_draining);
+	return drained;
+}
+
+//
+// This function is the entry point of the drain thread, it drains the ring until the logger is closed
+//
+// Parameters:
+//  void* notused_param: A transparent parameter on thread initiation, not used here
+//
+static void* logger_drain_run(void* notused_param)
+{
+	// Signals are handled on the other threads
+	sigset_t sigs;
+	sigfillset(&sigs);
+	pthread_sigmask(SIG_BLOCK, &sigs, NULL);
+
+	while (!logger_stopping) {
+		if (logger_drain(0) == 0) {
+			usleep(LOGGER_DRAIN_INTERVAL);
+		}
+	}
+
+	// Write out what is left on the ring, unless the thread stopping the logger is doing so
+	logger_drain(0);
+
+	return NULL;
+}
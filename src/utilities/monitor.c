@@ -0,0 +1,277 @@
+/************************************************************************
+* COPYRIGHT (C) Ericsson 2012                                           *
+* The copyright to the computer program(s) herein is the property       *
+* of Telefonaktiebolaget LM Ericsson.                                   *
+* The program(s) may be used and/or copied only with the written        *
+* permission from Telefonaktiebolaget LM Ericsson or in accordance with *
+* the terms and conditions stipulated in the agreement/contract         *
+* under which the program(s) have been supplied.                        *
+*************************************************************************
+*************************************************************************
+* File: monitor.c
+* Date: Oct 19, 2026
+* Author: LMI/LXR/SH
+************************************************************************/
+
+/**
+ * This module holds the parts of the monitor API that are not inlined: monitor allocation and the
+ * shared memory statistics segment that monitors are allocated in
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <monitor.h>
+
+// The number of times a reader retries a slot that is being changed before giving up
+#define MONITOR_STATS_READ_RETRIES 1000
+
+// The counter shard of the calling thread, threads use the shared shard until they register
+__thread int monitor_thread_shard = MONITOR_SHARED_SHARD;
+
+// The statistics segment of this process, NULL if it is not open
+static struct monitor_stats_header* monitor_stats_segment = NULL;
+
+// The path of the statistics segment
+static char monitor_stats_path[FILENAME_MAX];
+
+// Mutex to serialize allocation of slots in the statistics segment
+static pthread_mutex_t monitor_stats_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+//
+// This function returns a slot in the statistics segment
+//
+// Parameters:
+//  int slot: The slot number
+//
+// Return:
+//  struct monitor_stats_slot*: A pointer to the slot
+//
+static struct monitor_stats_slot* monitor_stats_get_slot(int slot)
+{
+	return ((struct monitor_stats_slot*)(monitor_stats_segment + 1)) + slot;
+}
+
+//
+// This function creates the statistics segment for this process
+//
+// Parameters:
+//  const char* program_name: The name of the program, used to name the segment
+//
+// Return:
+//  int: 1 if the segment was created, 0 otherwise
+//
+int monitor_stats_open(const char* program_name)
+{
+	if (monitor_stats_segment != NULL) {
+		return 1;
+	}
+
+	snprintf(monitor_stats_path, FILENAME_MAX, "%s/%s%s.%d", MONITOR_STATS_DIRECTORY, MONITOR_STATS_PREFIX, program_name, (int)getpid());
+
+	size_t segment_size = sizeof(struct monitor_stats_header) + sizeof(struct monitor_stats_slot) * MONITOR_STATS_SLOTS;
+
+	int fd = open(monitor_stats_path, O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+	if (fd < 0) {
+		write_to_syslog("could not create statistics segment %s: %s\n", monitor_stats_path, strerror(errno));
+		return 0;
+	}
+
+	if (ftruncate(fd, segment_size) != 0) {
+		write_to_syslog("could not size statistics segment %s: %s\n", monitor_stats_path, strerror(errno));
+		close(fd);
+		unlink(monitor_stats_path);
+		return 0;
+	}
+
+	void* segment = mmap(NULL, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (segment == MAP_FAILED) {
+		write_to_syslog("could not map statistics segment %s: %s\n", monitor_stats_path, strerror(errno));
+		unlink(monitor_stats_path);
+		return 0;
+	}
+
+	// The file is new so all slots are zero, that is unused; fill in the header and set the magic last
+	struct monitor_stats_header* header = (struct monitor_stats_header*)segment;
+	header->version     = MONITOR_STATS_VERSION;
+	header->header_size = sizeof(struct monitor_stats_header);
+	header->slot_size   = sizeof(struct monitor_stats_slot);
+	header->slot_count  = MONITOR_STATS_SLOTS;
+	header->pid         = getpid();
+	header->start_time  = time(NULL);
+	strncpy(header->program_name, program_name, FILENAME_MAX);
+	header->program_name[FILENAME_MAX-1] = 0;
+	__sync_synchronize();
+	memcpy(header->magic, MONITOR_STATS_MAGIC, sizeof(header->magic));
+
+	monitor_stats_segment = header;
+
+	write_to_syslog("statistics segment %s created\n", monitor_stats_path);
+	return 1;
+}
+
+//
+// This function removes the statistics segment name. The segment stays mapped because session
+// threads may still be using monitors in it, it goes when the process exits
+//
+void monitor_stats_close(void)
+{
+	if (monitor_stats_segment != NULL) {
+		unlink(monitor_stats_path);
+	}
+}
+
+//
+// This function allocates a monitor, in the statistics segment if it is open, on the heap otherwise
+//
+// Parameters:
+//  int id: The ID of the monitor
+//  char* description: The description of the monitor
+//
+// Return:
+//  struct monitor*: The monitor, NULL if it could not be allocated
+//
+struct monitor* monitor_alloc(int id, char* description)
+{
+	struct monitor* monitor = NULL;
+	struct monitor_stats_slot* slot = NULL;
+	int slot_no = -1;
+
+	// Look for a free slot in the statistics segment
+	pthread_mutex_lock(&monitor_stats_mutex);
+	if (monitor_stats_segment != NULL) {
+		for (int i = 0; i < MONITOR_STATS_SLOTS; i++) {
+			if (!monitor_stats_get_slot(i)->in_use) {
+				slot_no = i;
+				slot = monitor_stats_get_slot(i);
+				break;
+			}
+		}
+	}
+
+	if (slot != NULL) {
+		// Readers see an odd sequence while the slot is set up
+		slot->sequence++;
+		__sync_synchronize();
+
+		monitor = &slot->monitor;
+		memset(monitor, 0, sizeof(struct monitor));
+		memset(&slot->latency, 0, sizeof(struct monitor_histogram));
+		slot->latency_in_use = 0;
+	}
+	else {
+		// Allocate memory for the monitor struct, the shards must be aligned on cache lines
+		if (posix_memalign((void**)&monitor, MONITOR_CACHE_LINE_SIZE, sizeof(struct monitor)) != 0) {
+			pthread_mutex_unlock(&monitor_stats_mutex);
+			return NULL;
+		}
+		memset(monitor, 0, sizeof(struct monitor));
+	}
+
+	// Set the initial data for this monitor
+	monitor->id = id;
+	monitor->slot = slot_no;
+
+	// Set the description of the monitor, set last character as zero to avoid overruns on strings
+	strncpy(monitor->description, description, FILENAME_MAX);
+	monitor->description[FILENAME_MAX-1] = 0;
+
+	if (slot != NULL) {
+		slot->in_use = 1;
+		slot->generation++;
+		__sync_synchronize();
+		slot->sequence++;
+	}
+	pthread_mutex_unlock(&monitor_stats_mutex);
+
+	return monitor;
+}
+
+//
+// This function frees a monitor allocated with monitor_alloc()
+//
+// Parameters:
+//  struct monitor* monitor: The monitor to free
+//
+void monitor_free(struct monitor* monitor)
+{
+	if (monitor->slot < 0) {
+		free(monitor->latency);
+		free(monitor);
+		return;
+	}
+
+	pthread_mutex_lock(&monitor_stats_mutex);
+	struct monitor_stats_slot* slot = monitor_stats_get_slot(monitor->slot);
+	slot->sequence++;
+	__sync_synchronize();
+	slot->latency_in_use = 0;
+	slot->in_use = 0;
+	__sync_synchronize();
+	slot->sequence++;
+	pthread_mutex_unlock(&monitor_stats_mutex);
+}
+
+//
+// This function allocates the latency histogram of a monitor
+//
+// Parameters:
+//  struct monitor* monitor: The monitor
+//
+// Return:
+//  struct monitor_histogram*: The histogram, NULL if it could not be allocated
+//
+struct monitor_histogram* monitor_latency_alloc(struct monitor* monitor)
+{
+	if (monitor->slot < 0) {
+		return (struct monitor_histogram *) calloc(1, sizeof(struct monitor_histogram));
+	}
+
+	pthread_mutex_lock(&monitor_stats_mutex);
+	struct monitor_stats_slot* slot = monitor_stats_get_slot(monitor->slot);
+	slot->sequence++;
+	__sync_synchronize();
+	slot->latency_in_use = 1;
+	__sync_synchronize();
+	slot->sequence++;
+	pthread_mutex_unlock(&monitor_stats_mutex);
+
+	return &slot->latency;
+}
+
+//
+// This function takes a consistent copy of a statistics slot, it may be called from another process
+//
+// Parameters:
+//  const struct monitor_stats_slot* slot: The slot to read
+//  struct monitor_stats_slot* copy: The copy of the slot
+//
+// Return:
+//  int: 1 if a monitor is open in the slot, 0 otherwise
+//
+int monitor_stats_read_slot(const struct monitor_stats_slot* slot, struct monitor_stats_slot* copy)
+{
+	for (int retry = 0; retry < MONITOR_STATS_READ_RETRIES; retry++) {
+		unsigned int sequence = slot->sequence;
+		if (sequence & 1) {
+			// The slot is being changed
+			sched_yield();
+			continue;
+		}
+		__sync_synchronize();
+
+		memcpy(copy, (const void*)slot, sizeof(struct monitor_stats_slot));
+
+		__sync_synchronize();
+		if (slot->sequence == sequence) {
+			return copy->in_use;
+		}
+	}
+
+	return 0;
+}